@@ -0,0 +1,215 @@
+/**
+ * @file arena.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the Arena and Pool allocators used for robot-side
+ * objects instead of the heap
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The V5 program runs on newlib's malloc, which can fragment and has no bound
+ * on how long an allocation takes. Anything the robot needs for the whole
+ * program (trajectories, routes, command objects, ...) should instead come
+ * from an Arena: a block of static memory that hands out space front to back
+ * and never frees individual objects. Objects that really do come and go use a
+ * Pool, which recycles fixed-size slots through a free list.
+ *
+ * Allocation failure returns NULL rather than throwing, since the program is
+ * built with -fno-exceptions. Neither allocator is meant to be shared between
+ * tasks without care: allocate in pre_auton, or from one task only.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Size in bytes of RobotArena; override with -DART_ARENA_SIZE=...
+ */
+#ifndef ART_ARENA_SIZE
+#define ART_ARENA_SIZE (256 * 1024)
+#endif
+
+namespace art
+{
+	/**
+	 * @brief Bump allocator over a caller-provided block of memory
+	 */
+	class Arena
+	{
+	public:
+		/**
+		 * @brief Creates an Arena managing an existing buffer
+		 *
+		 * @param buffer memory to hand out, must outlive the Arena
+		 * @param capacity size of buffer in bytes
+		 */
+		Arena(void *buffer, size_t capacity);
+
+		/**
+		 * @brief Reserves raw memory
+		 *
+		 * @param size number of bytes
+		 * @param align required alignment, a power of two
+		 * @return the memory, or NULL if the Arena is exhausted
+		 */
+		void *allocate(size_t size, size_t align = alignof(max_align_t));
+
+		/**
+		 * @brief Constructs an object inside the Arena
+		 *
+		 * The destructor is never run, so only put objects here that live for
+		 * the rest of the program or hold nothing that needs cleaning up.
+		 *
+		 * @return the object, or NULL if the Arena is exhausted
+		 */
+		template <typename T, typename... Args>
+		T *create(Args &&...args)
+		{
+			void *memory = allocate(sizeof(T), alignof(T));
+			return memory ? new (memory) T(std::forward<Args>(args)...) : NULL;
+		}
+
+		/**
+		 * @brief Reserves and default-constructs an array
+		 *
+		 * @return the first element, or NULL if the Arena is exhausted
+		 */
+		template <typename T>
+		T *createArray(size_t count)
+		{
+			void *memory = allocate(sizeof(T) * count, alignof(T));
+			if (!memory)
+			{
+				return NULL;
+			}
+			T *items = static_cast<T *>(memory);
+			for (size_t i = 0; i < count; i++)
+			{
+				new (&items[i]) T();
+			}
+			return items;
+		}
+
+		/**
+		 * @brief Current fill level, for use with rewind()
+		 */
+		size_t mark() const { return m_used; }
+
+		/**
+		 * @brief Releases everything allocated since mark was taken
+		 *
+		 * Only use this for scratch space whose objects are known to be dead,
+		 * for example temporary buffers while parsing a file.
+		 */
+		void rewind(size_t mark);
+
+		/** @brief Bytes handed out so far */
+		size_t used() const { return m_used; }
+
+		/** @brief Total bytes the Arena manages */
+		size_t capacity() const { return m_capacity; }
+
+		/** @brief Bytes still available, ignoring alignment padding */
+		size_t remaining() const { return m_capacity - m_used; }
+
+		/** @brief Highest fill level ever reached */
+		size_t peak() const { return m_peak; }
+
+		/** @brief Number of allocations that did not fit */
+		uint32_t failures() const { return m_failures; }
+
+	private:
+		uint8_t *m_buffer;
+		size_t m_capacity;
+		size_t m_used;
+		size_t m_peak;
+		uint32_t m_failures;
+
+		Arena(const Arena &);
+		Arena &operator=(const Arena &);
+	};
+
+	/**
+	 * @brief The program-wide Arena, ART_ARENA_SIZE bytes of static memory
+	 */
+	extern Arena RobotArena;
+
+	/**
+	 * @brief Fixed number of recyclable slots for objects of one type
+	 *
+	 * Freed slots go on a free list and are handed out again, so a Pool never
+	 * fragments and both create() and destroy() take constant time.
+	 *
+	 * @tparam T object type
+	 * @tparam N number of slots
+	 */
+	template <typename T, size_t N>
+	class Pool
+	{
+	public:
+		Pool() : m_free(0), m_live(0)
+		{
+			for (size_t i = 0; i < N; i++)
+			{
+				m_next[i] = i + 1;
+			}
+		}
+
+		/**
+		 * @brief Constructs an object in a free slot
+		 *
+		 * @return the object, or NULL if every slot is in use
+		 */
+		template <typename... Args>
+		T *create(Args &&...args)
+		{
+			if (m_free >= N)
+			{
+				return NULL;
+			}
+			size_t slot = m_free;
+			m_free = m_next[slot];
+			m_live++;
+			return new (&m_slots[slot]) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Destroys an object and returns its slot to the Pool
+		 *
+		 * @param item an object returned by create(), or NULL
+		 */
+		void destroy(T *item)
+		{
+			if (!item)
+			{
+				return;
+			}
+			item->~T();
+			size_t slot = reinterpret_cast<Storage *>(item) - m_slots;
+			m_next[slot] = m_free;
+			m_free = slot;
+			m_live--;
+		}
+
+		/** @brief Number of objects currently alive */
+		size_t live() const { return m_live; }
+
+		/** @brief Total number of slots */
+		size_t capacity() const { return N; }
+
+	private:
+		typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+		Storage m_slots[N];
+		size_t m_next[N];
+		size_t m_free;
+		size_t m_live;
+	};
+} // namespace art
@@ -0,0 +1,153 @@
+/**
+ * @file assist.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring DriveAssist, which adds heading hold and auto-aim to
+ * the driver's stick commands, steering from where the robot will be rather
+ * than where it was
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * By the time a command computed from a pose reaches the wheels, the pose is
+ * old: odometry sampled it up to a period ago, and the motors take a few tens
+ * of milliseconds to respond to a new voltage. A controller closing the loop
+ * on that old pose is always correcting for where the robot used to be. Turned
+ * up enough to feel crisp, it overshoots and rocks.
+ *
+ * DriveAssist therefore steers from a predicted pose instead. It takes the
+ * odometry's latest estimate and moves it forward, with the same arc model
+ * odometry integrates with, by the estimate's age plus the drivetrain's
+ * response time. That is where the robot will be when the command takes
+ * effect. It also measures the latency from each timestamped controller
+ * sample to the wheels, which is what the driver feels.
+ *
+ * - Heading hold: when the turn stick is centred, the robot keeps the heading
+ *   it is predicted to have when the stick was let go, so releasing the
+ *   stick mid-turn does not overshoot. Bumps and uneven wheel friction no
+ *   longer pull it off a straight line.
+ * - Auto-aim: while aiming, the turn stick is replaced by a correction that
+ *   points the robot at a fixed field target, leading it by its own motion.
+ *   Right on top of the target, where its bearing swings wildly, the
+ *   heading is held instead.
+ *
+ * Forward is always passed through untouched: the assist only ever steers.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "odometry.h"
+#include "scheduler.h"
+
+namespace art
+{
+	/**
+	 * @brief Timing and gains of a DriveAssist
+	 */
+	struct AssistConfig
+	{
+		float responseLatency; /**< seconds from a new command to the wheels following it */
+		float turnDeadband;    /**< volts of turn command below which the stick counts as centred */
+		float holdKp;          /**< volts of turn per radian of heading error while holding */
+		float holdKd;          /**< volts of turn per rad/s of turn rate while holding */
+		float aimKp;           /**< volts of turn per radian of aiming error */
+		float aimKd;           /**< volts of turn per rad/s of turn rate while aiming */
+		float maxCorrection;   /**< largest turn command the assist adds, volts */
+		float maxLead;         /**< longest prediction, seconds; older poses are not extrapolated further */
+		float aimX;            /**< field target auto-aim points at, inches */
+		float aimY;
+		float aimMinRange;     /**< closer than this the bearing is meaningless, so the heading is held instead */
+	};
+
+	/**
+	 * @brief Arcade drive command in volts, before mixing into the two sides
+	 */
+	struct ArcadeCommand
+	{
+		float forward;
+		float turn;
+	};
+
+	/**
+	 * @brief What the assist is doing this tick
+	 */
+	enum AssistMode
+	{
+		kAssistOff,  /**< disabled, or the driver is turning */
+		kAssistHold, /**< holding a heading */
+		kAssistAim,  /**< pointing at the target */
+	};
+
+	/**
+	 * @brief Moves a pose forward in time along the arc its velocity describes
+	 *
+	 * @param state odometry estimate, with its field-frame velocity
+	 * @param seconds how far ahead to predict
+	 */
+	Pose predictPose(const OdometryState &state, float seconds);
+
+	/**
+	 * @brief Heading hold and auto-aim on top of arcade driving
+	 *
+	 * Call update() once per drive tick from the task that drives.
+	 */
+	class DriveAssist
+	{
+	public:
+		explicit DriveAssist(const AssistConfig &config);
+
+		/**
+		 * @brief Corrects one tick's stick command
+		 *
+		 * @param driver the driver's command, volts
+		 * @param state latest odometry estimate
+		 * @param sampleUs brain time the controller was sampled at
+		 * @param aim true while the driver wants to face the target
+		 * @return the command to send
+		 */
+		ArcadeCommand update(const ArcadeCommand &driver, const OdometryState &state, uint64_t sampleUs, bool aim);
+
+		/** @brief Turns the assist off, passing the sticks straight through, or back on */
+		void setEnabled(bool enabled);
+
+		/** @brief Replaces the gains and timing, from the task calling update() */
+		void setConfig(const AssistConfig &config) { m_config = config; }
+
+		const AssistConfig &config() const { return m_config; }
+
+		bool enabled() const { return m_enabled; }
+		AssistMode mode() const { return m_mode; }
+
+		/** @brief The pose the latest command was computed from */
+		const Pose &predicted() const { return m_predicted; }
+
+		/** @brief How far ahead the latest pose was predicted, microseconds */
+		uint32_t leadUs() const { return m_leadUs; }
+
+		/** @brief Time from the latest controller sample to the wheels responding, microseconds */
+		uint32_t latencyUs() const { return m_latencyUs; }
+
+		/** @brief Longest latencyUs() so far */
+		uint32_t worstLatencyUs() const { return m_worstLatencyUs; }
+
+		/** @brief Ticks spent holding a heading and aiming, so far */
+		uint32_t holdTicks() const { return m_holdTicks; }
+		uint32_t aimTicks() const { return m_aimTicks; }
+
+	private:
+		float correction(float error, float rate, float kp, float kd) const;
+
+		AssistConfig m_config;
+		bool m_enabled;
+		AssistMode m_mode;
+		float m_holdHeading;
+		Pose m_predicted;
+		uint32_t m_leadUs;
+		uint32_t m_latencyUs;
+		uint32_t m_worstLatencyUs;
+		uint32_t m_holdTicks;
+		uint32_t m_aimTicks;
+	};
+} // namespace art
@@ -0,0 +1,256 @@
+/**
+ * @file bus.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining the message bus: lock-free queues and mailboxes
+ * between tasks, grouped into topics declared at compile time
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Tasks that share a global need a mutex, and a mutex held by a low-priority
+ * task (the screen, the SD card) stalls every higher-priority task that wants
+ * it. Even a Seqlock reader spins while a write is in progress, which on one
+ * core means spinning until the writer is scheduled again. The primitives
+ * here never wait. Each has exactly one producer task and one consumer task,
+ * and both sides finish in a bounded number of steps whatever the other is
+ * doing:
+ *
+ * - SpscQueue: a ring of messages, for events where every one matters. A
+ *   full queue refuses the new message and counts it as dropped.
+ * - Mailbox: only the newest value, for state like the pose, where an old
+ *   value is useless once a new one exists. It is triple-buffered, so the
+ *   writer and reader never touch the same copy.
+ *
+ * A topic fans one publisher out to a fixed number of subscribers, each with
+ * its own queue or mailbox:
+ *
+ *     enum PoseReader { kControlReader, kUiReader, kPoseReaders };
+ *     art::LatestTopic<art::OdometryState, kPoseReaders> PoseTopic;
+ *
+ *     PoseTopic.publish(state);                              // odometry task
+ *     PoseTopic.subscriber<kUiReader>().latest();            // UI task
+ *
+ * Subscribers are picked by a compile-time index, so asking for one that was
+ * never declared does not build. Nothing here allocates.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+namespace art
+{
+	/**
+	 * @brief Lock-free queue with one producer task and one consumer task
+	 *
+	 * @tparam T a trivially copyable message type
+	 * @tparam N capacity, a power of two
+	 */
+	template <typename T, size_t N>
+	class SpscQueue
+	{
+		static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+	public:
+		SpscQueue() : m_head(0), m_tail(0), m_dropped(0) {}
+
+		/**
+		 * @brief Adds a message; producer only
+		 *
+		 * @return false if the queue was full and the message was dropped
+		 */
+		bool push(const T &item)
+		{
+			uint32_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_tail.load(std::memory_order_acquire) >= N)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			m_items[head & (N - 1)] = item;
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Takes the oldest message; consumer only
+		 *
+		 * @return false if the queue was empty
+		 */
+		bool pop(T &out)
+		{
+			uint32_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail == m_head.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			out = m_items[tail & (N - 1)];
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** @brief Messages waiting, exact on either side, a snapshot elsewhere */
+		size_t size() const
+		{
+			return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+		}
+
+		static constexpr size_t capacity() { return N; }
+
+		/** @brief Messages refused because the queue was full */
+		uint32_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+	private:
+		T m_items[N];
+		std::atomic<uint32_t> m_head; /**< written by the producer only */
+		std::atomic<uint32_t> m_tail; /**< written by the consumer only */
+		std::atomic<uint32_t> m_dropped;
+
+		SpscQueue(const SpscQueue &);
+		SpscQueue &operator=(const SpscQueue &);
+	};
+
+	/**
+	 * @brief Latest-value cell with one writer task and one reader task
+	 *
+	 * Three copies of the value are kept: the writer owns one, the reader owns
+	 * one, and the third is the newest finished value. Publishing swaps the
+	 * writer's copy with the shared one, and reading swaps the shared one with
+	 * the reader's when a newer value is there. Each swap is one atomic
+	 * exchange.
+	 *
+	 * @tparam T a trivially copyable type
+	 */
+	template <typename T>
+	class Mailbox
+	{
+	public:
+		Mailbox() : m_buffers(), m_shared(1), m_back(2), m_front(0), m_published(0) {}
+
+		/** @brief Replaces the value; writer only */
+		void publish(const T &value)
+		{
+			m_buffers[m_back] = value;
+			uint8_t previous = m_shared.exchange(m_back | kFresh, std::memory_order_acq_rel);
+			m_back = previous & kIndex;
+			m_published.fetch_add(1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief The newest value published; reader only
+		 *
+		 * The reference stays valid, and unchanged, until the reader's next
+		 * call. Before anything is published it is a value-initialised T.
+		 */
+		const T &latest()
+		{
+			if (m_shared.load(std::memory_order_acquire) & kFresh)
+			{
+				m_front = m_shared.exchange(m_front, std::memory_order_acq_rel) & kIndex;
+			}
+			return m_buffers[m_front];
+		}
+
+		/** @brief True if a value was published since the reader last called latest() */
+		bool fresh() const { return (m_shared.load(std::memory_order_acquire) & kFresh) != 0; }
+
+		/** @brief Values published so far */
+		uint32_t published() const { return m_published.load(std::memory_order_acquire); }
+
+	private:
+		static const uint8_t kIndex = 0x03;
+		static const uint8_t kFresh = 0x04;
+
+		T m_buffers[3];
+		std::atomic<uint8_t> m_shared; /**< index of the shared copy, with kFresh if it is unread */
+		uint8_t m_back;                /**< the writer's copy */
+		uint8_t m_front;               /**< the reader's copy */
+		std::atomic<uint32_t> m_published;
+
+		Mailbox(const Mailbox &);
+		Mailbox &operator=(const Mailbox &);
+	};
+
+	/**
+	 * @brief A value published by one task to a fixed set of subscribers,
+	 * each of which only ever sees the newest
+	 *
+	 * @tparam T a trivially copyable type
+	 * @tparam Readers number of subscribers, each on its own task
+	 */
+	template <typename T, size_t Readers>
+	class LatestTopic
+	{
+		static_assert(Readers > 0, "a topic needs at least one subscriber");
+
+	public:
+		/** @brief Publishes to every subscriber; publisher task only */
+		void publish(const T &value)
+		{
+			for (size_t i = 0; i < Readers; i++)
+			{
+				m_boxes[i].publish(value);
+			}
+		}
+
+		/** @brief Subscriber Reader's end of the topic; use it from that subscriber's task only */
+		template <size_t Reader>
+		Mailbox<T> &subscriber()
+		{
+			static_assert(Reader < Readers, "no such subscriber on this topic");
+			return m_boxes[Reader];
+		}
+
+		static constexpr size_t subscribers() { return Readers; }
+
+	private:
+		Mailbox<T> m_boxes[Readers];
+	};
+
+	/**
+	 * @brief Messages published by one task, each delivered to every one of a
+	 * fixed set of subscribers in order
+	 *
+	 * @tparam T a trivially copyable message type
+	 * @tparam N messages each subscriber can fall behind by, a power of two
+	 * @tparam Readers number of subscribers, each on its own task
+	 */
+	template <typename T, size_t N, size_t Readers>
+	class StreamTopic
+	{
+		static_assert(Readers > 0, "a topic needs at least one subscriber");
+
+	public:
+		/**
+		 * @brief Queues a message for every subscriber; publisher task only
+		 *
+		 * @return false if any subscriber's queue was full and missed it
+		 */
+		bool publish(const T &message)
+		{
+			bool delivered = true;
+			for (size_t i = 0; i < Readers; i++)
+			{
+				delivered = m_queues[i].push(message) && delivered;
+			}
+			return delivered;
+		}
+
+		/** @brief Subscriber Reader's queue; pop from that subscriber's task only */
+		template <size_t Reader>
+		SpscQueue<T, N> &subscriber()
+		{
+			static_assert(Reader < Readers, "no such subscriber on this topic");
+			return m_queues[Reader];
+		}
+
+		static constexpr size_t subscribers() { return Readers; }
+
+	private:
+		SpscQueue<T, N> m_queues[Readers];
+	};
+} // namespace art
@@ -0,0 +1,306 @@
+/**
+ * @file command.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring Commands, the groups that combine them and the
+ * CommandRunner that advances them from a periodic job
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * An autonomous routine written as blocking calls can only do one thing at a
+ * time: the intake waits for the drive, which waits for the lift. A Command
+ * instead does a little work each tick and says when it is done, so several
+ * can make progress together. Groups combine them:
+ *
+ * - Sequence: one after the other
+ * - Parallel: all at once, done when every one is done
+ * - Race: all at once, done as soon as any one is done
+ * - Deadline: all at once, done when the first one is done
+ *
+ * Groups are Commands too, so they nest. A CommandRunner registered as a
+ * Scheduler job runs the scheduled commands once per tick, which keeps
+ * every mechanism in lock step with the control loop. Nothing here
+ * allocates: commands and groups are ordinary objects, usually globals,
+ * and groups point at arrays of their children.
+ *
+ * When a child of a Sequence finishes, the next one starts and runs in the
+ * same tick. A chain of instant commands therefore costs no ticks at all.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "wait.h"
+
+namespace art
+{
+	/**
+	 * @brief An action that runs a little at a time, once per tick
+	 *
+	 * The runner calls start() once, update() every tick until it returns true,
+	 * then end(false). If the command is cancelled, or its group no longer
+	 * needs it, end(true) is called instead. A command may be started again
+	 * after it ends, so start() should reset any state.
+	 */
+	class Command
+	{
+	public:
+		virtual ~Command() {}
+
+		virtual void start() {}
+
+		/**
+		 * @brief Does one tick of work
+		 *
+		 * @return true once the command has finished
+		 */
+		virtual bool update() = 0;
+
+		/** @param interrupted true if the command was stopped before finishing */
+		virtual void end(bool interrupted) {}
+
+		/**
+		 * @brief False if the command was put together wrong and must not be
+		 * run, such as a group given more children than it can hold
+		 */
+		virtual bool valid() const { return true; }
+
+		/**
+		 * @brief True if the last run finished without doing its job, such as
+		 * a drive that gave up at an obstacle
+		 *
+		 * Asked once update() has returned true; a Sequence stops there
+		 * rather than start the steps that relied on it.
+		 */
+		virtual bool failed() const { return false; }
+	};
+
+	/**
+	 * @brief Calls a function once and finishes immediately
+	 */
+	class InstantCommand : public Command
+	{
+	public:
+		typedef void (*Fn)(void *context);
+
+		explicit InstantCommand(Fn fn, void *context = NULL);
+
+		bool update();
+
+	private:
+		Fn m_fn;
+		void *m_context;
+	};
+
+	/**
+	 * @brief Finishes after a fixed time
+	 */
+	class WaitCommand : public Command
+	{
+	public:
+		explicit WaitCommand(uint32_t durationMs);
+
+		void start();
+		bool update();
+
+	private:
+		uint32_t m_durationUs;
+		uint64_t m_startUs;
+	};
+
+	/**
+	 * @brief Finishes once a condition becomes true, or once the timeout has
+	 * passed so a stalled sensor cannot hold up the rest of a routine
+	 */
+	class WaitUntilCommand : public Command
+	{
+	public:
+		typedef bool (*Condition)(void *context);
+
+		/**
+		 * @param condition checked once per tick
+		 * @param context handed to condition
+		 * @param timeoutMs longest wait, or kForever
+		 */
+		WaitUntilCommand(Condition condition, void *context, uint32_t timeoutMs);
+
+		void start();
+		bool update();
+
+		/** @brief True if the last run ended on the timeout */
+		bool timedOut() const { return m_timedOut; }
+
+	private:
+		Condition m_condition;
+		void *m_context;
+		uint32_t m_timeoutMs;
+		uint64_t m_startUs;
+		bool m_timedOut;
+	};
+
+	/**
+	 * @brief Shared storage of the groups: pointers to the children and which
+	 * of them are still running
+	 */
+	class CommandGroup : public Command
+	{
+	public:
+		/** @brief Most children in one group */
+		static const size_t kMaxChildren = 32;
+
+		void end(bool interrupted);
+
+		/** @brief False if the group was given too many children, or holds an invalid one */
+		bool valid() const;
+
+		/** @brief True if any child that finished in the last run failed */
+		bool failed() const { return m_failed; }
+
+	protected:
+		/**
+		 * Given more than kMaxChildren, the group holds none and is not
+		 * valid(), so CommandRunner refuses it instead of running part of it.
+		 */
+		CommandGroup(Command *const *children, size_t count);
+
+		/** @brief Starts every child */
+		void startAll();
+
+		/** @brief Ends every child still running */
+		void endRunning(bool interrupted);
+
+		/** @brief Updates one running child, ending it if it finished, and notes if it failed */
+		bool updateChild(size_t i);
+
+		bool running(size_t i) const { return (m_running & (1u << i)) != 0; }
+
+		Command *const *m_children;
+		size_t m_count;
+		uint32_t m_running; /**< bit i set while child i is running */
+		bool m_fits;        /**< false if the group was given more than kMaxChildren */
+		bool m_failed;      /**< a child finished failed() since start() */
+	};
+
+	/**
+	 * @brief Runs its children one after another, stopping early if one fails
+	 */
+	class Sequence : public CommandGroup
+	{
+	public:
+		Sequence(Command *const *children, size_t count);
+
+		template <size_t N>
+		explicit Sequence(Command *const (&children)[N]) : Sequence(children, N)
+		{
+			static_assert(N <= kMaxChildren, "too many children for one group");
+		}
+
+		void start();
+		bool update();
+
+	private:
+		size_t m_current;
+	};
+
+	/**
+	 * @brief Runs its children together until every one has finished
+	 */
+	class Parallel : public CommandGroup
+	{
+	public:
+		Parallel(Command *const *children, size_t count);
+
+		template <size_t N>
+		explicit Parallel(Command *const (&children)[N]) : Parallel(children, N)
+		{
+			static_assert(N <= kMaxChildren, "too many children for one group");
+		}
+
+		void start();
+		bool update();
+	};
+
+	/**
+	 * @brief Runs its children together until any one of them finishes
+	 */
+	class Race : public CommandGroup
+	{
+	public:
+		Race(Command *const *children, size_t count);
+
+		template <size_t N>
+		explicit Race(Command *const (&children)[N]) : Race(children, N)
+		{
+			static_assert(N <= kMaxChildren, "too many children for one group");
+		}
+
+		void start();
+		bool update();
+	};
+
+	/**
+	 * @brief Runs its children together until the first one (the deadline)
+	 * finishes
+	 *
+	 * The other children may finish early. They are interrupted if they are
+	 * still running when the deadline finishes.
+	 */
+	class Deadline : public CommandGroup
+	{
+	public:
+		Deadline(Command *const *children, size_t count);
+
+		template <size_t N>
+		explicit Deadline(Command *const (&children)[N]) : Deadline(children, N)
+		{
+			static_assert(N <= kMaxChildren, "too many children for one group");
+		}
+
+		void start();
+		bool update();
+	};
+
+	/**
+	 * @brief Runs scheduled commands, one update per tick
+	 *
+	 * Register tick() as a Scheduler job, with the runner as its context.
+	 * Only touch a runner from the task that runs its tick.
+	 */
+	class CommandRunner
+	{
+	public:
+		/** @brief Commands that can be scheduled at once */
+		static const size_t kMaxCommands = 4;
+
+		CommandRunner();
+
+		/**
+		 * @brief Starts a command; it first updates on the next tick
+		 *
+		 * @return false if the command is already running, is not valid(), or
+		 * every slot is taken
+		 */
+		bool schedule(Command &command);
+
+		/** @brief Interrupts a running command */
+		void cancel(Command &command);
+
+		/** @brief Interrupts every running command */
+		void cancelAll();
+
+		/** @brief Updates every running command once */
+		void run();
+
+		bool running(const Command &command) const;
+		bool idle() const;
+
+		/** @brief PeriodicFn for a Scheduler job; context is the runner */
+		static void tick(void *runner);
+
+	private:
+		Command *m_commands[kMaxCommands];
+	};
+} // namespace art
@@ -0,0 +1,441 @@
+/**
+ * @file containers.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining fixed-capacity containers for use on hot paths
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * std::vector, std::string and std::map all allocate from the heap as they
+ * grow, at unpredictable moments. The containers here hold their elements
+ * inline with a capacity fixed at compile time, so they never allocate: an
+ * operation that would exceed the capacity fails and reports it instead.
+ *
+ * - RingBuffer: FIFO queue, e.g. for events or samples between two stages
+ * - SmallVector: array with a variable length up to its capacity
+ * - FixedMap: sorted key/value table with binary-search lookup
+ * - FixedString: bounded char buffer with printf-style formatting
+ *
+ * None of these are safe to share between tasks on their own.
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace art
+{
+	/**
+	 * @brief First-in, first-out queue with a fixed capacity
+	 *
+	 * @tparam T element type
+	 * @tparam N capacity, must be a power of two
+	 */
+	template <typename T, size_t N>
+	class RingBuffer
+	{
+		static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+	public:
+		RingBuffer() : m_head(0), m_tail(0) {}
+
+		/**
+		 * @brief Adds an element at the back
+		 *
+		 * @return false if the buffer was full and nothing was added
+		 */
+		bool push(const T &item)
+		{
+			if (full())
+			{
+				return false;
+			}
+			m_items[m_head & (N - 1)] = item;
+			m_head++;
+			return true;
+		}
+
+		/**
+		 * @brief Adds an element, discarding the oldest one if full
+		 */
+		void pushOverwrite(const T &item)
+		{
+			if (full())
+			{
+				m_tail++;
+			}
+			m_items[m_head & (N - 1)] = item;
+			m_head++;
+		}
+
+		/**
+		 * @brief Removes the element at the front
+		 *
+		 * @return false if the buffer was empty
+		 */
+		bool pop(T &out)
+		{
+			if (empty())
+			{
+				return false;
+			}
+			out = m_items[m_tail & (N - 1)];
+			m_tail++;
+			return true;
+		}
+
+		/** @brief Oldest element; the buffer must not be empty */
+		T &front() { return m_items[m_tail & (N - 1)]; }
+
+		/** @brief Element i places behind the front; i must be below size() */
+		T &at(size_t i) { return m_items[(m_tail + i) & (N - 1)]; }
+		const T &at(size_t i) const { return m_items[(m_tail + i) & (N - 1)]; }
+
+		size_t size() const { return m_head - m_tail; }
+		size_t capacity() const { return N; }
+		bool empty() const { return m_head == m_tail; }
+		bool full() const { return size() == N; }
+		void clear() { m_tail = m_head; }
+
+	private:
+		T m_items[N];
+		size_t m_head;
+		size_t m_tail;
+	};
+
+	/**
+	 * @brief Vector whose elements live inline, up to a fixed capacity
+	 *
+	 * Unlike a true small-vector it never spills to the heap: push_back()
+	 * simply fails once the capacity is reached.
+	 *
+	 * @tparam T element type, need not be default-constructible
+	 * @tparam N capacity
+	 */
+	template <typename T, size_t N>
+	class SmallVector
+	{
+	public:
+		SmallVector() : m_size(0) {}
+
+		~SmallVector() { clear(); }
+
+		SmallVector(const SmallVector &other) : m_size(0)
+		{
+			for (size_t i = 0; i < other.m_size; i++)
+			{
+				push_back(other[i]);
+			}
+		}
+
+		SmallVector &operator=(const SmallVector &other)
+		{
+			if (this != &other)
+			{
+				clear();
+				for (size_t i = 0; i < other.m_size; i++)
+				{
+					push_back(other[i]);
+				}
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Appends a copy of item
+		 *
+		 * @return false if the vector is full
+		 */
+		bool push_back(const T &item)
+		{
+			if (m_size >= N)
+			{
+				return false;
+			}
+			new (&m_storage[m_size]) T(item);
+			m_size++;
+			return true;
+		}
+
+		/**
+		 * @brief Constructs an element in place at the end
+		 *
+		 * @return the new element, or NULL if the vector is full
+		 */
+		template <typename... Args>
+		T *emplace_back(Args &&...args)
+		{
+			if (m_size >= N)
+			{
+				return NULL;
+			}
+			T *item = new (&m_storage[m_size]) T(std::forward<Args>(args)...);
+			m_size++;
+			return item;
+		}
+
+		/** @brief Removes the last element, if any */
+		void pop_back()
+		{
+			if (m_size > 0)
+			{
+				m_size--;
+				data()[m_size].~T();
+			}
+		}
+
+		/**
+		 * @brief Removes the element at index, shifting the rest down
+		 */
+		void erase(size_t index)
+		{
+			if (index >= m_size)
+			{
+				return;
+			}
+			T *items = data();
+			for (size_t i = index; i + 1 < m_size; i++)
+			{
+				items[i] = items[i + 1];
+			}
+			pop_back();
+		}
+
+		void clear()
+		{
+			while (m_size > 0)
+			{
+				pop_back();
+			}
+		}
+
+		T *data() { return reinterpret_cast<T *>(m_storage); }
+		const T *data() const { return reinterpret_cast<const T *>(m_storage); }
+		T &operator[](size_t i) { return data()[i]; }
+		const T &operator[](size_t i) const { return data()[i]; }
+		T *begin() { return data(); }
+		T *end() { return data() + m_size; }
+		const T *begin() const { return data(); }
+		const T *end() const { return data() + m_size; }
+		T &back() { return data()[m_size - 1]; }
+
+		size_t size() const { return m_size; }
+		size_t capacity() const { return N; }
+		bool empty() const { return m_size == 0; }
+		bool full() const { return m_size == N; }
+
+	private:
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage[N];
+		size_t m_size;
+	};
+
+	/**
+	 * @brief Sorted key/value table with a fixed capacity
+	 *
+	 * Keys are kept sorted in their own array, so lookups are a binary search
+	 * over contiguous keys. Inserting and erasing shift the later entries,
+	 * which is cheap at the sizes this is meant for (tens of entries).
+	 *
+	 * @tparam K key type, must support operator<
+	 * @tparam V value type, must be default-constructible
+	 * @tparam N capacity
+	 */
+	template <typename K, typename V, size_t N>
+	class FixedMap
+	{
+	public:
+		FixedMap() : m_size(0) {}
+
+		/**
+		 * @brief Inserts or replaces the value for key
+		 *
+		 * @return false if the key is new and the map is full
+		 */
+		bool insert(const K &key, const V &value)
+		{
+			size_t i = lowerBound(key);
+			if (i < m_size && !(key < m_keys[i]))
+			{
+				m_values[i] = value;
+				return true;
+			}
+			if (m_size >= N)
+			{
+				return false;
+			}
+			for (size_t j = m_size; j > i; j--)
+			{
+				m_keys[j] = m_keys[j - 1];
+				m_values[j] = m_values[j - 1];
+			}
+			m_keys[i] = key;
+			m_values[i] = value;
+			m_size++;
+			return true;
+		}
+
+		/**
+		 * @brief Looks up key
+		 *
+		 * @return the value, or NULL if the key is not present
+		 */
+		V *find(const K &key)
+		{
+			size_t i = lowerBound(key);
+			return (i < m_size && !(key < m_keys[i])) ? &m_values[i] : NULL;
+		}
+
+		const V *find(const K &key) const
+		{
+			return const_cast<FixedMap *>(this)->find(key);
+		}
+
+		/**
+		 * @brief Removes key
+		 *
+		 * @return false if it was not present
+		 */
+		bool erase(const K &key)
+		{
+			size_t i = lowerBound(key);
+			if (i >= m_size || key < m_keys[i])
+			{
+				return false;
+			}
+			for (size_t j = i; j + 1 < m_size; j++)
+			{
+				m_keys[j] = m_keys[j + 1];
+				m_values[j] = m_values[j + 1];
+			}
+			m_size--;
+			return true;
+		}
+
+		/** @brief Key of the i-th entry in sorted order */
+		const K &keyAt(size_t i) const { return m_keys[i]; }
+
+		/** @brief Value of the i-th entry in sorted order */
+		V &valueAt(size_t i) { return m_values[i]; }
+
+		size_t size() const { return m_size; }
+		size_t capacity() const { return N; }
+		bool empty() const { return m_size == 0; }
+		void clear() { m_size = 0; }
+
+	private:
+		size_t lowerBound(const K &key) const
+		{
+			size_t low = 0;
+			size_t high = m_size;
+			while (low < high)
+			{
+				size_t mid = (low + high) / 2;
+				if (m_keys[mid] < key)
+				{
+					low = mid + 1;
+				}
+				else
+				{
+					high = mid;
+				}
+			}
+			return low;
+		}
+
+		K m_keys[N];
+		V m_values[N];
+		size_t m_size;
+	};
+
+	/**
+	 * @brief Bounded, always null-terminated string
+	 *
+	 * Text that does not fit is truncated rather than reallocated.
+	 *
+	 * @tparam N capacity in characters, not counting the terminator
+	 */
+	template <size_t N>
+	class FixedString
+	{
+	public:
+		FixedString() : m_length(0) { m_text[0] = '\0'; }
+
+		FixedString(const char *text) : m_length(0)
+		{
+			m_text[0] = '\0';
+			append(text);
+		}
+
+		FixedString &operator=(const char *text)
+		{
+			clear();
+			append(text);
+			return *this;
+		}
+
+		/** @brief Appends as much of text as fits */
+		void append(const char *text)
+		{
+			while (*text && m_length < N)
+			{
+				m_text[m_length++] = *text++;
+			}
+			m_text[m_length] = '\0';
+		}
+
+		/**
+		 * @brief Appends printf-style formatted text, truncating if needed
+		 *
+		 * Formatting floats with newlib may allocate internally, so prefer
+		 * integer formats on hot paths.
+		 */
+		void appendf(const char *format, ...)
+		{
+			va_list args;
+			va_start(args, format);
+			int written = vsnprintf(m_text + m_length, N + 1 - m_length, format, args);
+			va_end(args);
+			if (written > 0)
+			{
+				m_length += (size_t)written < N - m_length ? (size_t)written : N - m_length;
+			}
+		}
+
+		/** @brief Replaces the contents with printf-style formatted text */
+		void format(const char *format, ...)
+		{
+			va_list args;
+			va_start(args, format);
+			int written = vsnprintf(m_text, N + 1, format, args);
+			va_end(args);
+			m_length = written < 0 ? 0 : ((size_t)written < N ? (size_t)written : N);
+			m_text[m_length] = '\0';
+		}
+
+		void clear()
+		{
+			m_length = 0;
+			m_text[0] = '\0';
+		}
+
+		bool operator==(const char *text) const { return strcmp(m_text, text) == 0; }
+		bool operator!=(const char *text) const { return strcmp(m_text, text) != 0; }
+
+		const char *c_str() const { return m_text; }
+		size_t length() const { return m_length; }
+		size_t capacity() const { return N; }
+		bool empty() const { return m_length == 0; }
+
+	private:
+		char m_text[N + 1];
+		size_t m_length;
+	};
+} // namespace art
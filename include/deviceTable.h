@@ -0,0 +1,181 @@
+/**
+ * @file deviceTable.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining MotorTable, which builds the robot's motors from a
+ * compile-time list of ports, cartridges, directions and groups
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A robot's devices are described once, as constexpr data in a layout struct:
+ *
+ *     struct Layout
+ *     {
+ *         static constexpr art::MotorSpec kMotors[] = {
+ *             {PORT1, vex::gearSetting::ratio6_1, false, kLeftDrive, "left front"},
+ *             ...
+ *         };
+ *     };
+ *
+ * MotorTable<Layout> constructs one vex::motor per entry, in order, as a
+ * plain array. Everything about the layout is known to the compiler, so a
+ * mistake like two motors on one port or a port that does not exist stops
+ * the build. A loop over a group checks a constant bitmask per motor and
+ * usually unrolls to straight-line calls, with no lookup at run time.
+ *
+ * The helpers below do the same checks for sensor ports, so a layout can
+ * static_assert that nothing is plugged into a port twice.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vex.h"
+
+namespace art
+{
+	/**
+	 * @brief One motor in a layout
+	 */
+	struct MotorSpec
+	{
+		int32_t port;           /**< PORT1 to PORT21 */
+		vex::gearSetting gears; /**< cartridge fitted to the motor */
+		bool reversed;          /**< spin the other way for positive commands */
+		uint32_t groups;        /**< bitmask of the groups the motor belongs to */
+		const char *name;       /**< for logs and fault messages */
+	};
+
+	/** @brief True if port is one of the Brain's smart ports */
+	constexpr bool validPort(int32_t port)
+	{
+		return port >= PORT1 && port <= PORT21;
+	}
+
+	/** @brief True if any of the motors is on port */
+	constexpr bool motorOnPort(const MotorSpec *motors, size_t count, int32_t port)
+	{
+		return count != 0 && (motors[0].port == port || motorOnPort(motors + 1, count - 1, port));
+	}
+
+	/** @brief True if every motor has a real port of its own */
+	constexpr bool motorPortsDistinct(const MotorSpec *motors, size_t count)
+	{
+		return count == 0 || (validPort(motors[0].port) && !motorOnPort(motors + 1, count - 1, motors[0].port) &&
+							  motorPortsDistinct(motors + 1, count - 1));
+	}
+
+	/** @brief True if any of ports is port */
+	constexpr bool portListed(const int32_t *ports, size_t count, int32_t port)
+	{
+		return count != 0 && (ports[0] == port || portListed(ports + 1, count - 1, port));
+	}
+
+	/**
+	 * @brief True if every sensor has a real port of its own, not shared with
+	 * another sensor or with any of the motors
+	 */
+	constexpr bool sensorPortsDistinct(const int32_t *ports, size_t count, const MotorSpec *motors,
+									   size_t motorCount)
+	{
+		return count == 0 || (validPort(ports[0]) && !portListed(ports + 1, count - 1, ports[0]) &&
+							  !motorOnPort(motors, motorCount, ports[0]) &&
+							  sensorPortsDistinct(ports + 1, count - 1, motors, motorCount));
+	}
+
+	/** @brief Number of the motors in any of groups */
+	constexpr size_t motorsInGroup(const MotorSpec *motors, size_t count, uint32_t groups)
+	{
+		return count == 0 ? 0 : ((motors[0].groups & groups) ? 1 : 0) + motorsInGroup(motors + 1, count - 1, groups);
+	}
+
+	/** @brief Bitmask with bit i set for each motor i in any of groups */
+	constexpr uint32_t motorMask(const MotorSpec *motors, size_t count, uint32_t groups)
+	{
+		return count == 0 ? 0u
+						  : (((motors[count - 1].groups & groups) ? 1u : 0u) << (count - 1)) |
+								motorMask(motors, count - 1, groups);
+	}
+
+	/** @brief A compile-time list of indices, for expanding over an array */
+	template <size_t... I>
+	struct Indices
+	{
+	};
+
+	template <size_t N, size_t... I>
+	struct MakeIndices : MakeIndices<N - 1, N - 1, I...>
+	{
+	};
+
+	template <size_t... I>
+	struct MakeIndices<0, I...>
+	{
+		typedef Indices<I...> Type;
+	};
+
+	/**
+	 * @brief The motors described by Layout::kMotors, constructed in order
+	 *
+	 * Index it with the same enum the layout is ordered by.
+	 *
+	 * @tparam Layout a struct with a static constexpr MotorSpec kMotors[]
+	 */
+	template <typename Layout>
+	class MotorTable
+	{
+	public:
+		static const size_t kCount = sizeof(Layout::kMotors) / sizeof(Layout::kMotors[0]);
+
+		static_assert(kCount <= 32, "group masks hold at most 32 motors");
+		static_assert(motorPortsDistinct(Layout::kMotors, kCount),
+					  "every motor needs its own port between PORT1 and PORT21");
+
+		MotorTable() : MotorTable(typename MakeIndices<kCount>::Type()) {}
+
+		vex::motor &operator[](size_t id) { return m_motors[id]; }
+		const vex::motor &operator[](size_t id) const { return m_motors[id]; }
+
+		static constexpr size_t size() { return kCount; }
+		static constexpr const MotorSpec &spec(size_t id) { return Layout::kMotors[id]; }
+
+		/** @brief True if motor id belongs to any of groups */
+		static constexpr bool inGroup(size_t id, uint32_t groups) { return (Layout::kMotors[id].groups & groups) != 0; }
+
+		/** @brief Number of motors in any of groups */
+		static constexpr size_t groupSize(uint32_t groups) { return motorsInGroup(Layout::kMotors, kCount, groups); }
+
+		/** @brief Bitmask with bit id set for each motor in any of groups */
+		static constexpr uint32_t mask(uint32_t groups) { return motorMask(Layout::kMotors, kCount, groups); }
+
+		/**
+		 * @brief Calls fn(motor, id) for each motor in any of groups
+		 */
+		template <typename Fn>
+		void forEach(uint32_t groups, Fn fn)
+		{
+			for (size_t id = 0; id < kCount; id++)
+			{
+				if (inGroup(id, groups))
+				{
+					fn(m_motors[id], id);
+				}
+			}
+		}
+
+	private:
+		template <size_t... I>
+		explicit MotorTable(Indices<I...>)
+			: m_motors{{Layout::kMotors[I].port, Layout::kMotors[I].gears, Layout::kMotors[I].reversed}...}
+		{
+		}
+
+		MotorTable(const MotorTable &);
+		MotorTable &operator=(const MotorTable &);
+
+		vex::motor m_motors[kCount];
+	};
+} // namespace art
@@ -0,0 +1,272 @@
+/**
+ * @file display.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the retained-mode widgets drawn on the Brain screen
+ * and the Display task that draws them
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Drawing on the Brain screen is slow, and redrawing everything every frame
+ * from a control loop costs milliseconds that loop cannot spare. Instead, the
+ * screen is described once, in pre_auton, as a set of widgets at fixed
+ * positions. Control code only ever hands a widget a new value, which is a
+ * small copy and never blocks. A low-priority task wakes at most
+ * Display::kFrameMs apart and redraws just the widgets whose value changed
+ * since it last drew them.
+ *
+ * Each widget should be updated from one task only; any task may update a
+ * different widget.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "vex.h"
+
+#include "containers.h"
+#include "seqlock.h"
+#include "watchdog.h"
+
+namespace art
+{
+	/**
+	 * @brief A rectangle of the screen that knows how to draw itself
+	 */
+	class Widget
+	{
+	public:
+		Widget(int x, int y, int width, int height);
+		virtual ~Widget() {}
+
+		/** @brief Changes whenever the widget needs to be drawn again */
+		virtual uint32_t version() const = 0;
+
+		/** @brief Draws the whole widget inside its rectangle */
+		virtual void draw(vex::brain::lcd &screen) = 0;
+
+		/** @brief Called on the Display task when the screen is pressed inside the widget */
+		virtual void touch(int x, int y) {}
+
+		bool contains(int x, int y) const
+		{
+			return x >= m_x && x < m_x + m_width && y >= m_y && y < m_y + m_height;
+		}
+
+	protected:
+		/** @brief Fills the widget's rectangle with the background colour */
+		void clear(vex::brain::lcd &screen);
+
+		int m_x;
+		int m_y;
+		int m_width;
+		int m_height;
+
+	private:
+		friend class Display;
+		uint32_t m_drawnVersion;
+	};
+
+	/**
+	 * @brief A label followed by a line of text
+	 */
+	class TextField : public Widget
+	{
+	public:
+		/** @brief Longest text kept, longer text is truncated */
+		static const size_t kLength = 40;
+
+		/**
+		 * @param label text drawn before the value, must live forever
+		 */
+		TextField(int x, int y, int width, const char *label);
+
+		/** @brief Shows new text; nothing is redrawn if it has not changed */
+		void set(const char *text);
+
+		/** @brief Shows printf-style formatted text */
+		void setf(const char *format, ...);
+
+		uint32_t version() const { return m_text.version(); }
+		void draw(vex::brain::lcd &screen);
+
+	private:
+		const char *m_label;
+		Seqlock<FixedString<kLength> > m_text;
+	};
+
+	/**
+	 * @brief A label, a value and a horizontal bar showing it within a range
+	 */
+	class Gauge : public Widget
+	{
+	public:
+		/**
+		 * @param label text drawn to the left of the bar, must live forever
+		 * @param minimum value drawn as an empty bar
+		 * @param maximum value drawn as a full bar
+		 */
+		Gauge(int x, int y, int width, int height, const char *label, float minimum, float maximum);
+
+		/**
+		 * @brief Shows a new value
+		 *
+		 * Only a change in the bar's length in pixels, or in the whole-number
+		 * value printed next to it, causes a redraw.
+		 */
+		void set(float value);
+
+		uint32_t version() const { return m_shown.version(); }
+		void draw(vex::brain::lcd &screen);
+
+	private:
+		struct Shown
+		{
+			int16_t fill;  /**< bar length in pixels */
+			int16_t value; /**< rounded value printed beside the bar */
+		};
+
+		int barWidth() const { return m_width - kLabelWidth - kValueWidth; }
+
+		static const int kLabelWidth = 60;
+		static const int kValueWidth = 50;
+
+		const char *m_label;
+		float m_minimum;
+		float m_maximum;
+		Shown m_last;
+		Seqlock<Shown> m_shown;
+	};
+
+	/**
+	 * @brief Cycles through a list of autonomous routines when pressed
+	 */
+	class AutonSelector : public Widget
+	{
+	public:
+		/**
+		 * @param names one name per routine, all living forever
+		 * @param count number of names, at least one
+		 */
+		AutonSelector(int x, int y, int width, int height, const char *const *names, size_t count);
+
+		/**
+		 * @brief Replaces the list of routines, for names only known at run
+		 * time; call before the Display is started
+		 *
+		 * The selection goes back to the first routine.
+		 */
+		void setNames(const char *const *names, size_t count);
+
+		/** @brief Index of the chosen routine, safe to call from any task */
+		size_t selected() const { return m_selected.load(std::memory_order_acquire); }
+
+		/** @brief Name of the chosen routine */
+		const char *selectedName() const { return m_names[selected()]; }
+
+		uint32_t version() const { return m_version.load(std::memory_order_acquire); }
+		void draw(vex::brain::lcd &screen);
+		void touch(int x, int y);
+
+	private:
+		const char *const *m_names;
+		size_t m_count;
+		std::atomic<size_t> m_selected;
+		std::atomic<uint32_t> m_version;
+	};
+
+	/**
+	 * @brief A widget drawn by a plain function, redrawn when invalidated
+	 */
+	class CustomWidget : public Widget
+	{
+	public:
+		typedef void (*DrawFn)(vex::brain::lcd &screen, int x, int y, void *context);
+
+		CustomWidget(int x, int y, int width, int height, DrawFn draw, void *context = NULL);
+
+		/** @brief Asks for the widget to be drawn again on the next frame */
+		void invalidate() { m_version.fetch_add(1, std::memory_order_release); }
+
+		uint32_t version() const { return m_version.load(std::memory_order_acquire); }
+		void draw(vex::brain::lcd &screen);
+
+	private:
+		DrawFn m_draw;
+		void *m_context;
+		std::atomic<uint32_t> m_version;
+	};
+
+	/**
+	 * @brief Owns a screen and redraws its changed widgets from a background task
+	 */
+	class Display
+	{
+	public:
+		/** @brief Shortest time between two frames, capping the frame rate at 20 Hz */
+		static const uint32_t kFrameMs = 50;
+
+		/** @brief Most widgets one Display can hold */
+		static const size_t kMaxWidgets = 16;
+
+		explicit Display(vex::brain::lcd &screen);
+
+		/**
+		 * @brief Adds a widget to the screen
+		 *
+		 * Add every widget before start(). The widget must outlive the Display.
+		 *
+		 * @return false if kMaxWidgets are already added
+		 */
+		bool add(Widget &widget);
+
+		/** @brief Clears the screen and starts the drawing task; later calls do nothing */
+		void start();
+
+		/** @brief Checks the drawing task into watchdog, as a task that can wait */
+		bool watch(Watchdog &watchdog);
+
+		/**
+		 * @brief Draws factor times less often, 1 for every kFrameMs
+		 *
+		 * For giving the CPU back to the control loops; may be called from
+		 * any task.
+		 */
+		void setSlowdown(uint32_t factor);
+
+		/** @brief Frames that drew at least one widget */
+		uint32_t frames() const { return m_frames; }
+
+		/** @brief Widgets drawn since start() */
+		uint32_t widgetsDrawn() const { return m_widgetsDrawn; }
+
+		/** @brief Longest frame so far, in microseconds */
+		uint32_t worstFrameUs() const { return m_worstFrameUs; }
+
+	private:
+		static int taskEntry(void *self);
+		void frame();
+
+		vex::brain::lcd &m_screen;
+		SmallVector<Widget *, kMaxWidgets> m_widgets;
+		vex::task m_task;
+		bool m_started;
+		bool m_wasPressing;
+		std::atomic<uint32_t> m_frameUs;
+		WatchHandle m_watch;
+
+		uint32_t m_frames;
+		uint32_t m_widgetsDrawn;
+		uint32_t m_worstFrameUs;
+	};
+
+	/**
+	 * @brief The Display drawing on Brain.Screen
+	 */
+	extern Display BrainDisplay;
+} // namespace art
@@ -0,0 +1,252 @@
+/**
+ * @file fieldMap.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the field model used to keep autonomous clear of
+ * things: FieldGrid, an occupancy grid of the fixed field built at compile
+ * time, and FieldMap, which adds what the distance sensors find on top
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The field is cut into 2 inch cells, 72 to a side, one bit each. A cell is
+ * set when the robot's centre cannot be there without the robot touching
+ * something: the walls and every element are grown by the robot's clearance
+ * before they are drawn in. That turns "does the robot hit anything" into
+ * "is the point's bit set", a shift and a mask, however many elements there
+ * are.
+ *
+ * FieldGrid holds the fixed field. It is computed by the compiler from a
+ * layout's list of elements, so it costs no time at startup, sits in flash
+ * instead of RAM, and a layout can static_assert that a starting tile is
+ * clear.
+ *
+ * FieldMap adds a second layer of the same size for obstacles nobody placed:
+ * another robot, a game element knocked out of place. A distance-sensor hit
+ * that is not on a wall or a known element, and that the next reading from
+ * the same sensor agrees with, marks a disc of cells around where that
+ * object must be. Detections are kept until clearDetections(), at the start
+ * of each autonomous period.
+ *
+ * Checking a step of a path costs the same whatever is on the field: the
+ * cells between its ends are walked, and path points are closer together
+ * than a cell, so that is two or three looks.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "deviceTable.h"
+#include "fusion.h"
+#include "odometry.h"
+
+namespace art
+{
+	/** @brief Inches between opposite walls, the field starting at 0, 0 */
+	constexpr float kFieldInches = 144.0f;
+
+	/** @brief Width of one grid cell, inches */
+	constexpr float kFieldCellInches = 2.0f;
+
+	/**
+	 * @brief One fixed element of the field, as a box with rounded edges
+	 *
+	 * A post or a round goal is a box of no size with a radius; a barrier is
+	 * a box with radius 0.
+	 */
+	struct FieldElement
+	{
+		const char *name;
+		float minX;   /**< inches */
+		float minY;
+		float maxX;
+		float maxY;
+		float radius; /**< inches around the box that are also solid */
+	};
+
+	/** @brief Which layers a FieldMap query looks at */
+	enum FieldLayer
+	{
+		kFixedLayer = 1,    /**< the walls and the layout's elements */
+		kDetectedLayer = 2, /**< obstacles found by the distance sensors */
+		kAllLayers = 3,
+	};
+
+	/**
+	 * @brief The robot's clearance around the fixed field, one bit per cell
+	 *
+	 * Constructed by the compiler when declared constexpr. Cells are numbered
+	 * row by row from the corner at 0, 0, 32 to a word.
+	 */
+	class FieldGrid
+	{
+	public:
+		static const int kCellsPerSide = (int)(kFieldInches / kFieldCellInches);
+		static const int kCells = kCellsPerSide * kCellsPerSide;
+		static const int kWords = (kCells + 31) / 32;
+
+		/**
+		 * @param elements the fixed elements, which must be constexpr too
+		 * @param count number of elements
+		 * @param clearance inches from the robot's centre to its furthest
+		 * edge, plus a margin for following error
+		 */
+		constexpr FieldGrid(const FieldElement *elements, size_t count, float clearance)
+			: FieldGrid(elements, count, clearance, typename MakeIndices<kWords>::Type())
+		{
+		}
+
+		/** @brief True if the robot cannot be centred in the cell; every cell off the field is */
+		constexpr bool occupied(int cellX, int cellY) const
+		{
+			return cellX < 0 || cellY < 0 || cellX >= kCellsPerSide || cellY >= kCellsPerSide ||
+				   ((m_words[(cellY * kCellsPerSide + cellX) >> 5] >> ((cellY * kCellsPerSide + cellX) & 31)) & 1u);
+		}
+
+		/** @brief True if the robot cannot be centred at x, y inches */
+		constexpr bool occupiedAt(float x, float y) const
+		{
+			return x < 0.0f || y < 0.0f || occupied((int)(x / kFieldCellInches), (int)(y / kFieldCellInches));
+		}
+
+		constexpr float clearance() const { return m_clearance; }
+
+	private:
+		static constexpr float clamp(float value, float low, float high)
+		{
+			return value < low ? low : value > high ? high : value;
+		}
+
+		/** @brief Whether a point lies within clearance of an element */
+		static constexpr bool nearElement(const FieldElement &element, float x, float y, float clearance)
+		{
+			return (x - clamp(x, element.minX, element.maxX)) * (x - clamp(x, element.minX, element.maxX)) +
+					   (y - clamp(y, element.minY, element.maxY)) * (y - clamp(y, element.minY, element.maxY)) <=
+				   (element.radius + clearance) * (element.radius + clearance);
+		}
+
+		/** @brief Whether a point lies within clearance of any of count elements */
+		static constexpr bool nearElements(const FieldElement *elements, size_t count, float x, float y,
+										   float clearance)
+		{
+			return count > 0 && (nearElement(elements[0], x, y, clearance) ||
+								 nearElements(elements + 1, count - 1, x, y, clearance));
+		}
+
+		/** @brief Centre of cell column or row i, inches */
+		static constexpr float centre(int i) { return (i + 0.5f) * kFieldCellInches; }
+
+		/** @brief Whether the robot centred in a cell would touch a wall or an element */
+		static constexpr bool cellBlocked(const FieldElement *elements, size_t count, float clearance, int cell)
+		{
+			return cell < kCells &&
+				   (centre(cell % kCellsPerSide) < clearance || centre(cell / kCellsPerSide) < clearance ||
+					centre(cell % kCellsPerSide) > kFieldInches - clearance ||
+					centre(cell / kCellsPerSide) > kFieldInches - clearance ||
+					nearElements(elements, count, centre(cell % kCellsPerSide), centre(cell / kCellsPerSide),
+								 clearance));
+		}
+
+		/** @brief Bits bit down to 0 of one word of the grid */
+		static constexpr uint32_t word(const FieldElement *elements, size_t count, float clearance, size_t index,
+									   int bit = 31)
+		{
+			return bit < 0 ? 0u
+						   : ((cellBlocked(elements, count, clearance, (int)index * 32 + bit) ? 1u : 0u) << bit) |
+								 word(elements, count, clearance, index, bit - 1);
+		}
+
+		template <size_t... I>
+		constexpr FieldGrid(const FieldElement *elements, size_t count, float clearance, Indices<I...>)
+			: m_words{word(elements, count, clearance, I)...}, m_clearance(clearance)
+		{
+		}
+
+		uint32_t m_words[kWords];
+		float m_clearance;
+	};
+
+	/**
+	 * @brief How the distance sensors' readings are turned into obstacles
+	 */
+	struct ObstacleConfig
+	{
+		float radius;   /**< inches, taken as the size of whatever is seen: about half another robot */
+		float maxRange; /**< readings further than this are not trusted to place an obstacle, inches */
+		float confirm;  /**< inches two readings in a row may disagree by and still be one object */
+	};
+
+	/**
+	 * @brief The fixed field plus the obstacles detected so far
+	 *
+	 * Not safe to share between tasks: observe() and the queries are all made
+	 * from the autonomous loop.
+	 */
+	class FieldMap
+	{
+	public:
+		/** @brief Most distance sensors whose readings are confirmed separately */
+		static const int kMaxSensors = 4;
+
+		FieldMap(const FieldGrid &fixed, const ObstacleConfig &config);
+
+		/** @brief True if the robot cannot be centred at x, y inches in the given layers */
+		bool blocked(float x, float y, int layers = kAllLayers) const;
+
+		/**
+		 * @brief True if the robot's centre cannot move in a straight line from
+		 * a to b without entering a blocked cell
+		 *
+		 * Walks every cell the segment crosses, so a step no longer than a
+		 * cell, like one between neighbouring path points, looks at three
+		 * cells at most.
+		 */
+		bool sweptBlocked(float ax, float ay, float bx, float by, int layers = kAllLayers) const;
+
+		/**
+		 * @brief Takes one distance-sensor reading into account
+		 *
+		 * @param sensor which sensor it came from, below kMaxSensors
+		 * @param pose where the robot is
+		 * @param mount where the sensor sits and points
+		 * @param range inches to what it sees, negative if nothing
+		 * @return true if the reading marked cells that were not marked before
+		 */
+		bool observe(int sensor, const Pose &pose, const RangeMount &mount, float range);
+
+		/** @brief Forgets every detected obstacle */
+		void clearDetections();
+
+		/** @brief Readings that marked new cells since the last clearDetections() */
+		uint32_t marks() const { return m_marks; }
+
+		/** @brief Changes every time a cell is marked or the detections are cleared */
+		uint32_t revision() const { return m_revision; }
+
+		const FieldGrid &fixed() const { return m_fixed; }
+
+	private:
+		/** @brief The last reading of one sensor, in field coordinates */
+		struct Hit
+		{
+			float x;
+			float y;
+			bool valid;
+		};
+
+		bool blockedCell(int cellX, int cellY, int layers) const;
+		bool markDisc(float x, float y, float radius);
+
+		const FieldGrid &m_fixed;
+		ObstacleConfig m_config;
+		uint32_t m_detected[FieldGrid::kWords];
+		Hit m_last[kMaxSensors];
+		uint32_t m_marks;
+		uint32_t m_revision;
+
+		FieldMap(const FieldMap &);
+		FieldMap &operator=(const FieldMap &);
+	};
+} // namespace art
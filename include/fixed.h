@@ -0,0 +1,101 @@
+/**
+ * @file fixed.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining Fixed, a Q16.16 fixed-point number
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The brain's code is built with -mfloat-abi=softfp, so every float passed to
+ * or returned from a function travels through integer registers and is moved
+ * to and from the FPU on each side of the call. Fixed keeps its value in a
+ * plain int32_t instead: 16 integer bits and 16 fraction bits, about
+ * +/-32767 with a resolution of 1/65536. Adding and comparing are single
+ * integer instructions, and multiplying is one 32x32->64 multiply and a
+ * shift.
+ *
+ * Fixed does not saturate, except when converting from float. Keep values,
+ * and the products of values, inside its range. Division needs a 64-bit
+ * divide, which is a library call on the Cortex-A9. Hot code should
+ * multiply by a precomputed reciprocal instead.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace art
+{
+	/**
+	 * @brief Signed Q16.16 fixed-point value
+	 */
+	class Fixed
+	{
+	public:
+		static const int kFractionBits = 16;
+		static const int32_t kOne = 1 << kFractionBits;
+
+		Fixed() : m_raw(0) {}
+
+		explicit Fixed(int value) : m_raw((int32_t)value * kOne) {}
+
+		/** @brief Rounds to the nearest step, saturating outside the range */
+		explicit Fixed(float value) : m_raw(fromFloat(value)) {}
+
+		static Fixed fromRaw(int32_t raw)
+		{
+			Fixed result;
+			result.m_raw = raw;
+			return result;
+		}
+
+		int32_t raw() const { return m_raw; }
+		float toFloat() const { return (float)m_raw * (1.0f / (float)kOne); }
+
+		/** @brief Rounds toward negative infinity */
+		int32_t toInt() const { return m_raw >> kFractionBits; }
+
+		Fixed operator-() const { return fromRaw(-m_raw); }
+		Fixed operator+(Fixed other) const { return fromRaw(m_raw + other.m_raw); }
+		Fixed operator-(Fixed other) const { return fromRaw(m_raw - other.m_raw); }
+
+		Fixed operator*(Fixed other) const
+		{
+			return fromRaw((int32_t)(((int64_t)m_raw * other.m_raw) >> kFractionBits));
+		}
+
+		Fixed operator/(Fixed other) const
+		{
+			return fromRaw((int32_t)(((int64_t)m_raw << kFractionBits) / other.m_raw));
+		}
+
+		Fixed &operator+=(Fixed other) { return *this = *this + other; }
+		Fixed &operator-=(Fixed other) { return *this = *this - other; }
+		Fixed &operator*=(Fixed other) { return *this = *this * other; }
+
+		bool operator==(Fixed other) const { return m_raw == other.m_raw; }
+		bool operator!=(Fixed other) const { return m_raw != other.m_raw; }
+		bool operator<(Fixed other) const { return m_raw < other.m_raw; }
+		bool operator>(Fixed other) const { return m_raw > other.m_raw; }
+		bool operator<=(Fixed other) const { return m_raw <= other.m_raw; }
+		bool operator>=(Fixed other) const { return m_raw >= other.m_raw; }
+
+	private:
+		static int32_t fromFloat(float value)
+		{
+			float scaled = value * (float)kOne;
+			if (scaled >= 2147483520.0f)
+			{
+				return INT32_MAX;
+			}
+			if (scaled <= -2147483520.0f)
+			{
+				return INT32_MIN;
+			}
+			return (int32_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+		}
+
+		int32_t m_raw;
+	};
+} // namespace art
@@ -0,0 +1,179 @@
+/**
+ * @file follower.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the path followers used in autonomous: PurePursuit
+ * over a Path, and Ramsete over a timed Trajectory
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * PurePursuit steers toward a point one lookahead distance further along the
+ * path. Rather than scanning the whole path for that point every tick, it
+ * remembers which segment it matched last time and only searches a fixed-size
+ * window of segments ahead of it. The robot can only move so far in one tick,
+ * so the window always contains the answer, and the cost per tick stays the
+ * same whether the path has fifty points or five thousand.
+ *
+ * Ramsete tracks a Trajectory in time instead: each tick looks up where the
+ * robot should be right now and corrects for the error, keeping the route's
+ * timing exactly as it was planned.
+ *
+ * Both produce wheel speeds in in/s; turning those into voltages is left to
+ * the drivetrain's feedforward.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "odometry.h"
+#include "trajectory.h"
+
+namespace art
+{
+	/**
+	 * @brief One point of a Path
+	 */
+	struct PathPoint
+	{
+		float x;        /**< inches */
+		float y;        /**< inches */
+		float distance; /**< inches from the start of the path */
+		float velocity; /**< planned speed here, in/s, negative when driving backwards */
+	};
+
+	/**
+	 * @brief A list of evenly spaced points with a planned speed at each
+	 */
+	class Path
+	{
+	public:
+		Path();
+
+		/**
+		 * @brief Builds a Path by resampling a Trajectory's positions
+		 *
+		 * @param trajectory source of positions and velocities
+		 * @param spacing distance between points, inches
+		 * @param arena where the points are stored
+		 * @return the path, invalid if the arena ran out of memory
+		 */
+		static Path fromTrajectory(const Trajectory &trajectory, float spacing, Arena &arena);
+
+		/** @brief Wraps points that already live somewhere permanent */
+		Path(const PathPoint *points, size_t count, float spacing);
+
+		bool valid() const { return m_count >= 2; }
+		size_t size() const { return m_count; }
+		float spacing() const { return m_spacing; }
+		float length() const { return m_count ? m_points[m_count - 1].distance : 0.0f; }
+		const PathPoint &operator[](size_t i) const { return m_points[i]; }
+
+	private:
+		const PathPoint *m_points;
+		size_t m_count;
+		float m_spacing;
+	};
+
+	/**
+	 * @brief Wheel speeds requested by a follower
+	 */
+	struct DriveCommand
+	{
+		float left;  /**< in/s */
+		float right; /**< in/s */
+	};
+
+	/**
+	 * @brief Tuning of a PurePursuit follower
+	 */
+	struct PursuitConfig
+	{
+		float lookahead;    /**< inches ahead of the robot to steer toward */
+		float trackWidth;   /**< inches between the left and right wheels */
+		float minVelocity;  /**< in/s floor so the robot never stalls before the end */
+		float endTolerance; /**< inches from the final point that count as arrived */
+		uint32_t window;    /**< segments searched each tick, 0 to size it from the lookahead */
+	};
+
+	/**
+	 * @brief Pure pursuit with an incremental, windowed search of the path
+	 */
+	class PurePursuit
+	{
+	public:
+		explicit PurePursuit(const PursuitConfig &config);
+
+		/**
+		 * @brief Starts following a path from its first point
+		 *
+		 * The path must stay alive for as long as it is followed.
+		 */
+		void begin(const Path &path);
+
+		/**
+		 * @brief Computes the wheel speeds for the current pose
+		 *
+		 * Searches at most window segments forward from the previous match,
+		 * once for the closest point and once for the lookahead point.
+		 */
+		DriveCommand update(const Pose &pose);
+
+		/** @brief True once the robot is within endTolerance of the last point */
+		bool finished() const { return m_finished; }
+
+		/** @brief Index of the segment the robot was last matched to */
+		size_t index() const { return m_index; }
+
+		/** @brief Point the robot was steering toward on the last update */
+		const Pose &target() const { return m_target; }
+
+		/** @brief Path being followed, as last handed to begin() */
+		const Path &path() const { return m_path; }
+
+	private:
+		PursuitConfig m_config;
+		Path m_path;
+		size_t m_index;
+		size_t m_window;
+		bool m_finished;
+		Pose m_target;
+	};
+
+	/**
+	 * @brief Gains of a Ramsete follower
+	 *
+	 * b acts like a proportional gain and zeta like a damping ratio. The
+	 * usual b = 2 is per square metre; with distances in inches it becomes
+	 * 2 * 0.0254^2.
+	 */
+	struct RamseteConfig
+	{
+		float b;          /**< 1/in^2 */
+		float zeta;       /**< dimensionless, between 0 and 1 */
+		float trackWidth; /**< inches between the left and right wheels */
+	};
+
+	/**
+	 * @brief Nonlinear time-based trajectory tracker
+	 */
+	class Ramsete
+	{
+	public:
+		explicit Ramsete(const RamseteConfig &config);
+
+		/**
+		 * @brief Computes wheel speeds that pull the robot onto the target
+		 *
+		 * @param pose where the robot is
+		 * @param target where the trajectory says it should be right now
+		 */
+		DriveCommand update(const Pose &pose, const TrajectoryState &target) const;
+
+	private:
+		RamseteConfig m_config;
+	};
+} // namespace art
@@ -0,0 +1,129 @@
+/**
+ * @file fusion.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring PoseFilter, the extended Kalman filter Odometry uses
+ * to fuse its dead reckoning with distance-sensor readings off the walls
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Dead reckoning only ever adds error: tracking wheels slip and the inertial
+ * sensor's heading drifts by a degree or two a minute, so over a skills run
+ * the pose wanders by inches. The field walls do not move, though, and a
+ * distance sensor pointed at one measures where the robot really is along
+ * one axis.
+ *
+ * PoseFilter keeps the pose as the state of an extended Kalman filter, with a
+ * 3x3 covariance saying how far each part of it can be trusted.
+ *
+ * - predict() moves the state by each odometry update (tracking wheels for
+ *   the displacement, the inertial sensor for the turn) and grows the
+ *   covariance with the distance driven, the angle turned and the time
+ *   passed.
+ * - correctRange() takes one distance reading, works out which wall the beam
+ *   should hit from the current estimate, and pulls the state toward
+ *   agreeing with it by as much as the two uncertainties allow. Heading is
+ *   corrected too, through its correlation with position.
+ *
+ * A reading that disagrees with the estimate by more than a few standard
+ * deviations is almost always something other than the wall (a game element,
+ * another robot) and is rejected. So are beams that hit a wall at a grazing
+ * angle or too close to a corner, where the wrong wall could be measured.
+ *
+ * Everything lives in fixed-size matrices, so an update never allocates, and
+ * each measurement is a scalar update, so there is no matrix inverse either.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "matrix.h"
+
+namespace art
+{
+	struct Pose;
+
+	/**
+	 * @brief Where a distance sensor sits on the robot, relative to the
+	 * tracking centre
+	 */
+	struct RangeMount
+	{
+		float forward; /**< inches in front of the centre */
+		float left;    /**< inches to the left of the centre */
+		float angle;   /**< direction of the beam, radians counter-clockwise from straight ahead */
+	};
+
+	/**
+	 * @brief Noise model and acceptance limits of a PoseFilter
+	 */
+	struct FusionConfig
+	{
+		float slipVariance;       /**< in^2 of position uncertainty added per inch driven */
+		float turnVariance;       /**< rad^2 of heading uncertainty added per radian turned */
+		float driftVariance;      /**< rad^2 of heading uncertainty added per second */
+		float rangeNoise;         /**< inches, standard deviation of a reading up close */
+		float rangeNoiseFraction; /**< added standard deviation per inch of range */
+		float maxRange;           /**< readings further than this are ignored, inches */
+		float minIncidence;       /**< cosine of the most glancing angle at which a wall is trusted */
+		float gate;               /**< readings this many standard deviations off are rejected */
+		float fieldSize;          /**< inches between opposite walls, the field starting at 0, 0 */
+	};
+
+	/**
+	 * @brief Extended Kalman filter over the robot's x, y and heading
+	 *
+	 * Not safe to share between tasks: Odometry owns one and only touches it
+	 * from its own task. The counters may be read from anywhere.
+	 */
+	class PoseFilter
+	{
+	public:
+		typedef Matrix<3, 1> State;
+		typedef Matrix<3, 3> Covariance;
+
+		explicit PoseFilter(const FusionConfig &config);
+
+		/** @brief Puts the robot at a known pose, with almost no uncertainty */
+		void reset(const Pose &pose);
+
+		/**
+		 * @brief Moves the estimate by one odometry step
+		 *
+		 * @param forward inches travelled forward, in the robot's frame
+		 * @param right inches travelled to the right, in the robot's frame
+		 * @param turn radians turned, counter-clockwise positive
+		 * @param dt seconds since the previous step
+		 */
+		void predict(float forward, float right, float turn, float dt);
+
+		/**
+		 * @brief Corrects the estimate with one distance-sensor reading
+		 *
+		 * @param mount where the sensor is and where it points
+		 * @param range inches from the sensor to the object it sees
+		 * @return true if the reading was used, false if it was rejected
+		 */
+		bool correctRange(const RangeMount &mount, float range);
+
+		Pose pose() const;
+		const Covariance &covariance() const { return m_covariance; }
+
+		/** @brief Readings used so far */
+		uint32_t accepted() const { return m_accepted.load(std::memory_order_relaxed); }
+
+		/** @brief Readings rejected by the gate or the geometry checks */
+		uint32_t rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+
+	private:
+		FusionConfig m_config;
+		State m_state;
+		Covariance m_covariance;
+		std::atomic<uint32_t> m_accepted;
+		std::atomic<uint32_t> m_rejected;
+	};
+} // namespace art
@@ -0,0 +1,50 @@
+/**
+ * @file heapGuard.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the debug check that flags heap allocations made
+ * after pre_auton
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Everything the robot needs should be allocated by the time pre_auton
+ * returns, either statically, in RobotArena, or on the heap during set-up.
+ * Building with `make HEAP_GUARD=1` defines ART_HEAP_GUARD, which replaces the
+ * global operator new so every allocation made after seal() is counted and
+ * reported by report(). Without the flag the functions below do nothing and
+ * the SDK's own operator new is used.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace art
+{
+	namespace heap
+	{
+		/**
+		 * @brief Marks the end of set-up; later heap allocations are flagged
+		 */
+		void seal();
+
+		/** @brief True once seal() has been called */
+		bool sealed();
+
+		/** @brief Number of allocations made after seal() */
+		uint32_t lateAllocations();
+
+		/** @brief Total bytes requested by allocations made after seal() */
+		size_t lateBytes();
+
+		/**
+		 * @brief Prints a warning to the serial console if new late allocations
+		 * happened since the previous call
+		 *
+		 * Cheap enough to call from a slow periodic job such as the UI.
+		 */
+		void report();
+	} // namespace heap
+} // namespace art
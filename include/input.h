@@ -0,0 +1,205 @@
+/**
+ * @file input.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the Input subsystem that samples a controller once
+ * per tick and turns its buttons into events
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Input::update() reads every stick and button of its controller once, keeps
+ * the result as a bitmask, and compares it with the previous tick to find
+ * presses, releases, holds and double taps. Those events go into a small
+ * fixed-size queue and are handed to whichever handlers were registered for
+ * them. Code that needs the sticks reads the values stored during the same
+ * update, shaped by a precomputed InputCurve, instead of asking the
+ * controller again.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vex.h"
+
+#include "containers.h"
+
+namespace art
+{
+	/**
+	 * @brief Every button on a V5 controller, in the order of Input::buttons()
+	 */
+	enum Button
+	{
+		kButtonL1,
+		kButtonL2,
+		kButtonR1,
+		kButtonR2,
+		kButtonUp,
+		kButtonDown,
+		kButtonLeft,
+		kButtonRight,
+		kButtonX,
+		kButtonB,
+		kButtonY,
+		kButtonA,
+		kButtonCount
+	};
+
+	/**
+	 * @brief The four analog axes, numbered as on the controller
+	 */
+	enum Axis
+	{
+		kAxis1,
+		kAxis2,
+		kAxis3,
+		kAxis4,
+		kAxisCount
+	};
+
+	/**
+	 * @brief What happened to a button
+	 */
+	enum InputEvent
+	{
+		kPressed,   /**< went down this tick */
+		kReleased,  /**< came up this tick */
+		kHeld,      /**< has been down for Input::kHoldMs; sent once per press */
+		kDoubleTap, /**< went down within Input::kDoubleTapMs of the previous press, sent after kPressed */
+		kInputEventCount
+	};
+
+	/**
+	 * @brief A function called when a button event happens
+	 */
+	typedef void (*InputHandler)(Button button, InputEvent event, void *context);
+
+	/**
+	 * @brief Deadband and response curve for an axis, as a lookup table
+	 *
+	 * The controller reports whole percents, so the shaped output for every
+	 * possible input is worked out once and each lookup is a single array
+	 * index.
+	 */
+	class InputCurve
+	{
+	public:
+		/**
+		 * @brief Builds the table
+		 *
+		 * Inputs inside the deadband give 0. Beyond it the remaining travel is
+		 * rescaled to 0-100 and raised to exponent, so 1 is linear and larger
+		 * values give finer control near the centre.
+		 *
+		 * @param deadband percent of travel ignored around the centre
+		 * @param exponent shape of the response, at least 1
+		 */
+		InputCurve(int deadband = 0, float exponent = 1.0f);
+
+		/** @brief Shaped output in percent, for a raw input from -100 to 100 */
+		float operator()(int raw) const
+		{
+			int magnitude = raw < 0 ? -raw : raw;
+			magnitude = magnitude > 100 ? 100 : magnitude;
+			return raw < 0 ? -m_table[magnitude] : m_table[magnitude];
+		}
+
+	private:
+		float m_table[101];
+	};
+
+	/**
+	 * @brief One sample of a controller and the button events it produces
+	 */
+	class Input
+	{
+	public:
+		/** @brief How long a button must be down to send kHeld */
+		static const uint32_t kHoldMs = 400;
+
+		/** @brief Longest gap between two presses that counts as a double tap */
+		static const uint32_t kDoubleTapMs = 250;
+
+		/** @brief Most handlers that can be registered */
+		static const size_t kMaxHandlers = 16;
+
+		explicit Input(vex::controller &controller);
+
+		/**
+		 * @brief Calls handler every time event happens to button
+		 *
+		 * Register handlers in pre_auton. They run on the task calling
+		 * update(), so keep them short.
+		 *
+		 * @return false if kMaxHandlers are already registered
+		 */
+		bool on(Button button, InputEvent event, InputHandler handler, void *context = NULL);
+
+		/** @brief Uses a curve for an axis; the curve must outlive the Input */
+		void setCurve(Axis axis, const InputCurve *curve) { m_curves[axis] = curve; }
+
+		/**
+		 * @brief Samples the controller, queues its events and dispatches them
+		 *
+		 * Call once per tick, ahead of anything that reads the sticks.
+		 */
+		void update();
+
+		/** @brief Brain time of the last update, the age of everything read from it */
+		uint64_t sampleUs() const { return m_sampleUs; }
+
+		/** @brief True if the button was down at the last update */
+		bool pressing(Button button) const { return (m_buttons >> button) & 1; }
+
+		/** @brief Every button at the last update, bit n being Button n */
+		uint16_t buttons() const { return m_buttons; }
+
+		/** @brief Unshaped axis position in percent at the last update */
+		int raw(Axis axis) const { return m_axes[axis]; }
+
+		/** @brief Axis position at the last update, through its curve */
+		float axis(Axis axis) const
+		{
+			return m_curves[axis] ? (*m_curves[axis])(m_axes[axis]) : (float)m_axes[axis];
+		}
+
+		/** @brief Events lost because the queue was full */
+		uint32_t overflows() const { return m_overflows; }
+
+	private:
+		struct Handler
+		{
+			uint8_t button;
+			uint8_t event;
+			InputHandler fn;
+			void *context;
+		};
+
+		struct QueuedEvent
+		{
+			uint8_t button;
+			uint8_t event;
+		};
+
+		void queue(int button, InputEvent event);
+
+		vex::controller &m_controller;
+		vex::controller::button *m_sources[kButtonCount];
+		const InputCurve *m_curves[kAxisCount];
+
+		uint64_t m_sampleUs;
+		uint16_t m_buttons;
+		int8_t m_axes[kAxisCount];
+		uint32_t m_pressedMs[kButtonCount];
+		uint16_t m_heldSent;
+		uint16_t m_tapUsed;
+
+		Handler m_handlers[kMaxHandlers];
+		size_t m_handlerCount;
+		RingBuffer<QueuedEvent, 32> m_queue;
+		uint32_t m_overflows;
+	};
+} // namespace art
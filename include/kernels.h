@@ -0,0 +1,136 @@
+/**
+ * @file kernels.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring vectorized math kernels for kinematics, filtering
+ * and pose transforms
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The V5's Cortex-A9 has a NEON unit that mkenv.mk already enables
+ * (-mfpu=neon), and it does four float operations for the price of one. The
+ * kernels here are the numeric work that runs every tick over many channels
+ * at once, written with NEON intrinsics so they use it. Each one also has a
+ * plain C++ version in art::kernels::scalar, which is what the main entry
+ * points call when NEON is not available (the x86 simulator build) and what
+ * the benchmarks compare against.
+ *
+ * Arrays are structure-of-arrays, like DeviceSnapshot: one array per
+ * quantity, any length, no alignment requirement. Lengths that are not a
+ * multiple of four finish their last few elements with the scalar code.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "odometry.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ART_NEON 1
+#endif
+
+namespace art
+{
+	namespace kernels
+	{
+		/**
+		 * @brief Inverse kinematics of a four-wheel holonomic drive
+		 *
+		 * Each wheel's surface speed is forward * vx + strafe * vy + turn * omega,
+		 * with vx forward, vy to the left and omega counter-clockwise. Wheels are
+		 * ordered front left, front right, back left, back right.
+		 */
+		struct WheelLayout
+		{
+			float forward[4];
+			float strafe[4];
+			float turn[4]; /**< inches of wheel travel per radian */
+		};
+
+		/**
+		 * @brief A mecanum drive with rollers at 45 degrees
+		 *
+		 * @param trackWidth inches between the left and right wheels
+		 * @param wheelBase inches between the front and back wheels
+		 */
+		WheelLayout mecanumLayout(float trackWidth, float wheelBase);
+
+		/**
+		 * @brief An X-drive with omni wheels at 45 degrees on the corners
+		 *
+		 * @param radius inches from the centre of rotation to each wheel
+		 */
+		WheelLayout xDriveLayout(float radius);
+
+		/** @brief True when the NEON versions are compiled in */
+		inline bool vectorized()
+		{
+#ifdef ART_NEON
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/**
+		 * @brief Wheel speeds for a chassis velocity
+		 *
+		 * @param speeds receives four wheel speeds, in the units of vx and vy
+		 */
+		void wheelSpeeds(const WheelLayout &layout, float vx, float vy, float omega, float speeds[4]);
+
+		/**
+		 * @brief First-order low-pass filter over count channels:
+		 * state += alpha * (input - state)
+		 *
+		 * @param alpha weight of the newest input, between 0 and 1
+		 */
+		void lowPass(float *state, const float *input, float alpha, size_t count);
+
+		/**
+		 * @brief One predict and update step of an independent constant-value
+		 * Kalman filter on each of count channels
+		 *
+		 * Every channel shares the same noise model. The variances are the
+		 * filter's own memory; start them large and the first measurement is
+		 * taken almost as-is.
+		 *
+		 * @param estimate filtered values, updated in place
+		 * @param variance uncertainty of each estimate, updated in place
+		 * @param measurement newest readings
+		 * @param processNoise variance the true value drifts by each step
+		 * @param measurementNoise variance of a reading
+		 */
+		void kalman(float *estimate, float *variance, const float *measurement, float processNoise,
+					float measurementNoise, size_t count);
+
+		/**
+		 * @brief Maps points given relative to frame into the field
+		 *
+		 * x and y may be the same arrays as outX and outY.
+		 */
+		void toField(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count);
+
+		/**
+		 * @brief Maps field points into frame, the inverse of toField
+		 */
+		void toFrame(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count);
+
+		/**
+		 * @brief The reference versions, one element at a time
+		 */
+		namespace scalar
+		{
+			void wheelSpeeds(const WheelLayout &layout, float vx, float vy, float omega, float speeds[4]);
+			void lowPass(float *state, const float *input, float alpha, size_t count);
+			void kalman(float *estimate, float *variance, const float *measurement, float processNoise,
+						float measurementNoise, size_t count);
+			void toField(const Pose &frame, const float *x, const float *y, float *outX, float *outY,
+						 size_t count);
+			void toFrame(const Pose &frame, const float *x, const float *y, float *outX, float *outY,
+						 size_t count);
+		} // namespace scalar
+	} // namespace kernels
+} // namespace art
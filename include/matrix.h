@@ -0,0 +1,138 @@
+/**
+ * @file matrix.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining Matrix, a small dense matrix whose size is fixed at
+ * compile time
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Filters on the robot work with a handful of states, so their matrices are a
+ * few floats held inline, never on the heap. The dimensions are template
+ * parameters: multiplying matrices of the wrong shapes does not compile, and
+ * the compiler can unroll every loop. There is deliberately no general
+ * inverse; filters built on this update one scalar measurement at a time,
+ * which only ever divides by a number.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace art
+{
+	/**
+	 * @brief R by C matrix of floats, stored row by row
+	 */
+	template <size_t R, size_t C>
+	class Matrix
+	{
+	public:
+		/** @brief Leaves the elements uninitialised, like a plain array */
+		Matrix() {}
+
+		static Matrix zero()
+		{
+			Matrix result;
+			for (size_t i = 0; i < R * C; i++)
+			{
+				result.m_data[i] = 0.0f;
+			}
+			return result;
+		}
+
+		static Matrix identity()
+		{
+			Matrix result = zero();
+			for (size_t i = 0; i < (R < C ? R : C); i++)
+			{
+				result(i, i) = 1.0f;
+			}
+			return result;
+		}
+
+		/** @brief A diagonal matrix with value at every diagonal element */
+		static Matrix diagonal(float value)
+		{
+			Matrix result = zero();
+			for (size_t i = 0; i < (R < C ? R : C); i++)
+			{
+				result(i, i) = value;
+			}
+			return result;
+		}
+
+		float &operator()(size_t row, size_t column) { return m_data[row * C + column]; }
+		float operator()(size_t row, size_t column) const { return m_data[row * C + column]; }
+
+		static constexpr size_t rows() { return R; }
+		static constexpr size_t columns() { return C; }
+
+		Matrix &operator+=(const Matrix &other)
+		{
+			for (size_t i = 0; i < R * C; i++)
+			{
+				m_data[i] += other.m_data[i];
+			}
+			return *this;
+		}
+
+		Matrix &operator-=(const Matrix &other)
+		{
+			for (size_t i = 0; i < R * C; i++)
+			{
+				m_data[i] -= other.m_data[i];
+			}
+			return *this;
+		}
+
+		Matrix &operator*=(float scale)
+		{
+			for (size_t i = 0; i < R * C; i++)
+			{
+				m_data[i] *= scale;
+			}
+			return *this;
+		}
+
+		Matrix operator+(const Matrix &other) const { return Matrix(*this) += other; }
+		Matrix operator-(const Matrix &other) const { return Matrix(*this) -= other; }
+		Matrix operator*(float scale) const { return Matrix(*this) *= scale; }
+
+		template <size_t K>
+		Matrix<R, K> operator*(const Matrix<C, K> &other) const
+		{
+			Matrix<R, K> result;
+			for (size_t i = 0; i < R; i++)
+			{
+				for (size_t j = 0; j < K; j++)
+				{
+					float sum = 0.0f;
+					for (size_t k = 0; k < C; k++)
+					{
+						sum += (*this)(i, k) * other(k, j);
+					}
+					result(i, j) = sum;
+				}
+			}
+			return result;
+		}
+
+		Matrix<C, R> transpose() const
+		{
+			Matrix<C, R> result;
+			for (size_t i = 0; i < R; i++)
+			{
+				for (size_t j = 0; j < C; j++)
+				{
+					result(j, i) = (*this)(i, j);
+				}
+			}
+			return result;
+		}
+
+	private:
+		float m_data[R * C];
+	};
+} // namespace art
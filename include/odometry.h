@@ -0,0 +1,209 @@
+/**
+ * @file odometry.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the Odometry engine that tracks the robot's position
+ * on the field from a background task
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Odometry integrates two tracking wheels (one parallel to the direction of
+ * travel, one perpendicular to it) and the inertial sensor's heading into a
+ * field position. It runs in its own vex::task at 200 Hz, independent of
+ * whatever autonomous or usercontrol are doing, so integration accuracy does
+ * not depend on how busy the control loops are. The latest estimate is
+ * published through a Seqlock, so any task can read it without blocking.
+ *
+ * The estimate itself is kept by a PoseFilter. Each update predicts it
+ * forward from the wheels and heading, then hands the filter to an optional
+ * correction function (see setCorrection()), which may feed it absolute
+ * measurements such as distance-sensor readings off the field walls.
+ *
+ * The field frame is in inches, with theta in radians counter-clockwise from
+ * the +x axis.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "vex.h"
+
+#include "bus.h"
+#include "fusion.h"
+#include "scheduler.h"
+#include "seqlock.h"
+
+namespace art
+{
+	/**
+	 * @brief A position and heading on the field
+	 */
+	struct Pose
+	{
+		float x;     /**< inches */
+		float y;     /**< inches */
+		float theta; /**< radians, counter-clockwise from +x */
+	};
+
+	/**
+	 * @brief Wraps an angle into [-pi, pi)
+	 *
+	 * Odometry headings are continuous (they keep counting past a full turn),
+	 * so use this on any difference between two headings.
+	 */
+	inline float wrapAngle(float radians)
+	{
+		const float kPi = 3.14159265f;
+		while (radians >= kPi)
+		{
+			radians -= 2.0f * kPi;
+		}
+		while (radians < -kPi)
+		{
+			radians += 2.0f * kPi;
+		}
+		return radians;
+	}
+
+	/**
+	 * @brief Everything Odometry publishes each update
+	 */
+	struct OdometryState
+	{
+		Pose pose;         /**< field-frame position */
+		Pose velocity;     /**< field-frame velocity, in/s and rad/s */
+		uint64_t timeUs;   /**< brain time of the sensor sample */
+	};
+
+	/**
+	 * @brief Where the tracking wheels sit relative to the tracking centre
+	 *
+	 * The tracking centre is the point the published pose refers to, usually
+	 * the centre of rotation of the drivetrain.
+	 */
+	struct OdometryConfig
+	{
+		float trackerDiameter; /**< tracking wheel diameter, inches */
+		float forwardOffset;   /**< forward wheel distance to the right of the centre, inches */
+		float sidewaysOffset;  /**< sideways wheel distance in front of the centre, inches */
+	};
+
+	/**
+	 * @brief Background pose estimator running at a fixed 200 Hz
+	 */
+	class Odometry
+	{
+	public:
+		/** @brief Update period of the odometry task */
+		static const uint32_t kPeriodMs = 5;
+
+		/** @brief How long the odometry task can go without running before the watchdog calls it stalled */
+		static const uint32_t kWatchTimeoutMs = 100;
+
+		/**
+		 * @brief Called on the odometry task after each prediction, to correct
+		 * the filter with whatever measurements are available
+		 */
+		typedef void (*CorrectFn)(PoseFilter &filter, void *context);
+
+		/** @brief Called on the odometry task with every new estimate */
+		typedef void (*PublishFn)(const OdometryState &state, void *context);
+
+		/**
+		 * @brief Creates an Odometry engine for the given sensors
+		 *
+		 * Nothing runs until start() is called.
+		 *
+		 * @param forward rotation sensor on the wheel parallel to travel
+		 * @param sideways rotation sensor on the wheel perpendicular to travel
+		 * @param imu inertial sensor providing heading
+		 * @param config tracking wheel geometry
+		 * @param fusion noise model of the PoseFilter
+		 */
+		Odometry(vex::rotation &forward, vex::rotation &sideways, vex::inertial &imu,
+				 const OdometryConfig &config, const FusionConfig &fusion);
+
+		/**
+		 * @brief Registers the correction step; call before start()
+		 *
+		 * It runs inside the 5 ms update, so it must be quick and must never
+		 * block.
+		 */
+		void setCorrection(CorrectFn correct, void *context = NULL);
+
+		/**
+		 * @brief Registers a function that passes each estimate on, usually to
+		 * a LatestTopic; call before start()
+		 */
+		void setPublisher(PublishFn publish, void *context = NULL);
+
+		/**
+		 * @brief Starts the odometry task
+		 *
+		 * Call once from pre_auton, after the inertial sensor has been
+		 * calibrated. Calling it again has no effect.
+		 */
+		void start();
+
+		/**
+		 * @brief Checks the odometry task into watchdog, as a critical task
+		 *
+		 * Call after start().
+		 */
+		bool watch(Watchdog &watchdog) { return m_loop.watch(watchdog, "odometry", kWatchTimeoutMs); }
+
+		/** @brief Latest pose, safe to call from any task */
+		Pose pose() const { return m_state.read().pose; }
+
+		/** @brief Latest pose, velocity and timestamp, safe to call from any task */
+		OdometryState state() const { return m_state.read(); }
+
+		/**
+		 * @brief Moves the estimate to a known pose
+		 *
+		 * The reset is handed to the odometry task through a Mailbox and
+		 * applied at its next update, so the integrator itself only ever has
+		 * one writer. Only call it from one task at a time.
+		 */
+		void setPose(const Pose &pose);
+
+		/** @brief Timing statistics of the odometry task */
+		const TaskStats &stats() const { return m_loop.stats(0); }
+
+		/** @brief The filter, for its counters and covariance */
+		const PoseFilter &filter() const { return m_filter; }
+
+	private:
+		static int taskEntry(void *self);
+		static void tick(void *self);
+		void update();
+		float readHeading();
+
+		vex::rotation &m_forward;
+		vex::rotation &m_sideways;
+		vex::inertial &m_imu;
+		OdometryConfig m_config;
+		PoseFilter m_filter;
+		CorrectFn m_correct;
+		void *m_correctContext;
+		PublishFn m_publish;
+		void *m_publishContext;
+
+		Scheduler m_loop;
+		vex::task m_task;
+		bool m_started;
+
+		Seqlock<OdometryState> m_state;
+		Mailbox<Pose> m_resetPose;
+
+		OdometryState m_working;
+		float m_headingOffset;
+		float m_lastForward;
+		float m_lastSideways;
+		float m_lastHeading;
+	};
+} // namespace art
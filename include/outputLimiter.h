@@ -0,0 +1,101 @@
+/**
+ * @file outputLimiter.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the OutputLimiter, the last stage every motor
+ * command goes through before it reaches the hardware
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Over a long skills run the drive motors heat up until the V5 firmware cuts
+ * their power, and hard accelerations pull the battery low enough to brown
+ * out the whole robot. The OutputLimiter stops both from happening by giving
+ * up a little speed early instead of a lot of it late. Once per tick it
+ * takes every motor's requested voltage and the latest current and
+ * temperature readings, and scales each output by:
+ *
+ * - thermal derating, ramping from full output at deratingStart down to zero
+ *   at deratingEnd
+ * - a per-motor current limit
+ * - a shared current budget across a group of motors (usually the drive),
+ *   which pulls all of them back evenly so the robot still drives straight
+ *
+ * It then slew-limits the result. The measured current only reflects the
+ * voltage applied last tick, so the limiter divides it by last tick's scale
+ * to estimate what the motor would draw at full request. That keeps the
+ * scale steady instead of bouncing between limited and unlimited every tick.
+ * Scales drop immediately, but only recover at kRecoveryPerSecond.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace art
+{
+	/**
+	 * @brief Limits enforced by an OutputLimiter
+	 */
+	struct LimiterConfig
+	{
+		float slewRate;        /**< volts per second any output may change by */
+		float currentLimit;    /**< amps one motor may draw */
+		float deratingStart;   /**< degrees Celsius where thermal derating begins */
+		float deratingEnd;     /**< degrees Celsius where the output reaches zero */
+		float budgetCurrent;   /**< amps the budget motors may draw together */
+		uint32_t budgetMotors; /**< bit i set if motor i shares budgetCurrent */
+	};
+
+	/**
+	 * @brief Batched derating and slew limiting of every motor's output
+	 */
+	class OutputLimiter
+	{
+	public:
+		/** @brief Most motors one limiter handles, one per smart port */
+		static const size_t kMaxOutputs = 21;
+
+		/** @brief Fraction of full output a scale may recover per second */
+		static constexpr float kRecoveryPerSecond = 2.0f;
+
+		/**
+		 * @param config limits to enforce
+		 * @param count number of motors, at most kMaxOutputs
+		 */
+		OutputLimiter(const LimiterConfig &config, size_t count);
+
+		/**
+		 * @brief Runs one tick of the stage
+		 *
+		 * @param requested volts each motor's owner asked for, -12 to 12
+		 * @param current each motor's current, amps, ideally filtered
+		 * @param temperature each motor's temperature, degrees Celsius
+		 * @param periodMs time since the previous call
+		 * @param output receives the volts to send to each motor
+		 */
+		void limit(const float *requested, const float *current, const float *temperature, uint32_t periodMs,
+				   float *output);
+
+		/** @brief Clears the slew history, so the next outputs start from zero */
+		void reset();
+
+		/** @brief Fraction of its request motor i got last tick, from derating */
+		float scale(size_t i) const { return i < m_count ? m_scale[i] : 1.0f; }
+
+		/** @brief Fraction the shared budget allowed last tick */
+		float budgetScale() const { return m_budgetScale; }
+
+		/** @brief Ticks in which any motor was derated */
+		uint32_t limitedTicks() const { return m_limitedTicks; }
+
+	private:
+		LimiterConfig m_config;
+		size_t m_count;
+		float m_last[kMaxOutputs];
+		float m_scale[kMaxOutputs];
+		float m_budgetScale;
+		uint32_t m_limitedTicks;
+	};
+} // namespace art
@@ -0,0 +1,91 @@
+/**
+ * @file paramMenu.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring ParamMenu, which edits the ParamRegistry from the
+ * controller's buttons and screen
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * On the practice field there is rarely a laptop at hand, so the same values
+ * TuneLink serves can be changed from the controller:
+ *
+ * - X opens and closes the menu. Driving carries on while it is open.
+ * - Up and Down pick the entry.
+ * - Right and Left add or take one step; holding either adds ten more.
+ * - A saves straight away rather than once edits settle.
+ *
+ * The controller screen is three lines of about 19 characters and takes tens
+ * of milliseconds to update each one over the radio, so draw() only writes a
+ * line whose text changed, and at most one line per call.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vex.h"
+
+#include "containers.h"
+#include "input.h"
+#include "params.h"
+
+namespace art
+{
+	/**
+	 * @brief Controller screen menu over a ParamRegistry
+	 */
+	class ParamMenu
+	{
+	public:
+		/** @brief Characters per line of the controller screen */
+		static const size_t kColumns = 19;
+
+		/** @brief Lines of the controller screen */
+		static const int kRows = 3;
+
+		/** @brief Extra steps a held Left or Right adds */
+		static const int kHeldSteps = 10;
+
+		ParamMenu(ParamRegistry &params, vex::controller::lcd &screen);
+
+		/**
+		 * @brief Registers the menu's button handlers with input
+		 *
+		 * Call from pre_auton, after the registry is filled in.
+		 *
+		 * @return false if input ran out of handlers
+		 */
+		bool attach(Input &input);
+
+		bool isOpen() const { return m_open; }
+
+		/** @brief Entry the menu is on */
+		size_t selected() const { return m_selected; }
+
+		/**
+		 * @brief Writes the next changed line to the controller screen
+		 *
+		 * Call from the task running input's handlers, no more often than
+		 * every 50 ms.
+		 */
+		void draw();
+
+	private:
+		static void onButton(Button button, InputEvent event, void *self);
+		void compose();
+
+		ParamRegistry &m_params;
+		vex::controller::lcd &m_screen;
+		bool m_open;
+		size_t m_selected;
+		FixedString<kColumns> m_lines[kRows];
+		FixedString<kColumns> m_shown[kRows];
+		bool m_cleared; /**< the screen has been cleared once */
+
+		ParamMenu(const ParamMenu &);
+		ParamMenu &operator=(const ParamMenu &);
+	};
+} // namespace art
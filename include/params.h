@@ -0,0 +1,281 @@
+/**
+ * @file params.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the ParamRegistry, which lets gains and limits be
+ * changed while the program runs and keeps them on the SD card
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Changing a gain used to mean editing the code, rebuilding and uploading
+ * again. Instead, the values worth tuning are registered once, in pre_auton,
+ * as typed entries with a name and a range, and can then be edited from the
+ * controller screen (see ParamMenu) or over the USB serial port (see
+ * TuneLink).
+ *
+ * An edit never touches the variable it is for. It is range checked and
+ * staged, and the control loop calls apply() at the start of a tick to copy
+ * every staged value into place at once. A subsystem therefore never sees
+ * half of a set of gains, nor a gain changing in the middle of its update.
+ * Entries belong to groups, and each group's ApplyFn is called after any of
+ * its values changed, so the subsystem can take the new values in the way it
+ * needs (rebuilding a Pid, posting them to another task...).
+ *
+ * Edited values are written to the SD card by a low-priority task once edits
+ * have stopped for kSaveDelayMs, and loaded back by load() at startup. The
+ * file layout is described in @ref param_format.
+ */
+
+/**
+ * @page param_format Parameter file format
+ *
+ * All multi-byte values are little-endian. Values are matched to entries by
+ * name when loading, so entries can be added, removed or reordered in the
+ * program without invalidating the file: names the program does not know,
+ * and values outside an entry's range, are skipped.
+ *
+ * @section param_header Header, 16 bytes
+ *
+ * | Offset | Size | Field      | Meaning                                  |
+ * |--------|------|------------|------------------------------------------|
+ * | 0      | 4    | magic      | char[4] "ARTP"                           |
+ * | 4      | 2    | version    | uint16 format version, currently 1       |
+ * | 6      | 2    | count      | uint16 number of records that follow     |
+ * | 8      | 4    | size       | uint32 length of the whole file in bytes |
+ * | 12     | 4    | checksum   | uint32 32-bit FNV-1a of bytes 16 to size |
+ *
+ * @section param_record Record, 24 bytes
+ *
+ * | Offset | Size | Field    | Meaning                                     |
+ * |--------|------|----------|---------------------------------------------|
+ * | 0      | 16   | name     | char[16], zero padded, at least one zero    |
+ * | 16     | 1    | type     | a ParamType                                 |
+ * | 17     | 3    | reserved | 0                                           |
+ * | 20     | 4    | value    | float32 for kParamFloat, int32 otherwise    |
+ *
+ * A record whose type does not match the entry of the same name is skipped.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "vex.h"
+
+#include "watchdog.h"
+
+namespace art
+{
+	/**
+	 * @brief What kind of variable an entry edits
+	 */
+	enum ParamType
+	{
+		kParamFloat, /**< a float */
+		kParamInt,   /**< an int32_t */
+		kParamBool,  /**< a bool, edited as 0 or 1 */
+	};
+
+	/**
+	 * @brief Outcome of an edit
+	 */
+	enum ParamResult
+	{
+		kParamOk,
+		kParamUnknown,    /**< there is no entry with that index */
+		kParamOutOfRange, /**< outside the entry's range */
+		kParamNotWhole,   /**< a fraction for an integer entry */
+	};
+
+	/**
+	 * @brief Registry of every runtime-editable value
+	 */
+	class ParamRegistry
+	{
+	public:
+		/** @brief Most entries */
+		static const size_t kMaxParams = 32;
+
+		/** @brief Most groups */
+		static const size_t kMaxGroups = 8;
+
+		/** @brief Longest name, including the terminating zero */
+		static const size_t kNameLength = 16;
+
+		/** @brief How long after the last edit the values are saved */
+		static const uint32_t kSaveDelayMs = 1000;
+
+		/** @brief How often the save task checks for unsaved edits */
+		static const uint32_t kSavePeriodMs = 200;
+
+		/** @brief Called by apply() on the control task after a group's values changed */
+		typedef void (*ApplyFn)(void *context);
+
+		ParamRegistry();
+
+		/**
+		 * @brief Adds a group of entries applied together
+		 *
+		 * @return the group, or -1 if kMaxGroups are already registered
+		 */
+		int addGroup(const char *name, ApplyFn apply = NULL, void *context = NULL);
+
+		/**
+		 * @brief Registers a variable, from pre_auton
+		 *
+		 * The variable's current value is the starting value, and must be
+		 * inside the range. The variable must outlive the registry, and only
+		 * be written by apply() from then on.
+		 *
+		 * @param group from addGroup()
+		 * @param name up to kNameLength - 1 characters, unique
+		 * @param step how much one press of the controller menu changes it
+		 * @return the entry's index, or -1 if the registry is full or an
+		 * argument is invalid
+		 */
+		int add(int group, const char *name, float *value, float min, float max, float step);
+		int add(int group, const char *name, int32_t *value, int32_t min, int32_t max, int32_t step = 1);
+		int add(int group, const char *name, bool *value);
+
+		size_t size() const { return m_count; }
+
+		/** @brief Index of the entry called name, or -1 */
+		int find(const char *name) const;
+
+		const char *name(size_t index) const { return m_entries[index].name; }
+		ParamType type(size_t index) const { return (ParamType)m_entries[index].type; }
+		int group(size_t index) const { return m_entries[index].group; }
+		const char *groupName(int group) const { return m_groups[group].name; }
+		float min(size_t index) const { return m_entries[index].min; }
+		float max(size_t index) const { return m_entries[index].max; }
+		float step(size_t index) const { return m_entries[index].step; }
+
+		/** @brief The newest value asked for, applied or not */
+		float value(size_t index);
+
+		/** @brief True if an edit of the entry is waiting for apply() */
+		bool pending(size_t index);
+
+		/**
+		 * @brief Stages a new value, from any task
+		 *
+		 * Integer and bool entries only take whole values.
+		 */
+		ParamResult set(size_t index, float value);
+
+		/** @brief Stages the value steps steps away, clamped to the range */
+		ParamResult nudge(size_t index, int steps);
+
+		/**
+		 * @brief Writes every staged value into its variable, then calls the
+		 * ApplyFn of each group that changed
+		 *
+		 * Call at the start of a tick from the task that runs the subsystems
+		 * using the values.
+		 *
+		 * @return the number of entries written
+		 */
+		size_t apply();
+
+		/**
+		 * @brief Stages the values saved in a file, from a startup stage
+		 *
+		 * They take effect at the next apply(). A missing file is not an
+		 * error: there is simply nothing to load.
+		 *
+		 * @return false if the file exists but is damaged
+		 */
+		bool load(const char *fileName);
+
+		/** @brief Entries set by the last load() */
+		size_t loaded() const { return m_loaded; }
+
+		/**
+		 * @brief Starts the task saving edits to fileName
+		 *
+		 * Call once, after load(). Later calls do nothing.
+		 */
+		void startSaving(const char *fileName);
+
+		/** @brief Saves at the save task's next check, without waiting for kSaveDelayMs */
+		void requestSave() { m_saveRequested.store(true, std::memory_order_release); }
+
+		/** @brief True while some edit has not been written to the SD card */
+		bool unsaved() const { return m_unsaved.load(std::memory_order_acquire); }
+
+		/** @brief Entries written by apply() so far */
+		uint32_t applied() const { return m_applied; }
+
+		/** @brief Checks the save task into watchdog, as a task that can wait */
+		bool watch(Watchdog &watchdog);
+
+		/** @brief Files written, and writes the SD card rejected */
+		uint32_t saves() const { return m_saves; }
+		uint32_t saveErrors() const { return m_saveErrors; }
+
+	private:
+		union Value
+		{
+			float f;
+			int32_t i;
+		};
+
+		struct Entry
+		{
+			char name[kNameLength];
+			uint8_t type;
+			uint8_t group;
+			void *target;
+			float min;
+			float max;
+			float step;
+			Value staged;
+		};
+
+		struct Group
+		{
+			const char *name;
+			ApplyFn apply;
+			void *context;
+		};
+
+		int addEntry(int group, const char *name, ParamType type, void *target, float min, float max, float step,
+					 Value initial);
+		ParamResult stage(size_t index, float value);
+		size_t encode(uint8_t *image, size_t capacity);
+
+		static int taskEntry(void *self);
+		void saveLoop();
+
+		vex::mutex m_lock;
+		Entry m_entries[kMaxParams];
+		size_t m_count;
+		Group m_groups[kMaxGroups];
+		size_t m_groupCount;
+		uint32_t m_dirty; /**< bit n set while entry n has an edit waiting for apply() */
+
+		const char *m_fileName;
+		vex::task m_task;
+		WatchHandle m_watch;
+		std::atomic<bool> m_unsaved;
+		std::atomic<bool> m_saveRequested;
+		uint32_t m_lastEditMs;
+
+		size_t m_loaded;
+		uint32_t m_applied;
+		uint32_t m_saves;
+		uint32_t m_saveErrors;
+
+		ParamRegistry(const ParamRegistry &);
+		ParamRegistry &operator=(const ParamRegistry &);
+	};
+
+	/**
+	 * @brief The robot's tunable values
+	 */
+	extern ParamRegistry Params;
+} // namespace art
@@ -0,0 +1,161 @@
+/**
+ * @file pid.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining Pid, a feedback and feedforward controller templated
+ * on its number representation
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Pid<FloatMath> does its arithmetic in float. Pid<FixedMath> does the same
+ * arithmetic in Q16.16 Fixed, for the fastest loops where the softfp call
+ * overhead of floats adds up. The gains are always given as floats and are
+ * converted once, when the controller is constructed. They are pre-scaled by
+ * the loop period, so update() never divides.
+ *
+ * With FixedMath the pre-scaled integral gain kI * period is quantized to
+ * 1/65536. Very small integral gains lose precision there, so keep the
+ * units of the loop such that kI * period stays above about 0.001.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "fixed.h"
+
+namespace art
+{
+	/**
+	 * @brief Number policy for Pid: plain float
+	 */
+	struct FloatMath
+	{
+		typedef float Value;
+
+		static Value make(float value) { return value; }
+		static float toFloat(Value value) { return value; }
+	};
+
+	/**
+	 * @brief Number policy for Pid: Q16.16 fixed point
+	 */
+	struct FixedMath
+	{
+		typedef Fixed Value;
+
+		static Value make(float value) { return Fixed(value); }
+		static float toFloat(Value value) { return value.toFloat(); }
+	};
+
+	/**
+	 * @brief Gains and limits of a Pid, in the units of the loop it closes
+	 *
+	 * output = kS * sign(setpoint) + kV * setpoint + kA * acceleration
+	 *        + kP * error + kI * integral(error) - kD * d(measurement)/dt
+	 */
+	struct PidGains
+	{
+		float kP;
+		float kI;            /**< per second */
+		float kD;            /**< seconds */
+		float kS;            /**< static friction, applied in the direction of the setpoint */
+		float kV;            /**< output per unit of setpoint */
+		float kA;            /**< output per unit of setpoint acceleration */
+		float integralLimit; /**< largest magnitude the integral term may build up to */
+		float outputLimit;   /**< largest magnitude of the output */
+	};
+
+	/**
+	 * @brief PID controller with feedforward, run at a fixed period
+	 *
+	 * The derivative acts on the measurement rather than the error, so a
+	 * step in the setpoint does not kick the output. Two things stop the
+	 * integral winding up: it is clamped to integralLimit, and it stops
+	 * growing while the output is saturated in the direction the error
+	 * pushes, so it does not have to unwind before the output can back off.
+	 *
+	 * @tparam Math FloatMath or FixedMath
+	 */
+	template <typename Math = FloatMath>
+	class Pid
+	{
+	public:
+		typedef typename Math::Value Value;
+
+		/**
+		 * @param gains gains in per-second units
+		 * @param periodMs how often update() will be called
+		 */
+		Pid(const PidGains &gains, uint32_t periodMs)
+			: m_kP(Math::make(gains.kP)), m_kI(Math::make(gains.kI * (float)periodMs * 0.001f)),
+			  m_kD(Math::make(gains.kD / ((float)periodMs * 0.001f))), m_kS(Math::make(gains.kS)),
+			  m_kV(Math::make(gains.kV)), m_kA(Math::make(gains.kA)),
+			  m_integralLimit(Math::make(gains.integralLimit)), m_outputLimit(Math::make(gains.outputLimit)),
+			  m_integral(), m_lastMeasurement(), m_primed(false)
+		{
+		}
+
+		/** @brief Forgets the integral and the previous measurement */
+		void reset()
+		{
+			m_integral = Value();
+			m_primed = false;
+		}
+
+		/**
+		 * @brief Runs one period of the loop
+		 *
+		 * @param setpoint where the loop should be
+		 * @param measurement where it is
+		 * @param acceleration rate of change of the setpoint, for kA
+		 * @return the clamped output
+		 */
+		Value update(Value setpoint, Value measurement, Value acceleration = Value())
+		{
+			const Value zero = Value();
+			Value error = setpoint - measurement;
+			Value integral = clamp(m_integral + m_kI * error, m_integralLimit);
+
+			Value derivative = zero;
+			if (m_primed)
+			{
+				derivative = m_kD * (measurement - m_lastMeasurement);
+			}
+			m_lastMeasurement = measurement;
+			m_primed = true;
+
+			Value friction = setpoint > zero ? m_kS : (setpoint < zero ? -m_kS : zero);
+			Value output = friction + m_kV * setpoint + m_kA * acceleration + m_kP * error + integral - derivative;
+			Value limited = clamp(output, m_outputLimit);
+			if (limited == output || (output > zero) != (error > zero))
+			{
+				m_integral = integral;
+			}
+			return limited;
+		}
+
+		/** @brief The integral term as it stands, for logging */
+		Value integral() const { return m_integral; }
+
+	private:
+		static Value clamp(Value value, Value limit)
+		{
+			return value > limit ? limit : (value < -limit ? -limit : value);
+		}
+
+		Value m_kP;
+		Value m_kI; /**< kI * period */
+		Value m_kD; /**< kD / period */
+		Value m_kS;
+		Value m_kV;
+		Value m_kA;
+		Value m_integralLimit;
+		Value m_outputLimit;
+
+		Value m_integral;
+		Value m_lastMeasurement;
+		bool m_primed;
+	};
+} // namespace art
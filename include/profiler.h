@@ -0,0 +1,148 @@
+/**
+ * @file profiler.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the section profiler used to find where loop time
+ * goes
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Put PROFILE_SCOPE("name") at the top of any block to time it. Each time the
+ * block runs, its duration in nanoseconds is added to a fixed table entry for
+ * that name: count, min, max, total and a histogram from which the p99 is
+ * read. Nothing is allocated and nothing is printed from the timed code.
+ *
+ * On the brain durations come from the microsecond timer, so they are whole
+ * microseconds. The host simulator (ART_SIM) uses the desktop's own clock
+ * instead, because its virtual clock does not move while code runs.
+ *
+ * Markers only exist in builds made with `make PROFILE=1`, which defines
+ * ART_ENABLE_PROFILER. Without it PROFILE_SCOPE expands to nothing, the
+ * tables are not compiled in, and the reporting functions do nothing, so the
+ * markers can be left in the code permanently.
+ *
+ * A section keeps one set of counters, so time each name from one task only.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ART_SIM
+#include <chrono>
+#endif
+
+#include "vex.h"
+
+#include "scheduler.h"
+#include "telemetry.h"
+
+namespace art
+{
+	namespace profiler
+	{
+		/** @brief Most distinct section names that can be registered */
+		const size_t kMaxSections = 16;
+
+		/** @brief Longest section name kept, longer names are truncated */
+		const size_t kNameLength = 12;
+
+		/**
+		 * @brief Aggregated timings of one section, all in nanoseconds
+		 */
+		struct SectionStats
+		{
+			const char *name;
+			uint32_t count;
+			uint32_t minNs;
+			uint32_t avgNs;
+			uint32_t maxNs;
+			uint32_t p99Ns; /**< upper bound of the histogram bin, within 1/8 */
+		};
+
+		/** @brief The clock sections are timed with, in nanoseconds */
+		inline uint64_t clockNs()
+		{
+#ifdef ART_SIM
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+					   std::chrono::steady_clock::now().time_since_epoch())
+				.count();
+#else
+			return timeUs() * 1000;
+#endif
+		}
+
+		struct Section;
+
+		/**
+		 * @brief Finds or registers the section with a name
+		 *
+		 * Called once per marker, the first time it runs. Thread-safe.
+		 *
+		 * @return the section, or NULL if the table is full
+		 */
+		Section *section(const char *name);
+
+		/** @brief Adds one timing to a section */
+		void record(Section *section, uint32_t elapsedNs);
+
+		/** @brief Number of sections registered so far */
+		size_t count();
+
+		/** @brief Aggregates of the section at an index, below count() */
+		SectionStats stats(size_t index);
+
+		/** @brief Clears every section's timings, keeping the names */
+		void reset();
+
+		/**
+		 * @brief Draws a table of every section on a Brain screen
+		 *
+		 * Times are shown in microseconds, one 15 pixel row per section plus
+		 * a heading, with the table's top left corner at x, y. Only call it from the task that owns the screen,
+		 * normally from a CustomWidget.
+		 */
+		void report(vex::brain::lcd &screen, int x, int y);
+
+		/** @brief Writes one kTelemetryProfile frame per section */
+		void dump(Telemetry &log);
+	} // namespace profiler
+
+	/**
+	 * @brief Times its own lifetime into a profiler section
+	 *
+	 * Use it through PROFILE_SCOPE rather than directly.
+	 */
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(profiler::Section *section) : m_section(section), m_startNs(profiler::clockNs()) {}
+		~ProfileScope() { profiler::record(m_section, (uint32_t)(profiler::clockNs() - m_startNs)); }
+
+	private:
+		ProfileScope(const ProfileScope &);
+		ProfileScope &operator=(const ProfileScope &);
+
+		profiler::Section *m_section;
+		uint64_t m_startNs;
+	};
+} // namespace art
+
+#define ART_PROFILE_JOIN2(a, b) a##b
+#define ART_PROFILE_JOIN(a, b) ART_PROFILE_JOIN2(a, b)
+
+/**
+ * @brief Times the rest of the enclosing block as the section `name`
+ *
+ * `name` must be a string that lives forever, normally a literal.
+ */
+#ifdef ART_ENABLE_PROFILER
+#define PROFILE_SCOPE(name)                                                                                 \
+	static art::profiler::Section *const ART_PROFILE_JOIN(s_profileSection, __LINE__) =                 \
+		art::profiler::section(name);                                                                   \
+	art::ProfileScope ART_PROFILE_JOIN(profileScope, __LINE__)(ART_PROFILE_JOIN(s_profileSection, __LINE__))
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file replan.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the Replanner, which watches the path ahead of a
+ * PurePursuit follower and drives around obstacles the FieldMap has found
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Routes are planned around the fixed field before the match, but not
+ * around the other robot parked on one. Each tick the Replanner steps along
+ * the next checkDistance inches of the path, looking at the FieldMap's
+ * detected layer between every pair of points. The fixed layer is left out
+ * on purpose: routes go right up to goals and walls, and the driver who
+ * planned them knew that.
+ *
+ * When the path is blocked, only the blocked stretch is replanned. A detour
+ * leaves the path lead inches before the block and rejoins it lead inches
+ * after, passing a waypoint set off to one side of the block's middle, at
+ * offsetStep, then twice that, and so on up to maxOffset, first to the left
+ * then to the right. Each try is a three-waypoint Trajectory joining the
+ * path at the speeds it already has there; the first that clears both
+ * layers is spliced in, and the follower carries on along it. The rest of
+ * the path is kept as it was, with the same distances along it, so actions
+ * placed along a route still happen where they were meant to.
+ *
+ * A block that runs on to the end of the path is handled the same way, with
+ * the detour finishing at the path's own end instead of rejoining it.
+ *
+ * A replan never takes more than the tries above, each a short trajectory,
+ * so it fits in one 10 ms tick with room to spare. If none of them is clear,
+ * or the end of the path is itself blocked, the follower is left as it was
+ * and no new attempt is made until the map changes; what the robot does
+ * meanwhile is up to the caller. A detour that did not fit in its scratch
+ * Arena is reported as kPathNoMemory instead, as the way round may well have
+ * been clear.
+ *
+ * Detours are built in two scratch Arenas taken from RobotArena at startup:
+ * one holds the path being followed while the next replan uses the other.
+ * Each is sized for a copy of the longest route plus scratchBytes for the
+ * detour itself, which is planned as a trajectory and then copied in too.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "fieldMap.h"
+#include "follower.h"
+#include "trajectory.h"
+
+namespace art
+{
+	/**
+	 * @brief Tuning of a Replanner
+	 */
+	struct ReplanConfig
+	{
+		float checkDistance; /**< inches of path ahead of the robot checked every tick */
+		float lead;          /**< inches before and after a block the detour leaves and rejoins the path */
+		float offsetStep;    /**< inches between the sideways offsets tried */
+		float maxOffset;     /**< furthest a detour's middle is put from the path, inches */
+		float minVelocity;   /**< in/s a detour may plan for, even on a slow part of a route */
+		size_t scratchBytes; /**< room in each scratch Arena for a detour, besides a copy of the longest path */
+	};
+
+	/**
+	 * @brief What Replanner::update() did
+	 */
+	enum ReplanResult
+	{
+		kPathClear,      /**< nothing in the way */
+		kPathReplanned,  /**< the follower was given a detour */
+		kPathBlocked,    /**< in the way, and no detour was found */
+		kPathNoMemory,   /**< in the way, and a detour did not fit in the scratch Arena */
+	};
+
+	/**
+	 * @brief Reroutes a PurePursuit follower around detected obstacles
+	 *
+	 * Used from the autonomous loop only, like the FieldMap it reads.
+	 */
+	class Replanner
+	{
+	public:
+		Replanner(const FieldMap &map, const ReplanConfig &config);
+
+		/**
+		 * @brief Takes the scratch Arenas from arena and sets the limits detours are planned with
+		 *
+		 * Call once, from the startup stage that allocates the routes, after
+		 * they have all been loaded.
+		 *
+		 * @param longestPath points in the longest path that will be followed
+		 * @return false if arena cannot hold them; update() then never replans
+		 */
+		bool reserve(Arena &arena, const TrajectoryConstraints &constraints, size_t longestPath);
+
+		/**
+		 * @brief Checks the path ahead of the follower, and replans it if it is blocked
+		 *
+		 * Call every tick before follower.update(). On kPathReplanned the
+		 * follower has been restarted on the new path.
+		 */
+		ReplanResult update(PurePursuit &follower);
+
+		/** @brief Detours handed to a follower */
+		uint32_t replans() const { return m_replans; }
+
+		/** @brief Blocks no detour could be found around */
+		uint32_t failures() const { return m_failures; }
+
+		/** @brief Blocks given up on because a detour did not fit in its scratch Arena */
+		uint32_t outOfMemory() const { return m_outOfMemory; }
+
+		/** @brief Longest a replan took, us */
+		uint32_t worstUs() const { return m_worstUs; }
+
+	private:
+		ReplanResult plan(PurePursuit &follower, size_t from, size_t blockStart, size_t blockEnd);
+		bool tryDetour(const Path &path, size_t from, size_t leave, size_t rejoin, float x, float y,
+					   float middleHeading, Arena &arena, Path &out);
+
+		const FieldMap &m_map;
+		ReplanConfig m_config;
+		TrajectoryConstraints m_constraints;
+		Arena *m_scratch[2];
+		int m_next;                /**< which scratch Arena the next detour is built in */
+
+		const PathPoint *m_failedPath; /**< path a detour could not be found for */
+		uint32_t m_failedRevision;     /**< map revision when that happened */
+		ReplanResult m_failedResult;   /**< and why */
+
+		uint32_t m_replans;
+		uint32_t m_failures;
+		uint32_t m_outOfMemory;
+		uint32_t m_worstUs;
+
+		Replanner(const Replanner &);
+		Replanner &operator=(const Replanner &);
+	};
+} // namespace art
@@ -17,3 +17,284 @@
 #pragma once
 
 #include "vex.h"
+
+#include "assist.h"
+#include "deviceTable.h"
+#include "fieldMap.h"
+#include "fusion.h"
+#include "input.h"
+#include "odometry.h"
+#include "outputLimiter.h"
+#include "seqlock.h"
+#include "velocity.h"
+
+/**
+ * @brief Index of every motor in Motors and in the DeviceSnapshot arrays
+ */
+enum MotorId
+{
+	kLeftFront,
+	kLeftMiddle,
+	kLeftBack,
+	kRightFront,
+	kRightMiddle,
+	kRightBack,
+	kIntake,
+	kMotorCount
+};
+
+/**
+ * @brief Bitmasks for the groups in RobotLayout, combinable with |
+ */
+enum MotorGroup
+{
+	kLeftDrive = 1 << 0,
+	kRightDrive = 1 << 1,
+	kDrive = kLeftDrive | kRightDrive,
+	kIntakeMotors = 1 << 2,
+};
+
+/**
+ * @brief Index of every distance sensor in RobotLayout and DeviceSnapshot
+ */
+enum DistanceId
+{
+	kLeftDistance,
+	kRightDistance,
+	kBackDistance,
+	kFrontDistance,
+	kDistanceCount
+};
+
+/**
+ * @brief Where every device is plugged in, fixed at compile time
+ *
+ * kMotors is in MotorId order. Adding a device here is the only change needed
+ * for Motors and the port checks to pick it up.
+ */
+struct RobotLayout
+{
+	static constexpr art::MotorSpec kMotors[kMotorCount] = {
+		{PORT1, vex::gearSetting::ratio6_1, false, kLeftDrive, "left front"},
+		{PORT2, vex::gearSetting::ratio6_1, false, kLeftDrive, "left middle"},
+		{PORT3, vex::gearSetting::ratio6_1, false, kLeftDrive, "left back"},
+		{PORT4, vex::gearSetting::ratio6_1, true, kRightDrive, "right front"},
+		{PORT5, vex::gearSetting::ratio6_1, true, kRightDrive, "right middle"},
+		{PORT6, vex::gearSetting::ratio6_1, true, kRightDrive, "right back"},
+		{PORT7, vex::gearSetting::ratio18_1, false, kIntakeMotors, "intake"},
+	};
+
+	static constexpr int32_t kImuPort = PORT10;
+	static constexpr int32_t kForwardTrackerPort = PORT11;
+	static constexpr int32_t kSidewaysTrackerPort = PORT12;
+
+	/** @brief Distance sensors, in DistanceId order */
+	static constexpr int32_t kDistancePorts[kDistanceCount] = {PORT13, PORT14, PORT15, PORT16};
+
+	/** @brief Where each distance sensor sits and points, in DistanceId order */
+	static constexpr art::RangeMount kDistanceMounts[kDistanceCount] = {
+		{0.0f, 6.0f, 1.5708f},   // left side, facing left
+		{0.0f, -6.0f, -1.5708f}, // right side, facing right
+		{-7.0f, 0.0f, 3.1416f},  // back, facing backwards
+		{8.0f, 0.0f, 0.0f},      // front, facing forwards
+	};
+
+	static constexpr int32_t kSensorPorts[] = {
+		kImuPort,
+		kForwardTrackerPort,
+		kSidewaysTrackerPort,
+		kDistancePorts[kLeftDistance],
+		kDistancePorts[kRightDistance],
+		kDistancePorts[kBackDistance],
+		kDistancePorts[kFrontDistance],
+	};
+};
+
+static_assert(art::sensorPortsDistinct(RobotLayout::kSensorPorts,
+									   sizeof(RobotLayout::kSensorPorts) / sizeof(RobotLayout::kSensorPorts[0]),
+									   RobotLayout::kMotors, kMotorCount),
+			  "every sensor needs its own port between PORT1 and PORT21, not shared with a motor");
+
+/**
+ * @brief The fixed elements of the field, drawn into kGrid by the compiler
+ *
+ * Positions are in the same field coordinates as the odometry, in inches
+ * from the corner the robot starts in: the two goals anchored in the far
+ * corners, 12 inches across. kClearance is half the robot's 18 inch
+ * width plus 3 inches for following error; the robot's corners swing wider
+ * than that in turns, so routes should not rely on cutting closer.
+ */
+struct FieldLayout
+{
+	static constexpr art::FieldElement kElements[] = {
+		{"far goal", 126.0f, 126.0f, 126.0f, 126.0f, 6.0f},
+		{"right goal", 126.0f, 18.0f, 126.0f, 18.0f, 6.0f},
+	};
+
+	static constexpr float kClearance = 12.0f;
+
+	static constexpr art::FieldGrid kGrid{kElements, sizeof(kElements) / sizeof(kElements[0]), kClearance};
+};
+
+static_assert(!FieldLayout::kGrid.occupiedAt(24.0f, 24.0f), "the starting tile must be clear of the field");
+
+extern art::Input DriverInput;          /**< Controller1, sampled once per tick */
+
+extern art::MotorTable<RobotLayout> Motors; /**< every motor, indexed by MotorId */
+
+extern vex::motor &LeftFront;           /**< front motor on the left side of the drive */
+extern vex::motor &LeftMiddle;          /**< middle motor on the left side of the drive */
+extern vex::motor &LeftBack;            /**< back motor on the left side of the drive */
+extern vex::motor &RightFront;          /**< front motor on the right side of the drive */
+extern vex::motor &RightMiddle;         /**< middle motor on the right side of the drive */
+extern vex::motor &RightBack;           /**< back motor on the right side of the drive */
+extern vex::motor &Intake;              /**< intake roller motor */
+
+/**
+ * @brief Physical layout of the drivetrain and its open-loop feedforward
+ *
+ * The feedforward turns a wheel speed into a motor voltage:
+ * volts = kS * sign(v) + kV * v + kA * a, with v in in/s and a in in/s^2.
+ */
+struct DrivetrainConfig
+{
+	float trackWidth;    /**< distance between the left and right wheels, inches */
+	float wheelDiameter; /**< inches */
+	float gearRatio;     /**< wheel turns per motor turn */
+	float maxVelocity;   /**< fastest wheel speed trajectories may plan for, in/s */
+	float maxAccel;      /**< in/s^2 */
+	float kS;            /**< volts to overcome static friction */
+	float kV;            /**< volts per in/s */
+	float kA;            /**< volts per in/s^2 */
+};
+
+/**
+ * @brief The drivetrain's feedforward model, measured once
+ *
+ * DriveConfig and the drive speed loop's WheelSpeedGains are both built from
+ * these, so retuning the model changes both together.
+ */
+struct DriveFeedforward
+{
+	static constexpr float kS = 0.5f;  /**< volts to overcome static friction */
+	static constexpr float kV = 0.15f; /**< volts per in/s */
+	static constexpr float kA = 0.02f; /**< volts per in/s^2 */
+};
+
+extern const DrivetrainConfig DriveConfig; /**< dimensions and feedforward of the drivetrain */
+
+/**
+ * @brief Requests a voltage for each side of the drivetrain
+ *
+ * Like setVoltage, the request only reaches the motors at the next
+ * applyOutputs.
+ *
+ * @param left volts for the left motors, -12 to 12
+ * @param right volts for the right motors, -12 to 12
+ */
+void driveVoltage(float left, float right);
+
+/**
+ * @brief Requests a voltage for one motor
+ *
+ * Nothing should call vex::motor::spin directly: every command goes through
+ * here so that Limiter sees it. Call it from the control loop's task only;
+ * the drive motors also from DriveVelocity's task, while it is active.
+ *
+ * @param volts -12 to 12
+ */
+void setVoltage(MotorId motor, float volts);
+
+/**
+ * @brief Passes this tick's requests through Limiter and sends the results
+ * to the motors
+ *
+ * Run it once per control tick, after every job that sets a voltage.
+ *
+ * @param periodMs time since the previous call
+ */
+void applyOutputs(uint32_t periodMs);
+
+extern art::OutputLimiter Limiter; /**< thermal, current and slew limits on every motor */
+
+extern vex::inertial Imu;               /**< inertial sensor providing the robot's heading */
+extern vex::rotation ForwardTracker;    /**< tracking wheel parallel to the direction of travel */
+extern vex::rotation SidewaysTracker;   /**< tracking wheel perpendicular to the direction of travel */
+
+extern vex::distance LeftDistance;      /**< distance sensor facing left */
+extern vex::distance RightDistance;     /**< distance sensor facing right */
+extern vex::distance BackDistance;      /**< distance sensor facing backwards */
+extern vex::distance FrontDistance;     /**< distance sensor facing forwards, mostly for obstacles */
+
+extern const art::OdometryConfig OdomConfig; /**< where the tracking wheels are mounted */
+extern const art::FusionConfig FusionSettings; /**< noise model of the odometry's PoseFilter */
+extern const art::ObstacleConfig ObstacleSettings; /**< how distance readings become obstacles on the FieldMap */
+extern const art::AssistConfig AssistSettings; /**< timing and gains of the driver assist */
+extern art::Odometry Odom;                   /**< background pose estimate built from the trackers and Imu */
+
+extern const art::PidGains WheelSpeedGains; /**< drive speed loop, in in/s and volts */
+extern art::VelocityController DriveVelocity; /**< closed-loop wheel speeds, on a task of its own */
+
+/**
+ * @brief VelocityController::MeasureFn reading each side's wheel speed, in/s,
+ * from the motors' filtered speeds in Devices
+ */
+void measureDriveSpeed(float &left, float &right, void *context);
+
+/**
+ * @brief VelocityController::OutputFn requesting each side's voltage
+ */
+void outputDriveVoltage(float left, float right, void *context);
+
+/**
+ * @brief Odometry::CorrectFn that corrects the pose from the distance sensors
+ *
+ * Uses the readings in Devices, at most once every kWallResetMs, and only
+ * when a new sample has been taken since. Register it before Odom.start().
+ */
+void correctFromWalls(art::PoseFilter &filter, void *context);
+
+/**
+ * @brief One sample of every declared device, taken at the same moment
+ *
+ * Each quantity is stored as its own array indexed by MotorId, so code that
+ * loops over one quantity for every motor (like summing drive current) walks
+ * contiguous memory. Units are degrees, rpm, amps, volts and degrees Celsius.
+ */
+struct DeviceSnapshot
+{
+	uint64_t timeUs;                      /**< brain time the sample was taken */
+	uint32_t sequence;                    /**< increments by one every sample */
+
+	float motorPosition[kMotorCount];     /**< degrees */
+	float motorVelocity[kMotorCount];     /**< rpm */
+	float motorCurrent[kMotorCount];      /**< amps */
+	float motorVoltage[kMotorCount];      /**< volts */
+	float motorTemperature[kMotorCount];  /**< degrees Celsius */
+	float motorSpeed[kMotorCount];        /**< rpm, motorVelocity with the encoder noise filtered out */
+	float motorLoad[kMotorCount];         /**< amps, motorCurrent low-passed over about 100 ms */
+
+	float imuRotation;                    /**< degrees, clockwise positive */
+	float forwardTracker;                 /**< degrees */
+	float sidewaysTracker;                /**< degrees */
+	float distance[kDistanceCount];       /**< inches to the nearest object, negative if nothing is in range */
+
+	float batteryVoltage;                 /**< volts */
+	float batteryCurrent;                 /**< amps */
+};
+
+/**
+ * @brief The latest DeviceSnapshot
+ *
+ * Read it once at the start of a tick with Devices.read() and use that copy
+ * for the rest of the tick, so every subsystem works from the same sample.
+ */
+extern art::Seqlock<DeviceSnapshot> Devices;
+
+/**
+ * @brief Reads every device once and publishes the result to Devices
+ *
+ * Call this once per control tick, before anything that uses the devices.
+ * It should only ever be called from one task at a time.
+ */
+void sampleDevices();
@@ -0,0 +1,189 @@
+/**
+ * @file routes.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the RouteBook, which loads autonomous routes from a
+ * binary file on the SD card
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Each autonomous variant is a route: a list of waypoints plus the actions to
+ * take along the way (start the intake 20 inches in, score for 750 ms at the
+ * end...). Keeping them on the SD card means switching variants is a matter
+ * of copying a file, not rebuilding the program.
+ *
+ * The file is read once, in pre_auton, straight into the Arena and checked
+ * from end to end. Its records are laid out so they can be used where they
+ * sit, without unpacking: names and actions point into the loaded image. The
+ * only work done at load time is generating each route's trajectory and path.
+ * Once load() returns, picking a route is an index into an array and nothing
+ * is ever parsed during autonomous.
+ *
+ * The layout of the file is described in @ref route_format.
+ */
+
+/**
+ * @page route_format Route file format
+ *
+ * A route file holds up to RouteBook::kMaxRoutes routes. All multi-byte values
+ * are little-endian and every record starts on an even offset, so the file
+ * can be used in place on the Brain. Positions and headings use the same
+ * units as the telemetry and trajectory tables.
+ *
+ * @section route_header Header, 16 bytes
+ *
+ * | Offset | Size | Field      | Meaning                                      |
+ * |--------|------|------------|----------------------------------------------|
+ * | 0      | 4    | magic      | char[4] "ARTR"                               |
+ * | 4      | 2    | version    | uint16 format version, currently 1           |
+ * | 6      | 2    | routeCount | uint16 number of routes that follow, 1 or more |
+ * | 8      | 4    | size       | uint32 length of the whole file in bytes     |
+ * | 12     | 4    | checksum   | uint32 32-bit FNV-1a of bytes 16 to size     |
+ *
+ * @section route_record Route, 24 bytes followed by its waypoints and actions
+ *
+ * | Offset | Size | Field         | Meaning                                     |
+ * |--------|------|---------------|---------------------------------------------|
+ * | 0      | 16   | name          | char[16], zero padded, at least one zero    |
+ * | 16     | 2    | maxVelocity   | uint16 in 1/16 in/s, 0 for the robot's own  |
+ * | 18     | 2    | maxAccel      | uint16 in 1/16 in/s^2, 0 for the robot's own |
+ * | 20     | 1    | waypointCount | uint8, 2 to RouteBook::kMaxWaypoints        |
+ * | 21     | 1    | actionCount   | uint8                                       |
+ * | 22     | 1    | flags         | bit 0 set to drive the route backwards      |
+ * | 23     | 1    | reserved      | 0                                           |
+ *
+ * The route record is followed by waypointCount waypoints of 6 bytes: int16 x
+ * and y in 1/64 inch, and uint16 heading as a binary angle (65536 per turn,
+ * counter-clockwise from +x). The robot is placed on the first waypoint at the
+ * start of autonomous.
+ *
+ * Then come actionCount RouteActions of 8 bytes: uint8 type, uint8 reserved,
+ * int16 value, uint16 at and uint16 durationMs. at is the distance along the
+ * path, in 1/16 inch, at which the action is applied, or kRouteAtEnd (0xFFFF)
+ * to apply it once the robot has stopped at the last waypoint. Actions are
+ * sorted by at. Those at the end run one after another, each lasting
+ * durationMs. The meaning of type and value is up to the robot program
+ * (see RouteActionType).
+ *
+ * The next route record starts right after the last action.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "follower.h"
+#include "odometry.h"
+#include "trajectory.h"
+
+namespace art
+{
+	/** @brief RouteAction::at of an action applied once the path is finished */
+	const uint16_t kRouteAtEnd = 0xFFFF;
+
+	/**
+	 * @brief Action types used by this robot's routes
+	 *
+	 * The loader does not interpret them; types it does not know are kept, so
+	 * an older program can still run a newer file and skip what it cannot do.
+	 */
+	enum RouteActionType
+	{
+		kRouteIntake = 1, /**< run the intake at value mV, 0 to stop */
+		kRouteWait = 2,   /**< nothing, only useful at the end for its duration */
+	};
+
+	/**
+	 * @brief One action of a route, exactly as stored in the file
+	 */
+	struct RouteAction
+	{
+		uint8_t type;
+		uint8_t reserved;
+		int16_t value;
+		uint16_t at;         /**< 1/16 inch along the path, or kRouteAtEnd */
+		uint16_t durationMs; /**< how long an action at the end lasts */
+
+		/** @brief Distance along the path in inches */
+		float distance() const { return at * (1.0f / 16.0f); }
+	};
+
+	/**
+	 * @brief A route ready to run: its path, where it starts and what to do
+	 */
+	struct Route
+	{
+		const char *name;           /**< points into the loaded file */
+		Pose start;                 /**< the first waypoint */
+		Trajectory trajectory;      /**< timed version of the route */
+		Path path;                  /**< trajectory resampled every inch */
+		const RouteAction *actions; /**< points into the loaded file */
+		size_t actionCount;
+	};
+
+	/**
+	 * @brief Why RouteBook::load() gave up
+	 */
+	enum RouteError
+	{
+		kRouteOk,
+		kRouteNoCard,      /**< no SD card inserted */
+		kRouteNoFile,      /**< the file does not exist or is empty */
+		kRouteTooLarge,    /**< bigger than RouteBook::kMaxFileBytes */
+		kRouteNoMemory,    /**< the Arena ran out */
+		kRouteBadHeader,   /**< wrong magic, version or size */
+		kRouteBadChecksum, /**< the file is damaged */
+		kRouteBadRoute,    /**< a route record is out of range */
+	};
+
+	/** @brief Short description of an error, for MatchLog */
+	const char *routeErrorText(RouteError error);
+
+	/**
+	 * @brief The routes loaded from one file
+	 *
+	 * Either every route in the file is loaded or none is: a file that fails
+	 * any check leaves the book empty, so the robot falls back to the routines
+	 * compiled into the program instead of running half a route.
+	 */
+	class RouteBook
+	{
+	public:
+		/** @brief Most routes in one file */
+		static const size_t kMaxRoutes = 8;
+
+		/** @brief Most waypoints in one route */
+		static const size_t kMaxWaypoints = 32;
+
+		/** @brief Largest file that will be read */
+		static const size_t kMaxFileBytes = 16 * 1024;
+
+		RouteBook();
+
+		/**
+		 * @brief Reads, checks and prepares every route in a file
+		 *
+		 * Call once, from pre_auton. The file image, trajectories and paths
+		 * are all kept in arena; on failure the arena is rewound to where it
+		 * was.
+		 *
+		 * @param fileName file on the SD card
+		 * @param constraints limits for routes that do not set their own
+		 * @param arena where everything is stored
+		 */
+		RouteError load(const char *fileName, const TrajectoryConstraints &constraints, Arena &arena);
+
+		size_t size() const { return m_count; }
+		const Route &operator[](size_t i) const { return m_routes[i]; }
+
+	private:
+		Route m_routes[kMaxRoutes];
+		size_t m_count;
+
+		RouteBook(const RouteBook &);
+		RouteBook &operator=(const RouteBook &);
+	};
+} // namespace art
@@ -0,0 +1,184 @@
+/**
+ * @file routine.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring Routine, a Command written as straight-line code
+ * that picks up where it left off every tick
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A Command that does several things in order has to keep its own state
+ * machine: which step it is on, when the current wait ends, whether the drive
+ * is still going. A Routine lets the same thing be written the way a
+ * blocking autonomous would be, but without blocking:
+ *
+ * @code
+ * bool run()
+ * {
+ *     ROUTINE_BEGIN();
+ *     setVoltage(kIntake, 12.0f);
+ *     ROUTINE_AWAIT(DriveRoute);
+ *     ROUTINE_WAIT_MS(750);
+ *     ROUTINE_END();
+ * }
+ * @endcode
+ *
+ * Each wait saves the line it is on and returns; the next update() jumps
+ * straight back to it through a switch, as protothreads do. Nothing is saved
+ * but that line number, so a Routine costs a couple of dozen bytes where a
+ * vex::task would need a stack of its own, and any number of them run
+ * together on one task under a CommandRunner or inside a Parallel, at the
+ * price of one virtual call and one switch a tick each.
+ *
+ * That comes with three rules for the body of run():
+ *
+ * - Local variables do not survive a wait. Anything needed afterwards, a loop
+ *   counter say, must be a member of the Routine.
+ * - The body must not use switch itself around a wait, since the wait's case
+ *   label would then belong to the wrong switch.
+ * - Only one of the macros per line, as they tell waits apart by __LINE__.
+ *
+ * The compiler catches most slips: jumping over an initialised local into a
+ * later wait is an error.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "command.h"
+
+namespace art
+{
+	/**
+	 * @brief A Command whose run() is a resumable sequence of steps
+	 *
+	 * run() is called every tick and returns true once it reaches
+	 * ROUTINE_END(). A child Command awaited with ROUTINE_AWAIT() is started,
+	 * updated and ended as part of the Routine, and interrupted with it.
+	 */
+	class Routine : public Command
+	{
+	public:
+		Routine();
+
+		void start();
+		bool update();
+		void end(bool interrupted);
+
+		/** @brief True if the last ROUTINE_WAIT_UNTIL() ended on its timeout */
+		bool timedOut() const { return m_timedOut; }
+
+		/** @brief True if the last run ended at ROUTINE_FAIL() */
+		bool failed() const { return m_failed; }
+
+	protected:
+		/** @brief The body, between ROUTINE_BEGIN() and ROUTINE_END() */
+		virtual bool run() = 0;
+
+		/**
+		 * @brief Called when the Routine ends, after any awaited command has
+		 * been ended, to switch off whatever the body left running
+		 */
+		virtual void stop(bool interrupted) {}
+
+		/**
+		 * @brief Runs a child command for one tick: started on the first call,
+		 * ended once it finishes
+		 *
+		 * @return true in the tick the child finishes
+		 */
+		bool await(Command &child);
+
+		/** @brief timeUs() when a wait of timeoutMs from now ends */
+		static uint64_t deadline(uint32_t timeoutMs);
+
+		int m_resume;      /**< line of the wait to resume at, 0 to start from the top */
+		uint64_t m_wakeUs; /**< when the current timed wait ends */
+		Command *m_child;  /**< command being awaited, or NULL */
+		bool m_timedOut;
+		bool m_failed;
+	};
+} // namespace art
+
+/** @brief Opens the body of Routine::run() */
+#define ROUTINE_BEGIN() \
+	switch (m_resume)   \
+	{                   \
+	case 0:;
+
+/** @brief Closes the body of Routine::run(); the Routine is then finished */
+#define ROUTINE_END() \
+	}                 \
+	return true
+
+/** @brief Ends the Routine here, as failed() */
+#define ROUTINE_FAIL()   \
+	do                   \
+	{                    \
+		m_failed = true; \
+		return true;     \
+	} while (0)
+
+/** @brief Gives up the rest of this tick and carries on from here in the next */
+#define ROUTINE_YIELD()        \
+	do                         \
+	{                          \
+		m_resume = __LINE__;   \
+		return false;          \
+	case __LINE__:;            \
+	} while (0)
+
+/**
+ * @brief Waits until condition is true or timeoutMs (or kForever) has passed;
+ * timedOut() says which
+ *
+ * condition is checked straight away, and then once a tick.
+ */
+#define ROUTINE_WAIT_UNTIL(condition, timeoutMs)     \
+	do                                               \
+	{                                                \
+		m_wakeUs = deadline(timeoutMs);              \
+		m_resume = __LINE__;                         \
+		if (false)                                   \
+		{                                            \
+		case __LINE__:;                              \
+		}                                            \
+		m_timedOut = !(condition);                   \
+		if (m_timedOut && art::timeUs() < m_wakeUs)  \
+		{                                            \
+			return false;                            \
+		}                                            \
+	} while (0)
+
+/** @brief Waits for ms milliseconds, measured from here */
+#define ROUTINE_WAIT_MS(ms)                  \
+	do                                       \
+	{                                        \
+		m_wakeUs = deadline(ms);             \
+		m_resume = __LINE__;                 \
+		if (false)                           \
+		{                                    \
+		case __LINE__:;                      \
+		}                                    \
+		if (art::timeUs() < m_wakeUs)        \
+		{                                    \
+			return false;                    \
+		}                                    \
+	} while (0)
+
+/** @brief Runs a Command until it finishes, starting in this tick */
+#define ROUTINE_AWAIT(command)   \
+	do                           \
+	{                            \
+		m_resume = __LINE__;     \
+		if (false)               \
+		{                        \
+		case __LINE__:;          \
+		}                        \
+		if (!await(command))     \
+		{                        \
+			return false;        \
+		}                        \
+	} while (0)
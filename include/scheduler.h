@@ -0,0 +1,183 @@
+/**
+ * @file scheduler.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the fixed-rate Scheduler used to run periodic jobs
+ * such as the drive and UI updates
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A plain `while(1) { ...; wait(20, msec); }` loop runs every 20 ms *plus*
+ * however long the loop body took, so its real period drifts as code is added.
+ * The Scheduler instead releases each job against an absolute deadline read
+ * from the brain's timer: the next release is always the previous release plus
+ * the period, no matter how long the job itself ran. It also keeps track of
+ * overruns and the worst-case times, so timing problems show up before they
+ * show up on the field.
+ *
+ * A Scheduler can also check into a Watchdog once per pass, and jobs that can
+ * wait can be slowed down while the CPU is short of time.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "watchdog.h"
+
+namespace art
+{
+	/**
+	 * @brief Signature of a job run by the Scheduler
+	 *
+	 * The context pointer is whatever was passed to Scheduler::add(), so one
+	 * function can serve several objects.
+	 */
+	typedef void (*PeriodicFn)(void *context);
+
+	/**
+	 * @brief Timing statistics of a single job
+	 *
+	 * Every time is in microseconds. A job overruns when it starts a full
+	 * period or more after its release time; the releases it missed are
+	 * counted in skipped and are not run late.
+	 */
+	struct TaskStats
+	{
+		uint32_t runs;           /**< number of times the job has run */
+		uint32_t overruns;       /**< number of late starts */
+		uint32_t skipped;        /**< releases dropped because of overruns */
+		uint32_t lastExecUs;     /**< duration of the latest run */
+		uint32_t worstExecUs;    /**< longest run so far */
+		uint32_t worstLatencyUs; /**< longest delay between release and start */
+	};
+
+	/**
+	 * @brief Runs registered jobs at fixed rates against absolute deadlines
+	 *
+	 * Jobs are registered once (usually in pre_auton), then the owning task
+	 * calls start() followed by runOnce() in a loop. Each call sleeps until the
+	 * earliest pending release and runs every job that is due, in the order they
+	 * were added. Periods are whole milliseconds because that is the resolution
+	 * of the V5 task sleep; the deadlines themselves are tracked in
+	 * microseconds so rounding never accumulates into drift.
+	 */
+	class Scheduler
+	{
+	public:
+		/** @brief Maximum number of jobs per Scheduler */
+		static const int kMaxTasks = 8;
+
+		Scheduler();
+
+		/**
+		 * @brief Registers a periodic job
+		 *
+		 * @param name short label used in reports, must outlive the Scheduler
+		 * @param periodMs release period in milliseconds
+		 * @param fn function to run
+		 * @param context pointer handed to fn on every run
+		 * @return a handle for stats(), or -1 if the Scheduler is full or the
+		 * period is zero
+		 */
+		int add(const char *name, uint32_t periodMs, PeriodicFn fn, void *context = NULL);
+
+		/**
+		 * @brief Re-arms every job so its first release is now
+		 *
+		 * Call this right before entering the loop, since the scheduler may
+		 * have been sitting idle since the jobs were added.
+		 */
+		void start();
+
+		/**
+		 * @brief Sleeps until the next release, then runs every due job
+		 */
+		void runOnce();
+
+		/**
+		 * @brief Calls runOnce() forever
+		 */
+		void run();
+
+		/**
+		 * @brief Checks into watchdog once per pass that runs a job
+		 *
+		 * Call after every job is added: the watched period is the shortest
+		 * job period.
+		 *
+		 * @return false if there are no jobs or the watchdog is full
+		 */
+		bool watch(Watchdog &watchdog, const char *name, uint32_t timeoutMs, bool critical = true);
+
+		/** @brief Tells the watchdog this loop is stopping on purpose, until its next pass */
+		void pauseWatch() { m_watch.pause(); }
+
+		/**
+		 * @brief Runs a job factor times less often, 1 for its own period
+		 *
+		 * May be called from another task; it takes effect after the job's
+		 * next run.
+		 */
+		void setSlowdown(int handle, uint32_t factor);
+
+		/** @brief Clears all statistics without touching the deadlines */
+		void resetStats();
+
+		/** @brief Number of registered jobs */
+		int count() const { return m_count; }
+
+		/** @brief Name given to a job when it was added */
+		const char *name(int handle) const;
+
+		/** @brief Period of a job, in microseconds */
+		uint32_t periodUs(int handle) const;
+
+		/** @brief Timing statistics of a job */
+		const TaskStats &stats(int handle) const;
+
+		/** @brief Number of runOnce() passes that ran at least one job */
+		uint32_t loops() const { return m_loops; }
+
+		/** @brief Total overruns across every job */
+		uint32_t overruns() const;
+
+		/** @brief Longest time spent running the jobs of one pass */
+		uint32_t worstLoopUs() const { return m_worstLoopUs; }
+
+	private:
+		struct Entry
+		{
+			const char *name;
+			uint32_t basePeriodUs; /**< period given to add() */
+			uint32_t periodUs;
+			uint64_t releaseUs;
+			PeriodicFn fn;
+			void *context;
+			TaskStats stats;
+		};
+
+		Entry m_tasks[kMaxTasks];
+		int m_count;
+		uint32_t m_loops;
+		uint32_t m_worstLoopUs;
+		WatchHandle m_watch;
+	};
+
+	/**
+	 * @brief Current time of the brain's microsecond timer
+	 */
+	uint64_t timeUs();
+
+	/**
+	 * @brief Suspends the calling task until an absolute time
+	 *
+	 * The sleep is rounded up to whole milliseconds, so the task wakes at or
+	 * slightly after the deadline but never before it.
+	 *
+	 * @param deadlineUs time to wake up, as returned by timeUs()
+	 */
+	void sleepUntil(uint64_t deadlineUs);
+} // namespace art
@@ -0,0 +1,103 @@
+/**
+ * @file seqlock.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header defining Seqlock, a lock-free single-writer/multi-reader cell
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A Seqlock lets one task publish a small struct (like the robot's pose) that
+ * any number of other tasks can read without ever blocking the writer. The
+ * writer bumps a sequence counter to an odd value, copies the data in, then
+ * bumps it back to even. A reader copies the data out and only keeps the copy
+ * if the counter was even and unchanged on both sides of the copy, retrying
+ * otherwise. Readers never take a lock, so a slow reader can never hold up the
+ * writer.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace art
+{
+	/**
+	 * @brief Lock-free cell with one writer and any number of readers
+	 *
+	 * @tparam T a trivially copyable type; keep it small since readers copy
+	 * the whole value on every read
+	 */
+	template <typename T>
+	class Seqlock
+	{
+	public:
+		Seqlock() : m_sequence(0), m_value() {}
+
+		explicit Seqlock(const T &initial) : m_sequence(0), m_value(initial) {}
+
+		/**
+		 * @brief Publishes a new value
+		 *
+		 * Must only ever be called from a single task.
+		 */
+		void write(const T &value)
+		{
+			uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+			m_sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_value = value;
+			std::atomic_thread_fence(std::memory_order_release);
+			m_sequence.store(sequence + 2, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Attempts a single consistent read
+		 *
+		 * @param out receives the value, only valid when true is returned
+		 * @return false if a write was in progress and the copy may be torn
+		 */
+		bool tryRead(T &out) const
+		{
+			uint32_t before = m_sequence.load(std::memory_order_acquire);
+			if (before & 1u)
+			{
+				return false;
+			}
+			out = m_value;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return m_sequence.load(std::memory_order_relaxed) == before;
+		}
+
+		/**
+		 * @brief Reads the latest value, retrying until the copy is consistent
+		 *
+		 * A write only takes as long as copying T, so this almost never loops.
+		 */
+		T read() const
+		{
+			T out;
+			while (!tryRead(out))
+			{
+			}
+			return out;
+		}
+
+		/**
+		 * @brief Number of writes so far, useful to tell if a value is new
+		 */
+		uint32_t version() const
+		{
+			return m_sequence.load(std::memory_order_acquire) >> 1;
+		}
+
+	private:
+		std::atomic<uint32_t> m_sequence;
+		T m_value;
+
+		Seqlock(const Seqlock &);
+		Seqlock &operator=(const Seqlock &);
+	};
+} // namespace art
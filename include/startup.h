@@ -0,0 +1,155 @@
+/**
+ * @file startup.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring Startup, which runs the independent parts of
+ * pre_auton side by side and tracks when each is ready
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Done one after the other, robot setup takes as long as all of its steps
+ * added together. Inertial calibration alone holds the robot for two
+ * seconds, and is mostly spent waiting. A route file could be read and the
+ * screen drawn in the same time. And if field control starts autonomous
+ * early, a pre_auton that is still running delays the whole period.
+ *
+ * Startup splits setup into named stages. Each stage lists the stages that
+ * must finish before it can run, and each gets a task of its own when start()
+ * is called, so stages that do not depend on each other overlap:
+ *
+ *     StageSet imu = RobotStartup.add("imu", calibrateImu);
+ *     StageSet routes = RobotStartup.add("routes", loadRoutes);
+ *     StageSet odom = RobotStartup.add("odometry", startOdometry, NULL, imu);
+ *     RobotStartup.start();
+ *
+ *     RobotStartup.waitFor(routes | odom, 5000); // in autonomous
+ *
+ * A stage can only depend on stages added before it, so there can be no
+ * cycles. A stage that fails still counts as finished, so the stages after
+ * it run and can check succeeded() to decide what to do without it. Stages
+ * should be bounded in time: anything waiting on hardware should use a wait
+ * with a timeout, and report a timeout by returning false.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "vex.h"
+#include "wait.h"
+
+namespace art
+{
+	/**
+	 * @brief Signature of a startup stage
+	 *
+	 * @return false if the stage failed; later stages still run
+	 */
+	typedef bool (*StageFn)(void *context);
+
+	/**
+	 * @brief A set of stages, one bit each, as returned by Startup::add()
+	 */
+	typedef uint32_t StageSet;
+
+	/**
+	 * @brief Progress of one stage
+	 */
+	enum StageState
+	{
+		kStagePending, /**< not started, or waiting for the stages before it */
+		kStageRunning,
+		kStageDone,
+		kStageFailed,
+	};
+
+	/**
+	 * @brief Runs the stages of robot setup concurrently, each once its
+	 * dependencies have finished
+	 *
+	 * Stages are added from one task, before start(). Everything else may be
+	 * called from any task.
+	 */
+	class Startup
+	{
+	public:
+		/** @brief Maximum number of stages */
+		static const int kMaxStages = 8;
+
+		Startup();
+
+		/**
+		 * @brief Registers a stage
+		 *
+		 * @param name short label used in reports, must outlive the Startup
+		 * @param fn function that performs the stage
+		 * @param context pointer handed to fn
+		 * @param after stages that must finish first, all added earlier
+		 * @return the stage, to depend on or wait for, or 0 if the Startup is
+		 * full, already started, or after names a stage not added yet
+		 */
+		StageSet add(const char *name, StageFn fn, void *context = NULL, StageSet after = 0);
+
+		/** @brief Starts a task for every stage; calling it again has no effect */
+		void start();
+
+		/** @brief True once every stage in the set has finished, or failed */
+		bool finished(StageSet stages) const;
+
+		/** @brief True once every stage in the set has finished without failing */
+		bool succeeded(StageSet stages) const;
+
+		/**
+		 * @brief Waits until every stage in the set has finished, or failed
+		 *
+		 * @param stages stages to wait for
+		 * @param timeoutMs longest wait, or kForever
+		 */
+		WaitResult waitFor(StageSet stages, uint32_t timeoutMs);
+
+		/** @brief Every stage added */
+		StageSet all() const { return m_count ? (StageSet)((1ull << m_count) - 1) : 0; }
+
+		/** @brief Number of stages added */
+		int count() const { return m_count; }
+
+		/** @brief Name of stage i, in the order they were added */
+		const char *name(int i) const { return m_stages[i].name; }
+
+		StageState state(int i) const { return (StageState)m_stages[i].state.load(std::memory_order_acquire); }
+
+		/** @brief Microseconds from start() until stage i began, once it has */
+		uint32_t startedUs(int i) const { return m_stages[i].startedUs; }
+
+		/** @brief Microseconds from start() until stage i finished, once it has */
+		uint32_t finishedUs(int i) const { return m_stages[i].finishedUs; }
+
+	private:
+		struct Stage
+		{
+			const char *name;
+			StageFn fn;
+			void *context;
+			StageSet after;
+			Startup *owner;
+			std::atomic<uint8_t> state;
+			uint32_t startedUs;  /**< written before state leaves kStagePending */
+			uint32_t finishedUs; /**< written before state is finished */
+		};
+
+		static int taskEntry(void *arg);
+
+		Stage m_stages[kMaxStages];
+		vex::task m_tasks[kMaxStages];
+		int m_count;
+		bool m_started;
+		uint64_t m_startUs;
+
+		Startup(const Startup &);
+		Startup &operator=(const Startup &);
+	};
+} // namespace art
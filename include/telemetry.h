@@ -0,0 +1,368 @@
+/**
+ * @file telemetry.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the Telemetry recorder that logs binary frames of
+ * match data to the SD card
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Any task can hand Telemetry a small record (a pose, the motor readings, the
+ * controller sticks...) and it is copied into a RAM buffer straight away.
+ * Writing to the SD card is slow and can stall for tens of milliseconds, so
+ * it never happens on the caller's task: a low-priority task swaps the
+ * buffers and writes the full one out in a single large append while
+ * recording carries on into the other.
+ *
+ * Recording never blocks. If a buffer is busy or both buffers are full the
+ * record is dropped and counted in dropped() instead.
+ *
+ * A log holds every reading the control code acted on, so TelemetryReader
+ * can walk one back and a recorded match can be replayed through the same
+ * code (see the simulator's --replay).
+ *
+ * The layout of the files is described in @ref telemetry_format.
+ */
+
+/**
+ * @page telemetry_format Telemetry file format
+ *
+ * Each call to Telemetry::begin() creates a new file named `<prefix>NNN.bin`
+ * on the SD card, NNN being the first unused number from 000 to 999. The file
+ * is a plain sequence of frames. All multi-byte values are little-endian.
+ *
+ * @section frame Frame
+ *
+ * | Offset | Size   | Field    | Meaning                                     |
+ * |--------|--------|----------|---------------------------------------------|
+ * | 0      | 1      | sync     | always 0xA5                                 |
+ * | 1      | 1      | type     | a TelemetryType                             |
+ * | 2      | 1      | length   | payload bytes that follow the header, 0-255 |
+ * | 3      | 1      | checksum | (type + length + every payload byte) & 0xFF |
+ * | 4      | 4      | timeMs   | uint32 brain time the record was made       |
+ * | 8      | length | payload  | record, laid out by type as below           |
+ *
+ * A decoder should read frames back to back. If the sync byte or checksum is
+ * wrong, skip forward one byte and look for the next 0xA5; records are never
+ * split across frames, so nothing after a bad frame is lost. Types a decoder
+ * does not know should be skipped using length.
+ *
+ * @section records Records
+ *
+ * - **kTelemetryHeader (0)**: first frame of every file. char[4] "ARTL",
+ *   uint16 format version (currently 1), uint16 reserved.
+ * - **kTelemetryPose (1)**: one PoseRecord, 12 bytes. int16 x and y in 1/64
+ *   inch, uint16 heading as a binary angle (65536 per turn, counter-clockwise
+ *   from +x), int16 vx and vy in 1/128 in/s, int16 angular velocity in 1/2048
+ *   rad/s.
+ * - **kTelemetryMotors (2)**: length / 12 MotorRecords back to back. Each is
+ *   uint8 motor index, uint8 temperature in degrees Celsius, int16 velocity
+ *   in 1/8 rpm, int16 current in mA, int16 voltage in mV, int32 position in
+ *   1/16 degree.
+ * - **kTelemetryController (3)**: one ControllerRecord, 6 bytes. int8 axes 1
+ *   to 4 in percent, uint16 buttons as a bitmask (bit 0 L1, L2, R1, R2, Up,
+ *   Down, Left, Right, X, B, Y, bit 11 A).
+ * - **kTelemetryText (4)**: length bytes of ASCII text, not terminated.
+ * - **kTelemetryProfile (5)**: one profiler section, 32 bytes. char[12]
+ *   name padded with zeros, then uint32 count, min, average, max and p99 in
+ *   nanoseconds.
+ * - **kTelemetrySensors (6)**: one SensorRecord, 28 bytes, every control
+ *   tick. int32 forward and sideways tracking wheel and int32 inertial
+ *   rotation (clockwise positive) in 1/256 degree, int16 distances 0 to 3 in
+ *   1/64 inch (negative when nothing is in range or the sensor is not
+ *   fitted), uint16 battery voltage in mV, int16 battery current in mA,
+ *   uint8[4] reserved.
+ * - **kTelemetryPhase (7)**: one PhaseRecord, 20 bytes, when autonomous or
+ *   usercontrol starts. uint8 TelemetryPhase, uint8[3] reserved, char[16]
+ *   autonomous routine name padded with zeros, empty for usercontrol.
+ * - **kTelemetryWatchdog (8)**: one watchdog event, 20 bytes. char[12] task
+ *   name padded with zeros (empty for a level change), uint8 WatchEventType,
+ *   uint8 degrade level after the event, uint16 deadlines missed, uint32
+ *   longest gap between check-ins in microseconds.
+ * - Types from kTelemetryUser (128) up are free for robot-specific records.
+ *
+ * Values that do not fit their field are clamped to the field's range.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "vex.h"
+
+#include "odometry.h"
+#include "watchdog.h"
+
+/**
+ * @brief Size in bytes of each of Telemetry's two buffers; override with
+ * -DART_TELEMETRY_BUFFER=...
+ */
+#ifndef ART_TELEMETRY_BUFFER
+#define ART_TELEMETRY_BUFFER (8 * 1024)
+#endif
+
+namespace art
+{
+	/**
+	 * @brief Record types understood by the decoder, see @ref telemetry_format
+	 */
+	enum TelemetryType
+	{
+		kTelemetryHeader = 0,
+		kTelemetryPose = 1,
+		kTelemetryMotors = 2,
+		kTelemetryController = 3,
+		kTelemetryText = 4,
+		kTelemetryProfile = 5,
+		kTelemetrySensors = 6,
+		kTelemetryPhase = 7,
+		kTelemetryWatchdog = 8,
+		kTelemetryUser = 128,
+	};
+
+	/**
+	 * @brief Competition period started by a kTelemetryPhase frame
+	 */
+	enum TelemetryPhase
+	{
+		kPhaseAutonomous = 1,
+		kPhaseDriver = 2,
+	};
+
+	/**
+	 * @brief Payload of a kTelemetryPose frame
+	 */
+	struct PoseRecord
+	{
+		int16_t x;
+		int16_t y;
+		uint16_t heading;
+		int16_t vx;
+		int16_t vy;
+		int16_t angularVelocity;
+
+		/** @brief Quantises an odometry estimate */
+		static PoseRecord encode(const OdometryState &state);
+	};
+
+	/**
+	 * @brief One motor's entry in a kTelemetryMotors frame
+	 */
+	struct MotorRecord
+	{
+		uint8_t index;
+		uint8_t temperature;
+		int16_t velocity;
+		int16_t current;
+		int16_t voltage;
+		int32_t position;
+
+		/**
+		 * @brief Quantises one motor's readings
+		 *
+		 * @param index which motor, so the decoder can tell them apart
+		 * @param position degrees
+		 * @param velocity rpm
+		 * @param current amps
+		 * @param voltage volts
+		 * @param temperature degrees Celsius
+		 */
+		static MotorRecord encode(uint8_t index, float position, float velocity, float current,
+								  float voltage, float temperature);
+	};
+
+	/**
+	 * @brief Payload of a kTelemetryController frame
+	 */
+	struct ControllerRecord
+	{
+		int8_t axis[4];
+		uint16_t buttons; /**< bit n is art::Button n, as in Input::buttons() */
+	};
+
+	/**
+	 * @brief Payload of a kTelemetrySensors frame
+	 */
+	struct SensorRecord
+	{
+		int32_t forward;
+		int32_t sideways;
+		int32_t rotation;
+		int16_t distance[4];
+		uint16_t batteryVoltage;
+		int16_t batteryCurrent;
+		uint8_t reserved[4];
+
+		/**
+		 * @brief Quantises one sample of the sensors
+		 *
+		 * @param forward forward tracking wheel, degrees
+		 * @param sideways sideways tracking wheel, degrees
+		 * @param rotation inertial sensor rotation, degrees clockwise
+		 * @param distance inches, negative when nothing is in range
+		 * @param distanceCount how many of the four slots distance fills
+		 * @param batteryVoltage volts
+		 * @param batteryCurrent amps
+		 */
+		static SensorRecord encode(float forward, float sideways, float rotation, const float *distance,
+								   size_t distanceCount, float batteryVoltage, float batteryCurrent);
+	};
+
+	/**
+	 * @brief Payload of a kTelemetryPhase frame
+	 */
+	struct PhaseRecord
+	{
+		uint8_t phase; /**< a TelemetryPhase */
+		uint8_t reserved[3];
+		char routine[16];
+	};
+
+	/**
+	 * @brief One frame of a log, as read back by TelemetryReader
+	 */
+	struct TelemetryFrame
+	{
+		uint8_t type;
+		uint8_t length;
+		uint32_t timeMs;
+		const uint8_t *payload; /**< points into the reader's buffer */
+	};
+
+	/**
+	 * @brief Walks the frames of a log held in memory
+	 *
+	 * Follows the decoding rules of @ref telemetry_format: bytes that do not
+	 * start a valid frame are skipped one at a time until one does.
+	 */
+	class TelemetryReader
+	{
+	public:
+		TelemetryReader(const uint8_t *data, size_t size);
+
+		/** @brief Reads the next valid frame; false at the end of the data */
+		bool next(TelemetryFrame &frame);
+
+		/** @brief Bytes skipped looking for a valid frame */
+		size_t skipped() const { return m_skipped; }
+
+	private:
+		const uint8_t *m_data;
+		size_t m_size;
+		size_t m_offset;
+		size_t m_skipped;
+	};
+
+	/**
+	 * @brief Non-blocking binary recorder flushing to the SD card
+	 */
+	class Telemetry
+	{
+	public:
+		/** @brief How often the flush task checks for a full buffer */
+		static const uint32_t kFlushPeriodMs = 100;
+
+		/** @brief Longest a partly filled buffer waits before being written anyway */
+		static const uint32_t kMaxLatencyMs = 1000;
+
+		/** @brief Largest payload a single frame can carry */
+		static const size_t kMaxPayload = 255;
+
+		Telemetry();
+
+		/**
+		 * @brief Creates a new log file and starts the flush task
+		 *
+		 * Call once, from pre_auton. Records made before this are dropped.
+		 *
+		 * @param prefix start of the file name, for example "match"
+		 * @return false if there is no SD card or no free file name
+		 */
+		bool begin(const char *prefix);
+
+		/** @brief True once begin() has opened a file */
+		bool recording() const { return m_recording; }
+
+		/** @brief Name of the file being written, empty if not recording */
+		const char *fileName() const { return m_fileName; }
+
+		/**
+		 * @brief Queues one frame, from any task, without ever blocking
+		 *
+		 * @param type a TelemetryType
+		 * @param payload record bytes, laid out as the format describes
+		 * @param length payload size, at most kMaxPayload
+		 * @return false if the frame was dropped
+		 */
+		bool write(uint8_t type, const void *payload, size_t length);
+
+		/** @brief Queues a kTelemetryPose frame */
+		bool logPose(const OdometryState &state);
+
+		/** @brief Queues a kTelemetryMotors frame of count records */
+		bool logMotors(const MotorRecord *records, size_t count);
+
+		/** @brief Queues a kTelemetryController frame */
+		bool logController(const ControllerRecord &record);
+
+		/** @brief Queues a kTelemetrySensors frame */
+		bool logSensors(const SensorRecord &record);
+
+		/**
+		 * @brief Queues a kTelemetryPhase frame
+		 *
+		 * @param phase a TelemetryPhase
+		 * @param routine autonomous routine, truncated to 15 characters, or NULL
+		 */
+		bool logPhase(uint8_t phase, const char *routine);
+
+		/** @brief Queues a kTelemetryWatchdog frame */
+		bool logWatch(const WatchEvent &event);
+
+		/** @brief Queues a kTelemetryText frame, truncated to kMaxPayload */
+		bool logText(const char *text);
+
+		/** @brief Checks the flush task into watchdog, as a task that can wait */
+		bool watch(Watchdog &watchdog);
+
+		/** @brief Frames accepted into a buffer */
+		uint32_t frames() const { return m_frames; }
+
+		/** @brief Frames thrown away because a buffer was busy or full */
+		uint32_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+		/** @brief Bytes the SD card has accepted */
+		uint32_t bytesWritten() const { return m_bytesWritten; }
+
+		/** @brief Appends that the SD card rejected */
+		uint32_t writeErrors() const { return m_writeErrors; }
+
+	private:
+		static int taskEntry(void *self);
+		void flushLoop();
+
+		vex::mutex m_lock;
+		uint8_t m_buffers[2][ART_TELEMETRY_BUFFER];
+		size_t m_fill[2];
+		int m_active;
+
+		bool m_recording;
+		char m_fileName[32];
+		vex::task m_task;
+		WatchHandle m_watch;
+
+		uint32_t m_frames;
+		std::atomic<uint32_t> m_dropped;
+		uint32_t m_bytesWritten;
+		uint32_t m_writeErrors;
+	};
+
+	/**
+	 * @brief The robot's match recorder
+	 */
+	extern Telemetry MatchLog;
+} // namespace art
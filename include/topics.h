@@ -0,0 +1,81 @@
+/**
+ * @file topics.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the robot's message bus topics and who subscribes
+ * to each
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Every piece of state that crosses from one task to another goes through a
+ * topic declared here, rather than a global that both tasks touch. Each
+ * topic has one publisher, and one subscriber per reader enum entry; adding a
+ * reader means adding an entry before the count, and nothing else.
+ *
+ * | Topic       | Publisher                   | Subscribers                  |
+ * |-------------|-----------------------------|------------------------------|
+ * | PoseTopic   | Odom's task, every 5 ms     | control, log, ui, drive      |
+ * | StatusTopic | the control loop's sampling | ui                           |
+ *
+ * The control, log, ui and drive jobs all still run on the competition task
+ * today. They each have their own subscription anyway, so any of them can
+ * move to a task of its own without touching the others.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "bus.h"
+#include "odometry.h"
+
+/**
+ * @brief Subscribers of PoseTopic
+ */
+enum PoseReader
+{
+	kControlPose, /**< path followers */
+	kLogPose,     /**< MatchLog recording */
+	kUiPose,      /**< Brain screen */
+	kDrivePose,   /**< driver assist */
+	kPoseReaders
+};
+
+/**
+ * @brief Every odometry estimate, published from the odometry task
+ */
+extern art::LatestTopic<art::OdometryState, kPoseReaders> PoseTopic;
+
+/**
+ * @brief Odometry::PublishFn that forwards each estimate to PoseTopic;
+ * register it before Odom.start()
+ */
+void publishPose(const art::OdometryState &state, void *context);
+
+/**
+ * @brief Health of the robot, summarised once per control tick
+ */
+struct RobotStatus
+{
+	float batteryVoltage;  /**< volts */
+	float batteryCurrent;  /**< amps */
+	float hottestDrive;    /**< degrees Celsius, the hottest drive motor */
+	float driveBudget;     /**< Limiter's current budget scale, 1 when unlimited */
+	uint32_t overruns;     /**< late ticks of the running control loop */
+	uint32_t worstLoopUs;  /**< longest tick of the running control loop */
+};
+
+/**
+ * @brief Subscribers of StatusTopic
+ */
+enum StatusReader
+{
+	kUiStatus, /**< Brain screen */
+	kStatusReaders
+};
+
+/**
+ * @brief The latest RobotStatus, published by the control loop
+ */
+extern art::LatestTopic<RobotStatus, kStatusReaders> StatusTopic;
@@ -0,0 +1,218 @@
+/**
+ * @file trajectory.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring precomputed motion profiles and trajectories stored
+ * as compact fixed-point sample tables
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Working out a spline, its curvature and a velocity profile along it is far
+ * too much maths to do every tick of autonomous. Instead, everything is
+ * generated once (usually in pre_auton) and stored as a table with one sample
+ * every 10 ms. During the match, looking up where the robot should be is just
+ * an index calculation and a linear interpolation between two samples, so the
+ * cost per tick is tiny and the timing is identical on every run.
+ *
+ * - Profile: one-dimensional motion over a distance (a straight drive, a
+ *   turn, a lift move), trapezoidal or S-curve
+ * - Trajectory: a cubic Hermite spline through waypoints with a velocity
+ *   profile along it that respects acceleration, jerk and turning limits
+ *
+ * Tables are allocated from an Arena and never freed.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "odometry.h"
+
+namespace art
+{
+	/**
+	 * @brief Kinematic limits for generating a Profile
+	 */
+	struct ProfileConstraints
+	{
+		float maxVelocity;     /**< units per second */
+		float maxAcceleration; /**< units per second squared */
+		float maxJerk;         /**< units per second cubed, 0 for a trapezoidal profile */
+	};
+
+	/**
+	 * @brief Decoded position, velocity and acceleration at one instant
+	 */
+	struct ProfileState
+	{
+		float position;
+		float velocity;
+		float acceleration;
+	};
+
+	/**
+	 * @brief One entry in a Profile table, every value in Q16.16 fixed point
+	 */
+	struct ProfileSample
+	{
+		int32_t position;
+		int32_t velocity;
+		int32_t acceleration;
+	};
+
+	/**
+	 * @brief A precomputed one-dimensional motion profile
+	 *
+	 * The units are whatever the constraints were given in (inches, degrees,
+	 * ...), up to about 32000 of them.
+	 */
+	class Profile
+	{
+	public:
+		/** @brief Time between samples in every table */
+		static const uint32_t kSamplePeriodMs = 10;
+
+		/** @brief Creates an empty, invalid Profile */
+		Profile();
+
+		/**
+		 * @brief Generates a profile that moves a distance and stops
+		 *
+		 * @param distance how far to move, negative to move backwards
+		 * @param constraints velocity, acceleration and jerk limits
+		 * @param arena where the table (and temporary scratch space) comes from
+		 * @return the profile, invalid if the arena ran out of memory
+		 */
+		static Profile generate(float distance, const ProfileConstraints &constraints, Arena &arena);
+
+		/** @brief False if generation failed */
+		bool valid() const { return m_samples != NULL; }
+
+		/** @brief Time from the start to the last sample */
+		uint32_t durationMs() const;
+
+		/** @brief Number of samples in the table */
+		uint32_t count() const { return m_count; }
+
+		/**
+		 * @brief Interpolated state at a time, clamped to the end of the profile
+		 */
+		ProfileState sample(uint32_t timeMs) const;
+
+	private:
+		const ProfileSample *m_samples;
+		uint32_t m_count;
+	};
+
+	/**
+	 * @brief A point the trajectory passes through, with the heading to have
+	 * when it gets there (radians, counter-clockwise from +x)
+	 */
+	struct Waypoint
+	{
+		float x;
+		float y;
+		float theta;
+	};
+
+	/**
+	 * @brief Limits for generating a Trajectory
+	 */
+	struct TrajectoryConstraints
+	{
+		float maxVelocity;     /**< in/s */
+		float maxAcceleration; /**< in/s^2 */
+		float maxJerk;         /**< in/s^3, 0 for trapezoidal */
+		float trackWidth;      /**< inches; keeps the outer wheel under maxVelocity in turns */
+		bool reversed;         /**< drive the path backwards */
+	};
+
+	/**
+	 * @brief Decoded state of a Trajectory at one instant
+	 */
+	struct TrajectoryState
+	{
+		Pose pose;             /**< where the robot should be */
+		float velocity;        /**< in/s along the path, negative when reversed */
+		float angularVelocity; /**< rad/s, counter-clockwise positive */
+		float acceleration;    /**< in/s^2 along the path */
+	};
+
+	/**
+	 * @brief One entry in a Trajectory table, 12 bytes of fixed point
+	 *
+	 * Positions are 1/64 inch, heading is a binary angle (65536 = one turn, so
+	 * wrap-around is free), velocity is 1/128 in/s, angular velocity is 1/2048
+	 * rad/s and acceleration is 1/64 in/s^2.
+	 */
+	struct TrajectorySample
+	{
+		int16_t x;
+		int16_t y;
+		uint16_t heading;
+		int16_t velocity;
+		int16_t angularVelocity;
+		int16_t acceleration;
+	};
+
+	/**
+	 * @brief A precomputed path with timing, sampled every 10 ms
+	 */
+	class Trajectory
+	{
+	public:
+		/** @brief Time between samples in every table */
+		static const uint32_t kSamplePeriodMs = 10;
+
+		/** @brief Creates an empty, invalid Trajectory */
+		Trajectory();
+
+		/**
+		 * @brief Generates a trajectory through a list of waypoints
+		 *
+		 * The robot starts and ends at rest unless given speeds to start and
+		 * end at, as a piece spliced into a path it is already driving is.
+		 * Curvature comes from a cubic Hermite spline whose tangents follow
+		 * each waypoint's heading.
+		 *
+		 * @param waypoints at least two waypoints
+		 * @param count number of waypoints
+		 * @param constraints velocity, acceleration, jerk and turning limits
+		 * @param arena where the table (and temporary scratch space) comes from
+		 * @param startVelocity in/s at the first waypoint, capped by the limits
+		 * @param endVelocity in/s at the last waypoint, capped by the limits
+		 * @return the trajectory, invalid if the arena ran out of memory
+		 */
+		static Trajectory generate(const Waypoint *waypoints, size_t count,
+								   const TrajectoryConstraints &constraints, Arena &arena,
+								   float startVelocity = 0.0f, float endVelocity = 0.0f);
+
+		/** @brief False if generation failed */
+		bool valid() const { return m_samples != NULL; }
+
+		/** @brief Time from the start to the last sample */
+		uint32_t durationMs() const;
+
+		/** @brief Number of samples in the table */
+		uint32_t count() const { return m_count; }
+
+		/** @brief Length of the path in inches */
+		float length() const { return m_length; }
+
+		/**
+		 * @brief Interpolated state at a time, clamped to the end of the path
+		 */
+		TrajectoryState sample(uint32_t timeMs) const;
+
+		/** @brief Decoded sample at an index, without interpolation */
+		TrajectoryState at(uint32_t index) const;
+
+	private:
+		const TrajectorySample *m_samples;
+		uint32_t m_count;
+		float m_length;
+	};
+} // namespace art
@@ -0,0 +1,149 @@
+/**
+ * @file tuneLink.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring TuneLink, a small binary protocol over the USB
+ * serial port for reading and editing the ParamRegistry from a laptop
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * With the Brain plugged in over USB, a script on a laptop can list every
+ * tunable value, change any of them mid-run and have the result saved, all
+ * without rebuilding. TuneLink::poll() is run as a job of the control loop:
+ * it reads whatever bytes have arrived, answers complete requests, and
+ * never waits for the port. Edits go through ParamRegistry::set(), so they
+ * are range checked and take effect at the loop's next apply() like any
+ * other.
+ *
+ * The protocol is described in @ref tune_protocol.
+ */
+
+/**
+ * @page tune_protocol Tuning protocol
+ *
+ * Requests and replies are frames on the USB user port (serial channel 1).
+ * All multi-byte values are little-endian.
+ *
+ * @section tune_frame Frame
+ *
+ * | Offset | Size   | Field    | Meaning                                     |
+ * |--------|--------|----------|---------------------------------------------|
+ * | 0      | 1      | sync     | always 0x5A                                 |
+ * | 1      | 1      | type     | a TuneType                                  |
+ * | 2      | 1      | length   | payload bytes that follow the header, 0-255 |
+ * | 3      | 1      | checksum | (type + length + every payload byte) & 0xFF |
+ * | 4      | length | payload  | laid out by type as below                   |
+ *
+ * The Brain drops a frame whose checksum is wrong and looks for the next sync
+ * byte. A request of the wrong length, or of a type it does not know, is
+ * answered with kTuneError.
+ *
+ * @section tune_requests Requests, from the laptop
+ *
+ * - **kTuneList (0x01)**: no payload. Answered with one kTuneInfo per
+ *   entry, in index order.
+ * - **kTuneGet (0x02)**: uint8 index. Answered with kTuneValue.
+ * - **kTuneSet (0x03)**: uint8 index, uint8[3] reserved, float32 value.
+ *   Integer and bool entries take whole values. Answered with kTuneValue once
+ *   staged, or kTuneError.
+ * - **kTuneSave (0x04)**: no payload. Saves to the SD card without waiting
+ *   for edits to settle, and is answered with kTuneSaved straight away.
+ *
+ * @section tune_replies Replies, from the Brain
+ *
+ * - **kTuneInfo (0x81)**: 32 bytes. uint8 index, uint8 entry count, uint8
+ *   ParamType, uint8 group, char[16] name padded with zeros, then float32 min,
+ *   max and step.
+ * - **kTuneValue (0x82)**: 8 bytes. uint8 index, uint8 1 if the value has not
+ *   been applied yet, uint8[2] reserved, float32 value.
+ * - **kTuneSaved (0x84)**: no payload.
+ * - **kTuneError (0xFF)**: 4 bytes. uint8 request type, uint8 index (0 if
+ *   none), uint8 reason (a ParamResult, or kTuneBadRequest), uint8 reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+
+namespace art
+{
+	/**
+	 * @brief Frame types, see @ref tune_protocol
+	 */
+	enum TuneType
+	{
+		kTuneList = 0x01,
+		kTuneGet = 0x02,
+		kTuneSet = 0x03,
+		kTuneSave = 0x04,
+		kTuneInfo = 0x81,
+		kTuneValue = 0x82,
+		kTuneSaved = 0x84,
+		kTuneError = 0xFF,
+	};
+
+	/** @brief kTuneError reason of a malformed or unknown request */
+	const uint8_t kTuneBadRequest = 0x10;
+
+	/**
+	 * @brief Serves a ParamRegistry over the USB serial port
+	 */
+	class TuneLink
+	{
+	public:
+		/** @brief Serial channel of the USB user port */
+		static const uint32_t kChannel = 1;
+
+		/** @brief Most bytes read per poll(), to bound its cost */
+		static const size_t kMaxReadBytes = 128;
+
+		/** @brief Sync byte starting every frame */
+		static const uint8_t kSync = 0x5A;
+
+		explicit TuneLink(ParamRegistry &params);
+
+		/**
+		 * @brief Reads and answers requests without blocking
+		 *
+		 * Run it as a scheduler job. The entries of a listing that do not fit
+		 * in the port's transmit buffer are sent by later polls; any other
+		 * reply that does not fit is counted in dropped().
+		 */
+		void poll();
+
+		/** @brief Requests answered */
+		uint32_t requests() const { return m_requests; }
+
+		/** @brief Frames thrown away for a bad checksum */
+		uint32_t badFrames() const { return m_badFrames; }
+
+		/** @brief Replies that could not be sent */
+		uint32_t dropped() const { return m_dropped; }
+
+	private:
+		static const size_t kHeaderSize = 4;
+
+		void handle(uint8_t type, const uint8_t *payload, size_t length);
+		bool send(uint8_t type, const void *payload, size_t length);
+		void sendValue(size_t index);
+		void sendError(uint8_t request, uint8_t index, uint8_t reason);
+		bool sendInfo(size_t index);
+
+		ParamRegistry &m_params;
+
+		uint8_t m_frame[kHeaderSize + 255];
+		size_t m_fill;
+		size_t m_listNext; /**< next kTuneInfo owed to a kTuneList, or past the end */
+
+		uint32_t m_requests;
+		uint32_t m_badFrames;
+		uint32_t m_dropped;
+
+		TuneLink(const TuneLink &);
+		TuneLink &operator=(const TuneLink &);
+	};
+} // namespace art
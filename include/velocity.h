@@ -0,0 +1,160 @@
+/**
+ * @file velocity.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring VelocityController, the drivetrain's wheel speed
+ * loop, run on the brain from a task of its own
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * motor.spin(velocity) hands speed control to the motor firmware, whose loop
+ * and tuning we cannot see or change, and a voltage from feedforward alone
+ * drifts with battery charge, friction and load. VelocityController closes
+ * the loop itself: every 10 ms, on a high-priority task, it measures both
+ * sides of the drivetrain, then sends each a voltage made of
+ *
+ * - model feedforward, kS * sign(v) + kV * v + kA * a, which gets the speed
+ *   nearly right on its own
+ * - a PID on the remaining speed error, for whatever the model misses
+ *
+ * Measuring and commanding go through callbacks (see setMeasure() and
+ * setOutput()), so the controller does not depend on any particular device
+ * layout. The PID is a Pid<FixedMath>, so the loop does its arithmetic in
+ * integers.
+ *
+ * Targets are handed over through a Mailbox, so any one task may set them
+ * without blocking the controller. A target that is not refreshed within
+ * kTimeoutMs is dropped and the drive stopped, so a command that ends
+ * without calling stop(), or a task that dies, cannot leave the robot
+ * driving.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "vex.h"
+
+#include "bus.h"
+#include "pid.h"
+#include "scheduler.h"
+
+namespace art
+{
+	/**
+	 * @brief Closed-loop speed control of the two sides of a drivetrain
+	 */
+	class VelocityController
+	{
+	public:
+		/** @brief Update period of the controller task */
+		static const uint32_t kPeriodMs = 10;
+
+		/** @brief How long the controller task can go without running before the watchdog calls it stalled */
+		static const uint32_t kWatchTimeoutMs = 100;
+
+		/** @brief A target older than this is dropped */
+		static const uint32_t kTimeoutMs = 50;
+
+		/**
+		 * @brief Called on the controller task to read each side's speed, in
+		 * the units of the gains
+		 */
+		typedef void (*MeasureFn)(float &left, float &right, void *context);
+
+		/** @brief Called on the controller task with each side's voltage */
+		typedef void (*OutputFn)(float left, float right, void *context);
+
+		/**
+		 * @param gains PID and feedforward gains, with speeds in the same units
+		 * as the targets and the measurements
+		 */
+		explicit VelocityController(const PidGains &gains);
+
+		void setMeasure(MeasureFn measure, void *context = NULL);
+		void setOutput(OutputFn output, void *context = NULL);
+
+		/**
+		 * @brief Starts the controller task
+		 *
+		 * Register both callbacks first. Calling it again has no effect.
+		 */
+		void start();
+
+		/**
+		 * @brief Checks the controller task into watchdog, as a critical task
+		 *
+		 * Call after start().
+		 */
+		bool watch(Watchdog &watchdog) { return m_loop.watch(watchdog, "velocity", kWatchTimeoutMs); }
+
+		/**
+		 * @brief Asks for a speed on each side, until replaced, stopped or
+		 * kTimeoutMs passes
+		 *
+		 * Only call it from one task at a time.
+		 */
+		void setTarget(float left, float right);
+
+		/** @brief Drops the target; the controller sends zero once and then idles */
+		void stop();
+
+		/**
+		 * @brief Replaces the gains from the next update on, from any one task
+		 *
+		 * Both PIDs start again from rest, since an integral built up under
+		 * the old gains means nothing under the new ones.
+		 */
+		void setGains(const PidGains &gains);
+
+		/**
+		 * @brief Runs one period of the loop
+		 *
+		 * The controller task calls this; it is public so the loop can be
+		 * stepped and timed off the robot.
+		 */
+		void update();
+
+		/** @brief True while the controller is driving the motors */
+		bool active() const { return m_active; }
+
+		/** @brief Speed error of each side at the last update */
+		float leftError() const { return m_error[0]; }
+		float rightError() const { return m_error[1]; }
+
+		/** @brief Timing statistics of the controller task */
+		const TaskStats &stats() const { return m_loop.stats(0); }
+
+	private:
+		struct Target
+		{
+			float speed[2];
+			bool active;
+			uint64_t timeUs;
+		};
+
+		static int taskEntry(void *self);
+		static void tick(void *self);
+
+		Pid<FixedMath> m_left;
+		Pid<FixedMath> m_right;
+		Pid<FixedMath> *m_pid[2]; /**< the two above, by side */
+		MeasureFn m_measure;
+		void *m_measureContext;
+		OutputFn m_output;
+		void *m_outputContext;
+
+		Scheduler m_loop;
+		vex::task m_task;
+		bool m_started;
+
+		Mailbox<Target> m_target;
+		Mailbox<PidGains> m_gains;
+		bool m_active;
+		uint64_t m_lastTargetUs;  /**< when the target m_lastSpeed came from was set */
+		float m_lastSpeed[2];
+		float m_acceleration[2]; /**< of the target, between the last two that were set */
+		float m_error[2];
+	};
+} // namespace art
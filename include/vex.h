@@ -11,8 +11,14 @@
  * Vex V5 library. Chances are, the code here will never need to be modified.
  * Any file that needs to interact with a vex controller, brain, motor or other
  * device will need to include this file to access those classes.
+ *
+ * VEXcode's waitUntil and repeat macros used to live here. Use art::waitUntil
+ * and art::waitFor from wait.h instead, which take a timeout, and a plain for
+ * loop in place of repeat.
  */
 
+#pragma once
+
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,12 +29,3 @@
 
 extern vex::brain Brain;            /**< a brain object representing the V5 Brain */
 extern vex::controller Controller1; /**< a controller object representing the Primary Controller */
-
-#define waitUntil(condition) \
-  do                         \
-  {                          \
-    wait(5, msec);           \
-  } while (!(condition))
-
-#define repeat(iterations) \
-  for (int iterator = 0; iterator < iterations; iterator++)
\ No newline at end of file
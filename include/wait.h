@@ -0,0 +1,122 @@
+/**
+ * @file wait.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring waits with timeouts: for a duration, until a
+ * condition holds, or until another task sends a Signal
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Every wait here has a deadline, so a sensor that never reports ready cannot
+ * hang the code behind it. Each one returns a WaitResult saying whether the
+ * wait succeeded and how long it took. Between polls the calling task sleeps
+ * against an absolute deadline, like the Scheduler does. A poll period of N
+ * ms therefore means one check every N ms and no CPU spent in between.
+ *
+ * The V5 SDK has no way for one task to wake another directly, so a Signal
+ * is also polled, once per millisecond by default. That is the resolution of
+ * the V5 task sleep anyway. A waiting task therefore reacts within a
+ * millisecond of the signal and sleeps the rest of the time.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "scheduler.h"
+
+namespace art
+{
+	/** @brief Timeout for a wait that should never give up */
+	const uint32_t kForever = UINT32_MAX;
+
+	/** @brief Poll period used when none is given */
+	const uint32_t kDefaultPollMs = 5;
+
+	/**
+	 * @brief How a wait ended
+	 */
+	struct WaitResult
+	{
+		bool satisfied;    /**< false if the wait timed out */
+		uint32_t waitedUs; /**< time from the start of the wait until it ended */
+
+		explicit operator bool() const { return satisfied; }
+	};
+
+	/**
+	 * @brief Sleeps for a fixed time, measured from the call
+	 *
+	 * The same as vex::wait, but reports how long the sleep really took.
+	 */
+	WaitResult waitFor(uint32_t durationMs);
+
+	/**
+	 * @brief Waits until condition() returns true or the timeout passes
+	 *
+	 * The condition is checked straight away, then once every pollMs, and a
+	 * last time at the deadline.
+	 *
+	 * @param condition anything callable with no arguments returning bool
+	 * @param timeoutMs longest wait, or kForever
+	 * @param pollMs time between checks
+	 */
+	template <typename Condition>
+	WaitResult waitUntil(Condition condition, uint32_t timeoutMs, uint32_t pollMs = kDefaultPollMs)
+	{
+		uint64_t start = timeUs();
+		uint64_t deadline = timeoutMs == kForever ? UINT64_MAX : start + (uint64_t)timeoutMs * 1000;
+		uint64_t pollUs = (uint64_t)(pollMs ? pollMs : 1) * 1000;
+		uint64_t next = start;
+		while (true)
+		{
+			bool satisfied = condition();
+			uint64_t now = timeUs();
+			if (satisfied || now >= deadline)
+			{
+				WaitResult result = {satisfied, (uint32_t)(now - start)};
+				return result;
+			}
+			next += pollUs;
+			if (next < now)
+			{
+				// a slow condition pushes the next check back instead of bunching them up
+				next = now;
+			}
+			sleepUntil(next < deadline ? next : deadline);
+		}
+	}
+
+	/**
+	 * @brief A count of events passed from producer tasks to a consumer
+	 *
+	 * signal() may be called from any task. Each successful wait() consumes
+	 * one signal, so none are lost if the consumer falls behind.
+	 */
+	class Signal
+	{
+	public:
+		Signal() : m_count(0) {}
+
+		void signal();
+
+		/**
+		 * @brief Waits for a signal and consumes it
+		 *
+		 * @param timeoutMs longest wait, or kForever
+		 * @param pollMs time between checks
+		 */
+		WaitResult wait(uint32_t timeoutMs, uint32_t pollMs = 1);
+
+		/** @brief Consumes a signal if one is pending, without waiting */
+		bool tryTake();
+
+		uint32_t pending() const { return m_count.load(std::memory_order_acquire); }
+
+	private:
+		std::atomic<uint32_t> m_count;
+	};
+} // namespace art
@@ -0,0 +1,226 @@
+/**
+ * @file watchdog.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring Watchdog, which every periodic task checks into so
+ * late, starved and hung tasks are noticed
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A control loop that stops running leaves the motors doing whatever they
+ * were last told, and a loop that runs late steers worse without anything
+ * looking wrong. Each task registers with the watchdog the period it means to
+ * run at and checks in once per pass. A check-in two or more periods after
+ * the one before counts as a deadline miss. A task that has not checked in
+ * for its timeout is stalled: hung, or starved by tasks above it.
+ *
+ * poll() is run from a task of its own (main's loop) every 100 ms or so. It
+ * reports misses, stalls and recoveries through the report callback, for the
+ * match log. When a critical task misses deadlines or stalls, it raises the
+ * degrade level one step at a time, and the degrade callback slows down work
+ * that can wait, such as the screen and the log, so the control loops get
+ * their time back. Once the critical tasks have kept time for kRecoverMs, the
+ * level comes back down a step.
+ *
+ * VEXos tasks are cooperative, so a task that hangs without ever yielding
+ * stops poll() from running too. What the watchdog catches is a task that has
+ * stopped or fallen behind while the others still run.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+namespace art
+{
+	/**
+	 * @brief What a WatchEvent reports
+	 */
+	enum WatchEventType
+	{
+		kWatchLate = 1,      /**< deadlines missed since the last poll */
+		kWatchStalled = 2,   /**< no check-in for the task's timeout */
+		kWatchRecovered = 3, /**< a stalled task checked in again */
+		kWatchLevel = 4,     /**< the degrade level changed */
+	};
+
+	/**
+	 * @brief One thing the watchdog noticed, handed to the report callback
+	 */
+	struct WatchEvent
+	{
+		uint8_t type;    /**< a WatchEventType */
+		uint8_t level;   /**< degrade level after the event */
+		uint16_t count;  /**< deadlines missed, for kWatchLate */
+		uint32_t gapUs;  /**< longest time between check-ins behind the event */
+		const char *name; /**< task the event is about, empty for kWatchLevel */
+	};
+
+	/**
+	 * @brief Check-in statistics of one task
+	 */
+	struct WatchStats
+	{
+		uint32_t checkIns;
+		uint32_t misses;     /**< check-ins two or more periods after the last */
+		uint32_t stalls;     /**< times the task went a whole timeout without one */
+		uint32_t worstGapUs; /**< longest time between two check-ins */
+	};
+
+	typedef void (*WatchReportFn)(const WatchEvent &event, void *context);
+	typedef void (*DegradeFn)(int level, void *context);
+
+	/**
+	 * @brief Tracks the check-ins of every periodic task
+	 *
+	 * add() is called from pre_auton or the startup stages, which the V5 runs
+	 * cooperatively, so never from two tasks at once. checkIn(), pause() and
+	 * setPeriod() may be called from any task, poll() from one task only.
+	 */
+	class Watchdog
+	{
+	public:
+		/** @brief Maximum number of tasks watched */
+		static const int kMaxTasks = 12;
+
+		/** @brief Highest degrade level */
+		static const int kMaxLevel = 2;
+
+		/** @brief Shortest time between two steps up of the degrade level */
+		static const uint32_t kDegradeHoldMs = 500;
+
+		/** @brief How long critical tasks must keep time before a step down */
+		static const uint32_t kRecoverMs = 3000;
+
+		Watchdog();
+
+		/**
+		 * @brief Registers a task
+		 *
+		 * @param name short label for reports, must outlive the Watchdog
+		 * @param periodMs how often the task checks in
+		 * @param timeoutMs how long without a check-in counts as a stall
+		 * @param critical whether the task's misses and stalls raise the
+		 * degrade level
+		 * @return a handle for checkIn(), or -1 if the Watchdog is full
+		 */
+		int add(const char *name, uint32_t periodMs, uint32_t timeoutMs, bool critical);
+
+		/**
+		 * @brief Records one pass of the task
+		 *
+		 * The first check-in after add() or pause() arms the task; until then
+		 * it is not expected to run.
+		 */
+		void checkIn(int handle);
+
+		/** @brief Stops expecting check-ins until the next one, for a task that is stopped on purpose */
+		void pause(int handle);
+
+		/** @brief Changes how often a task checks in, for one that has been slowed down */
+		void setPeriod(int handle, uint32_t periodMs);
+
+		/** @brief Looks for stalls, reports what changed and adjusts the degrade level */
+		void poll();
+
+		void setReport(WatchReportFn report, void *context = NULL);
+		void setDegrade(DegradeFn degrade, void *context = NULL);
+
+		/** @brief 0 with everything on time, up to kMaxLevel */
+		int level() const { return m_level; }
+
+		/** @brief Times the degrade level has changed */
+		uint32_t levelChanges() const { return m_levelChanges; }
+
+		int count() const { return m_count; }
+		const char *name(int handle) const;
+		WatchStats stats(int handle) const;
+		bool stalled(int handle) const;
+
+	private:
+		struct Entry
+		{
+			const char *name;
+			std::atomic<uint32_t> periodUs;
+			uint32_t timeoutUs;
+			bool critical;
+			std::atomic<bool> armed;
+			std::atomic<uint32_t> lastUs;  /**< low 32 bits of timeUs() at the last check-in */
+			std::atomic<uint32_t> checkIns;
+			std::atomic<uint32_t> misses;
+			std::atomic<uint32_t> windowGapUs; /**< longest gap since the last poll */
+			uint32_t worstGapUs;           /**< written by the task only */
+			uint32_t reportedMisses;       /**< written by poll() only */
+			uint32_t stalls;
+			bool stalled;
+		};
+
+		void report(uint8_t type, const char *name, uint32_t count, uint32_t gapUs);
+		void setLevel(int level, uint32_t nowMs);
+
+		Entry m_tasks[kMaxTasks];
+		int m_count;
+
+		WatchReportFn m_report;
+		void *m_reportContext;
+		DegradeFn m_degrade;
+		void *m_degradeContext;
+
+		int m_level;
+		uint32_t m_levelChanges;
+		uint32_t m_levelMs;  /**< when the level last changed */
+		uint32_t m_troubleMs; /**< when a critical task was last late or stalled */
+
+		Watchdog(const Watchdog &);
+		Watchdog &operator=(const Watchdog &);
+	};
+
+	/**
+	 * @brief A task's registration with a Watchdog, doing nothing until attached
+	 *
+	 * Lets a class with a task of its own be watched or not without checking
+	 * for it at every pass.
+	 */
+	class WatchHandle
+	{
+	public:
+		WatchHandle() : m_watchdog(NULL), m_handle(-1) {}
+
+		/** @brief Registers with watchdog, see Watchdog::add(); false if it is full */
+		bool attach(Watchdog &watchdog, const char *name, uint32_t periodMs, uint32_t timeoutMs, bool critical);
+
+		void checkIn()
+		{
+			if (m_watchdog)
+			{
+				m_watchdog->checkIn(m_handle);
+			}
+		}
+
+		void pause()
+		{
+			if (m_watchdog)
+			{
+				m_watchdog->pause(m_handle);
+			}
+		}
+
+		void setPeriod(uint32_t periodMs)
+		{
+			if (m_watchdog)
+			{
+				m_watchdog->setPeriod(m_handle, periodMs);
+			}
+		}
+
+		bool attached() const { return m_watchdog != NULL; }
+
+	private:
+		Watchdog *m_watchdog;
+		int m_handle;
+	};
+} // namespace art
@@ -0,0 +1,44 @@
+/**
+ * @file v5.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Host stand-in for the VEX V5 C API header
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Only the small subset of the V5 C API that the robot code touches directly
+ * is declared here. Everything else lives behind the C++ classes in
+ * v5_vcs.h, exactly like the real SDK.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Writes a buffer to a serial channel (channel 1 is the USB user port)
+ *
+ * @return the number of bytes accepted
+ */
+int32_t vexSerialWriteBuffer(uint32_t channel, uint8_t *data, uint32_t data_len);
+
+/**
+ * @brief Reads one byte from a serial channel
+ *
+ * @return the byte read, or -1 when no data is waiting
+ */
+int32_t vexSerialReadChar(uint32_t channel);
+
+/**
+ * @brief Returns the number of bytes that can be written without blocking
+ */
+int32_t vexSerialWriteFree(uint32_t channel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,409 @@
+/**
+ * @file v5_vcs.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Host stand-in for the VEX V5 C++ API
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * This header mirrors the parts of the vex namespace the robot code uses, with
+ * the same names and signatures as the V5 SDK. The devices do not talk to
+ * hardware; they read and write the simulated world in sim/src/physics.cpp,
+ * and vex::task runs on the virtual-time scheduler in
+ * sim/src/scheduler_sim.cpp, so a whole match runs faster than real time on a
+ * desktop.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "v5.h"
+
+#define PORT1 0
+#define PORT2 1
+#define PORT3 2
+#define PORT4 3
+#define PORT5 4
+#define PORT6 5
+#define PORT7 6
+#define PORT8 7
+#define PORT9 8
+#define PORT10 9
+#define PORT11 10
+#define PORT12 11
+#define PORT13 12
+#define PORT14 13
+#define PORT15 14
+#define PORT16 15
+#define PORT17 16
+#define PORT18 17
+#define PORT19 18
+#define PORT20 19
+#define PORT21 20
+
+namespace vex
+{
+	enum class timeUnits { sec, msec };
+	enum class rotationUnits { deg, rev, raw };
+	enum class velocityUnits { pct, rpm, dps };
+	enum class percentUnits { pct };
+	enum class voltageUnits { volt, mV };
+	enum class currentUnits { amp };
+	enum class temperatureUnits { celsius, fahrenheit };
+	enum class distanceUnits { mm, in, cm };
+	enum class directionType { fwd, rev, undefined };
+	enum class brakeType { coast, brake, hold, undefined };
+	enum class gearSetting { ratio36_1, ratio18_1, ratio6_1 };
+	enum class controllerType { primary, partner };
+	enum class fontType { mono20, mono30, mono40, mono60, mono15, mono12, prop20, prop30, prop40, prop60 };
+
+	const timeUnits sec = timeUnits::sec;
+	const timeUnits msec = timeUnits::msec;
+	const percentUnits percent = percentUnits::pct;
+	const percentUnits pct = percentUnits::pct;
+
+	/**
+	 * @brief A 24-bit RGB colour, as used by the brain and screen APIs
+	 */
+	class color
+	{
+	public:
+		color() : m_rgb(0) {}
+		color(uint32_t rgb) : m_rgb(rgb & 0xFFFFFF) {}
+		color(int r, int g, int b) : m_rgb((uint32_t)((r & 0xFF) << 16 | (g & 0xFF) << 8 | (b & 0xFF))) {}
+
+		uint32_t rgb() const { return m_rgb; }
+
+		static const color black;
+		static const color white;
+		static const color red;
+		static const color green;
+		static const color blue;
+		static const color yellow;
+		static const color orange;
+		static const color purple;
+		static const color cyan;
+		static const color transparent;
+
+	private:
+		uint32_t m_rgb;
+	};
+
+	/**
+	 * @brief Blocks the calling task for a duration of virtual time
+	 */
+	void wait(double time, timeUnits units);
+
+	/**
+	 * @brief Millisecond timer, read from the simulated system clock
+	 */
+	class timer
+	{
+	public:
+		timer();
+
+		double time(timeUnits units = timeUnits::msec) const;
+		void clear();
+		void reset() { clear(); }
+
+		static uint32_t system();
+		static uint64_t systemHighResolution();
+
+	private:
+		uint64_t m_start;
+	};
+
+	/**
+	 * @brief A cooperative task running on the simulator's virtual clock
+	 */
+	class task
+	{
+	public:
+		static const int32_t taskPrioritylow = 1;
+		static const int32_t taskPriorityNormal = 7;
+		static const int32_t taskPriorityHigh = 15;
+
+		task();
+		task(int (*callback)(void));
+		task(int (*callback)(void), int32_t priority);
+		task(int (*callback)(void *), void *arg);
+		task(int (*callback)(void *), void *arg, int32_t priority);
+
+		void stop();
+		void suspend();
+		void resume();
+		int32_t priority();
+		void setPriority(int32_t priority);
+
+		static void sleep(uint32_t time);
+		static void yield();
+
+	private:
+		int32_t m_id;
+	};
+
+	namespace this_thread
+	{
+		int32_t get_id();
+		void sleep_for(uint32_t time_ms);
+		void sleep_until(uint32_t time);
+		void yield();
+	} // namespace this_thread
+
+	/**
+	 * @brief Mutual exclusion lock between tasks
+	 */
+	class mutex
+	{
+	public:
+		mutex() : m_owner(-1), m_depth(0) {}
+
+		void lock();
+		bool try_lock();
+		void unlock();
+
+	private:
+		int32_t m_owner;
+		int32_t m_depth;
+	};
+
+	/**
+	 * @brief V5 Smart Motor on a smart port
+	 */
+	class motor
+	{
+	public:
+		motor(int32_t index);
+		motor(int32_t index, bool reverse);
+		motor(int32_t index, gearSetting gears);
+		motor(int32_t index, gearSetting gears, bool reverse);
+
+		int32_t index() const { return m_index; }
+		bool installed();
+
+		void spin(directionType dir);
+		void spin(directionType dir, double velocity, velocityUnits units);
+		void spin(directionType dir, double velocity, percentUnits units);
+		void spin(directionType dir, double voltage, voltageUnits units);
+		void stop();
+		void stop(brakeType mode);
+		void setStopping(brakeType mode);
+		void setVelocity(double velocity, velocityUnits units);
+		void setVelocity(double velocity, percentUnits units);
+		void setReversed(bool value);
+		void setMaxTorque(double value, percentUnits units);
+
+		void resetPosition();
+		void setPosition(double value, rotationUnits units);
+		double position(rotationUnits units);
+		double velocity(velocityUnits units);
+		double velocity(percentUnits units);
+		double current(currentUnits units = currentUnits::amp);
+		double voltage(voltageUnits units = voltageUnits::volt);
+		double temperature(temperatureUnits units = temperatureUnits::celsius);
+		double torque();
+		double power();
+		double efficiency();
+
+	private:
+		int32_t m_index;
+	};
+
+	/**
+	 * @brief V5 Inertial Sensor
+	 */
+	class inertial
+	{
+	public:
+		inertial(int32_t index);
+
+		bool installed();
+		void calibrate();
+		void startCalibration() { calibrate(); }
+		bool isCalibrating();
+		void resetHeading();
+		void resetRotation();
+		void setHeading(double value, rotationUnits units);
+		void setRotation(double value, rotationUnits units);
+		double heading(rotationUnits units = rotationUnits::deg);
+		double rotation(rotationUnits units = rotationUnits::deg);
+
+	private:
+		int32_t m_index;
+	};
+
+	/**
+	 * @brief V5 Rotation Sensor
+	 */
+	class rotation
+	{
+	public:
+		rotation(int32_t index, bool reverse = false);
+
+		bool installed();
+		void setReversed(bool value);
+		void resetPosition();
+		void setPosition(double value, rotationUnits units);
+		double position(rotationUnits units);
+		double velocity(velocityUnits units);
+
+	private:
+		int32_t m_index;
+		bool m_reverse;
+	};
+
+	/**
+	 * @brief V5 Distance Sensor
+	 */
+	class distance
+	{
+	public:
+		distance(int32_t index);
+
+		bool installed();
+		double objectDistance(distanceUnits units);
+		bool isObjectDetected();
+
+	private:
+		int32_t m_index;
+	};
+
+	/**
+	 * @brief V5 Controller
+	 */
+	class controller
+	{
+	public:
+		class axis
+		{
+		public:
+			axis(int id) : m_id(id) {}
+			int32_t value() const;
+			int32_t position(percentUnits units = percentUnits::pct) const;
+
+		private:
+			int m_id;
+		};
+
+		class button
+		{
+		public:
+			button(int id) : m_id(id) {}
+			bool pressing() const;
+
+		private:
+			int m_id;
+		};
+
+		class lcd
+		{
+		public:
+			void setCursor(int32_t row, int32_t col);
+			void print(const char *format, ...);
+			void clearScreen();
+			void clearLine(int32_t number);
+			void clearLine();
+			void newLine();
+		};
+
+		controller();
+		controller(controllerType id);
+
+		bool installed();
+		void rumble(const char *pattern);
+
+		axis Axis1;
+		axis Axis2;
+		axis Axis3;
+		axis Axis4;
+		button ButtonL1;
+		button ButtonL2;
+		button ButtonR1;
+		button ButtonR2;
+		button ButtonUp;
+		button ButtonDown;
+		button ButtonLeft;
+		button ButtonRight;
+		button ButtonX;
+		button ButtonB;
+		button ButtonY;
+		button ButtonA;
+		lcd Screen;
+	};
+
+	/**
+	 * @brief V5 Brain, with its screen, SD card, timer and battery
+	 */
+	class brain
+	{
+	public:
+		class lcd
+		{
+		public:
+			void setFont(fontType font);
+			void setPenWidth(uint32_t width);
+			void setPenColor(const color &c);
+			void setFillColor(const color &c);
+			void clearScreen();
+			void clearScreen(const color &c);
+			void setCursor(int32_t row, int32_t col);
+			void print(const char *format, ...);
+			void printAt(int32_t x, int32_t y, const char *format, ...);
+			void newLine();
+			void drawPixel(int x, int y);
+			void drawLine(int x1, int y1, int x2, int y2);
+			void drawRectangle(int x, int y, int width, int height);
+			void drawRectangle(int x, int y, int width, int height, const color &c);
+			void drawCircle(int x, int y, int radius);
+			bool render();
+			bool pressing();
+			int32_t xPosition();
+			int32_t yPosition();
+		};
+
+		class sdcard
+		{
+		public:
+			bool isInserted();
+			int32_t loadfile(const char *name, uint8_t *buffer, int32_t len);
+			int32_t savefile(const char *name, uint8_t *buffer, int32_t len);
+			int32_t appendfile(const char *name, uint8_t *buffer, int32_t len);
+			int32_t size(const char *name);
+			bool exists(const char *name);
+		};
+
+		class battery
+		{
+		public:
+			double voltage(voltageUnits units = voltageUnits::volt);
+			double current(currentUnits units = currentUnits::amp);
+			uint32_t capacity(percentUnits units = percentUnits::pct);
+			double temperature(percentUnits units = percentUnits::pct);
+		};
+
+		lcd Screen;
+		sdcard SDcard;
+		timer Timer;
+		battery Battery;
+	};
+
+	/**
+	 * @brief Competition control, driven by the simulated field controller
+	 */
+	class competition
+	{
+	public:
+		competition();
+
+		void autonomous(void (*callback)(void));
+		void drivercontrol(void (*callback)(void));
+
+		static bool isEnabled();
+		static bool isDriverControl();
+		static bool isAutonomous();
+		static bool isCompetitionSwitch();
+		static bool isFieldControl();
+	};
+} // namespace vex
@@ -0,0 +1,61 @@
+# host simulator build
+#
+# Compiles the robot sources with the host compiler against the mock vex
+# layer in sim/, so the control code can be run and timed off the robot.
+#
+#   make sim       build $(SIM_TARGET)
+#   make sim-run   play a simulated match and print the results
+#   make bench     run the benchmark suite
+#   make sim-libs  build only the host module libraries
+
+SIM_CXX    ?= g++
+SIM_BUILD   = $(BUILD)/sim
+SIM_TARGET  = $(SIM_BUILD)/art_sim
+
+SIM_FLAGS  = -std=gnu++11 -O2 -g -Wall -Wextra -Wno-unused-parameter -Werror=return-type
+SIM_FLAGS += -fno-rtti -fno-exceptions -fno-threadsafe-statics
+SIM_FLAGS += -DART_SIM -DART_ENABLE_PROFILER
+SIM_FLAGS += -Iinclude -Isim/include -Isim/src -MMD -MP
+
+SIM_SRC  = $(SRC_C)
+SIM_SRC += $(wildcard sim/src/*.cpp)
+
+SIM_OBJ  = $(addprefix $(SIM_BUILD)/, $(addsuffix .o, $(basename $(filter %.cpp, $(SIM_SRC)))))
+
+# the simulator provides main(); the robot's own runs as the first task
+$(SIM_BUILD)/src/main.o: SIM_DEFINES = -Dmain=robot_main
+
+$(SIM_OBJ): $(SIM_BUILD)/%.o: %.cpp $(SRC_A) sim/sim.mk
+	$(Q)$(MKDIR)
+	$(ECHO) "HOST CXX $<"
+	$(Q)$(SIM_CXX) $(SIM_FLAGS) $(SIM_DEFINES) -c -o $@ $<
+
+# the same module libraries as the robot build, archived from host objects
+SIM_AR       ?= ar
+SIM_APP_OBJ   = $(call objects,$(SIM_BUILD),$(APP_SRC) $(wildcard sim/src/*.cpp))
+SIM_LIBS      = $(foreach m,$(MODULES),$(SIM_BUILD)/libart_$(m).a)
+
+define SIM_MODULE_RULE
+$$(SIM_BUILD)/libart_$(1).a: $$(call objects,$$(SIM_BUILD),$$(MODULE_$(1)))
+	$$(ECHO) "HOST AR  $$@"
+	$$(Q)$$(SIM_AR) rcs $$@ $$^
+endef
+$(foreach m,$(MODULES),$(eval $(call SIM_MODULE_RULE,$(m))))
+
+$(SIM_TARGET): $(SIM_APP_OBJ) $(SIM_LIBS)
+	$(ECHO) "HOST LINK $@"
+	$(Q)$(SIM_CXX) -o $@ $(SIM_APP_OBJ) -Wl,--start-group $(SIM_LIBS) -Wl,--end-group -lm
+
+sim: $(SIM_TARGET)
+
+sim-libs: $(SIM_LIBS)
+
+sim-run: $(SIM_TARGET)
+	$(Q)$(SIM_TARGET)
+
+bench: $(SIM_TARGET)
+	$(Q)$(SIM_TARGET) --bench
+
+.PHONY: sim sim-libs sim-run bench
+
+-include $(SIM_OBJ:.o=.d)
@@ -0,0 +1,551 @@
+/**
+ * @file bench.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the host benchmark suite
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Each benchmark repeats one piece of per-tick work (or, for the generators,
+ * one piece of pre_auton work) and reports the average host time per call.
+ * The numbers are only meaningful relative to each other and to earlier runs
+ * on the same machine: the V5's Cortex-A9 is many times slower than a
+ * desktop, but the ranking and the effect of a change carry over.
+ */
+
+#include "bench.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "bus.h"
+#include "follower.h"
+#include "fusion.h"
+#include "input.h"
+#include "kernels.h"
+#include "pid.h"
+#include "profiler.h"
+#include "robotConfig.h"
+#include "seqlock.h"
+#include "telemetry.h"
+#include "trajectory.h"
+#include "velocity.h"
+
+namespace sim
+{
+	namespace
+	{
+		/** @brief Somewhere for results to go so the compiler cannot drop the work */
+		volatile float s_sink;
+
+		uint8_t s_scratch[64 * 1024];
+
+		const art::Waypoint kWaypoints[] = {
+			{24.0f, 24.0f, 0.0f},
+			{72.0f, 48.0f, 1.5708f},
+			{48.0f, 96.0f, 3.1416f},
+		};
+
+		art::TrajectoryConstraints constraints()
+		{
+			art::TrajectoryConstraints limits = {
+				DriveConfig.maxVelocity, DriveConfig.maxAccel, 0.0f, DriveConfig.trackWidth, false,
+			};
+			return limits;
+		}
+
+		void report(const char *name, uint64_t elapsedNs, uint32_t iterations)
+		{
+			double perCall = iterations ? (double)elapsedNs / (double)iterations : 0.0;
+			printf("  %-20s %10lu calls %12.1f ns/call\n", name, (unsigned long)iterations, perCall);
+		}
+
+		/**
+		 * @brief Times iterations calls of fn(i)
+		 */
+		template <typename Fn>
+		void bench(const char *name, uint32_t iterations, Fn fn)
+		{
+			uint64_t start = art::profiler::clockNs();
+			for (uint32_t i = 0; i < iterations; i++)
+			{
+				fn(i);
+			}
+			report(name, art::profiler::clockNs() - start, iterations);
+		}
+
+		struct GenerateTrajectory
+		{
+			art::Arena *arena;
+			void operator()(uint32_t)
+			{
+				size_t mark = arena->mark();
+				art::Trajectory trajectory = art::Trajectory::generate(kWaypoints, 3, constraints(), *arena);
+				s_sink = (float)trajectory.count();
+				arena->rewind(mark);
+			}
+		};
+
+		struct ResamplePath
+		{
+			art::Arena *arena;
+			const art::Trajectory *trajectory;
+			void operator()(uint32_t)
+			{
+				size_t mark = arena->mark();
+				art::Path path = art::Path::fromTrajectory(*trajectory, 1.0f, *arena);
+				s_sink = (float)path.size();
+				arena->rewind(mark);
+			}
+		};
+
+		struct SampleTrajectory
+		{
+			const art::Trajectory *trajectory;
+			void operator()(uint32_t i)
+			{
+				art::TrajectoryState state = trajectory->sample((i * 7) % (trajectory->durationMs() + 1));
+				s_sink = state.velocity;
+			}
+		};
+
+		struct FollowPath
+		{
+			art::PurePursuit *follower;
+			const art::Path *path;
+			void operator()(uint32_t i)
+			{
+				// drive the pose along the path, slightly off to one side
+				size_t index = (i / 4) % path->size();
+				if (index == 0 && i % 4 == 0)
+				{
+					follower->begin(*path);
+				}
+				art::Pose pose = {(*path)[index].x + 1.0f, (*path)[index].y - 1.0f, 0.5f};
+				art::DriveCommand command = follower->update(pose);
+				s_sink = command.left;
+			}
+		};
+
+		struct TrackTrajectory
+		{
+			const art::Ramsete *ramsete;
+			const art::Trajectory *trajectory;
+			void operator()(uint32_t i)
+			{
+				art::TrajectoryState target = trajectory->at(i % trajectory->count());
+				art::Pose pose = {target.pose.x + 0.5f, target.pose.y - 0.5f, target.pose.theta + 0.05f};
+				art::DriveCommand command = ramsete->update(pose, target);
+				s_sink = command.right;
+			}
+		};
+
+		/** @brief One odometry update: a prediction and a wall reading on every sensor */
+		struct FuseWalls
+		{
+			art::PoseFilter *filter;
+			void operator()(uint32_t i)
+			{
+				if (i % 1000 == 0)
+				{
+					art::Pose start = {24.0f, 30.0f, 0.0f};
+					filter->reset(start);
+				}
+				filter->predict(0.3f, 0.0f, 0.001f, 0.005f);
+				art::Pose pose = filter->pose();
+				float ranges[kDistanceCount] = {144.0f - pose.y - 6.0f, pose.y - 6.0f, pose.x - 7.0f,
+											 144.0f - pose.x - 8.0f};
+				for (int j = 0; j < kDistanceCount; j++)
+				{
+					filter->correctRange(RobotLayout::kDistanceMounts[j], ranges[j] + 0.1f);
+				}
+				s_sink = filter->pose().x;
+			}
+		};
+
+		struct ShapeAxis
+		{
+			const art::InputCurve *curve;
+			void operator()(uint32_t i)
+			{
+				s_sink = (*curve)((int)(i % 201) - 100);
+			}
+		};
+
+		struct EncodeTelemetry
+		{
+			void operator()(uint32_t i)
+			{
+				art::OdometryState state = {{(float)i * 0.01f, 24.0f, 1.0f}, {10.0f, 2.0f, 0.5f}, i};
+				art::PoseRecord pose = art::PoseRecord::encode(state);
+				art::MotorRecord motors[kMotorCount];
+				for (int m = 0; m < kMotorCount; m++)
+				{
+					motors[m] = art::MotorRecord::encode((uint8_t)m, (float)i, 300.0f, 1.2f, 8.5f, 41.0f);
+				}
+				s_sink = (float)(pose.x + motors[kMotorCount - 1].position);
+			}
+		};
+
+		struct PublishSnapshot
+		{
+			art::Seqlock<DeviceSnapshot> *cell;
+			void operator()(uint32_t i)
+			{
+				DeviceSnapshot snapshot = DeviceSnapshot();
+				snapshot.sequence = i;
+				cell->write(snapshot);
+				s_sink = (float)cell->read().sequence;
+			}
+		};
+
+		const size_t kChannels = 32;
+
+		/**
+		 * @brief Inputs and state shared by the kernel benchmarks
+		 */
+		/** @brief A pose handed from one task to another through a Mailbox */
+		struct PassPose
+		{
+			art::Mailbox<art::OdometryState> *box;
+			void operator()(uint32_t i)
+			{
+				art::OdometryState state = {{(float)i, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, i};
+				box->publish(state);
+				s_sink = box->latest().pose.x;
+			}
+		};
+
+		/** @brief A burst of messages through an SpscQueue and out again */
+		struct PassMessages
+		{
+			art::SpscQueue<uint32_t, 16> *queue;
+			void operator()(uint32_t i)
+			{
+				for (uint32_t j = 0; j < 8; j++)
+				{
+					queue->push(i + j);
+				}
+				uint32_t message = 0;
+				while (queue->pop(message))
+				{
+				}
+				s_sink = (float)message;
+			}
+		};
+
+		struct Channels
+		{
+			float input[kChannels];
+			float state[kChannels];
+			float variance[kChannels];
+			float x[kChannels];
+			float y[kChannels];
+
+			void fill()
+			{
+				for (size_t i = 0; i < kChannels; i++)
+				{
+					input[i] = (float)i * 3.0f - 40.0f;
+					state[i] = 0.0f;
+					variance[i] = 400.0f;
+					x[i] = (float)i;
+					y[i] = 10.0f - (float)i;
+				}
+			}
+		};
+
+		template <bool Vector>
+		struct WheelSpeeds
+		{
+			art::kernels::WheelLayout layout;
+			void operator()(uint32_t i)
+			{
+				float speeds[4];
+				float v = (float)(i & 63);
+				if (Vector)
+				{
+					art::kernels::wheelSpeeds(layout, v, 12.0f, 1.5f, speeds);
+				}
+				else
+				{
+					art::kernels::scalar::wheelSpeeds(layout, v, 12.0f, 1.5f, speeds);
+				}
+				s_sink = speeds[3];
+			}
+		};
+
+		template <bool Vector>
+		struct LowPass
+		{
+			Channels *channels;
+			void operator()(uint32_t)
+			{
+				if (Vector)
+				{
+					art::kernels::lowPass(channels->state, channels->input, 0.2f, kChannels);
+				}
+				else
+				{
+					art::kernels::scalar::lowPass(channels->state, channels->input, 0.2f, kChannels);
+				}
+				s_sink = channels->state[kChannels - 1];
+			}
+		};
+
+		template <bool Vector>
+		struct Kalman
+		{
+			Channels *channels;
+			void operator()(uint32_t)
+			{
+				Channels &c = *channels;
+				if (Vector)
+				{
+					art::kernels::kalman(c.state, c.variance, c.input, 50.0f, 400.0f, kChannels);
+				}
+				else
+				{
+					art::kernels::scalar::kalman(c.state, c.variance, c.input, 50.0f, 400.0f, kChannels);
+				}
+				s_sink = c.state[kChannels - 1];
+			}
+		};
+
+		template <bool Vector>
+		struct Transform
+		{
+			Channels *channels;
+			void operator()(uint32_t i)
+			{
+				Channels &c = *channels;
+				art::Pose frame = {24.0f, 48.0f, (float)(i & 255) * 0.01f};
+				if (Vector)
+				{
+					art::kernels::toFrame(frame, c.x, c.y, c.state, c.variance, kChannels);
+				}
+				else
+				{
+					art::kernels::scalar::toFrame(frame, c.x, c.y, c.state, c.variance, kChannels);
+				}
+				s_sink = c.state[kChannels - 1];
+			}
+		};
+
+		/**
+		 * @brief Largest difference between the kernels and their scalar
+		 * references on the same inputs, after a few hundred steps
+		 */
+		float kernelError()
+		{
+			Channels vector;
+			Channels reference;
+			vector.fill();
+			reference.fill();
+			for (int step = 0; step < 200; step++)
+			{
+				art::kernels::kalman(vector.state, vector.variance, vector.input, 50.0f, 400.0f, kChannels);
+				art::kernels::scalar::kalman(reference.state, reference.variance, reference.input, 50.0f, 400.0f,
+											 kChannels);
+			}
+			art::Pose frame = {24.0f, 48.0f, 0.7f};
+			art::kernels::toField(frame, vector.x, vector.y, vector.x, vector.y, kChannels);
+			art::kernels::scalar::toField(frame, reference.x, reference.y, reference.x, reference.y, kChannels);
+
+			float worst = 0.0f;
+			for (size_t i = 0; i < kChannels; i++)
+			{
+				worst = fmaxf(worst, fabsf(vector.state[i] - reference.state[i]));
+				worst = fmaxf(worst, fabsf(vector.x[i] - reference.x[i]));
+				worst = fmaxf(worst, fabsf(vector.y[i] - reference.y[i]));
+			}
+			return worst;
+		}
+
+		/** @brief A velocity loop in rpm driving volts, like a drive motor's */
+		const art::PidGains kVelocityGains = {0.02f, 0.5f, 0.0005f, 0.3f, 0.019f, 0.0f, 4.0f, 12.0f};
+
+		/**
+		 * @brief Closes a Pid around a first-order motor model
+		 */
+		template <typename Math>
+		struct ControlLoop
+		{
+			typedef typename Math::Value Value;
+
+			art::Pid<Math> *pid;
+			Value speed;
+			Value setpoint;
+			Value response; /**< rpm gained per volt of output, per tick */
+			Value decay;    /**< fraction of speed lost per tick */
+
+			void operator()(uint32_t)
+			{
+				Value output = pid->update(setpoint, speed);
+				speed = speed + response * output - decay * speed;
+				s_sink = Math::toFloat(output);
+			}
+		};
+
+		template <typename Math>
+		ControlLoop<Math> controlLoop(art::Pid<Math> &pid)
+		{
+			ControlLoop<Math> loop = {&pid, Math::make(0.0f), Math::make(400.0f), Math::make(5.3f),
+									  Math::make(0.1f)};
+			return loop;
+		}
+
+		/**
+		 * @brief Largest output difference between the two representations
+		 * over the same five seconds of control
+		 */
+		float pidError()
+		{
+			art::Pid<art::FloatMath> floating(kVelocityGains, 10);
+			art::Pid<art::FixedMath> fixed(kVelocityGains, 10);
+			ControlLoop<art::FloatMath> a = controlLoop(floating);
+			ControlLoop<art::FixedMath> b = controlLoop(fixed);
+			float worst = 0.0f;
+			for (uint32_t i = 0; i < 500; i++)
+			{
+				a(i);
+				float first = s_sink;
+				b(i);
+				worst = fmaxf(worst, fabsf(first - s_sink));
+			}
+			return worst;
+		}
+
+		/**
+		 * @brief Both drive sides as first-order motors, for the velocity
+		 * controller to measure and drive
+		 */
+		struct DriveModel
+		{
+			float speed[2];
+
+			static void measure(float &left, float &right, void *self)
+			{
+				DriveModel &model = *static_cast<DriveModel *>(self);
+				left = model.speed[0];
+				right = model.speed[1];
+			}
+
+			static void output(float left, float right, void *self)
+			{
+				DriveModel &model = *static_cast<DriveModel *>(self);
+				model.speed[0] += 0.8f * left - 0.1f * model.speed[0];
+				model.speed[1] += 0.8f * right - 0.1f * model.speed[1];
+				s_sink = left;
+			}
+		};
+
+		struct VelocityStep
+		{
+			art::VelocityController *controller;
+
+			void operator()(uint32_t i)
+			{
+				// a fresh target each step, so the controller never times out
+				controller->setTarget(30.0f + (float)(i & 15), 30.0f - (float)(i & 15));
+				controller->update();
+			}
+		};
+
+		struct EmptyScope
+		{
+			void operator()(uint32_t)
+			{
+				PROFILE_SCOPE("bench scope");
+			}
+		};
+	} // namespace
+
+	void runBenchmarks(uint32_t iterations)
+	{
+		art::Arena arena(s_scratch, sizeof(s_scratch));
+		art::Trajectory trajectory = art::Trajectory::generate(kWaypoints, 3, constraints(), arena);
+		art::Path path = art::Path::fromTrajectory(trajectory, 1.0f, arena);
+		if (!trajectory.valid() || !path.valid())
+		{
+			printf("benchmark set-up failed: scratch arena too small\n");
+			return;
+		}
+
+		art::PursuitConfig pursuit = {12.0f, DriveConfig.trackWidth, 6.0f, 1.0f, 0};
+		art::PurePursuit follower(pursuit);
+		art::RamseteConfig gains = {2.0f * 0.0254f * 0.0254f, 0.7f, DriveConfig.trackWidth};
+		art::Ramsete ramsete(gains);
+		art::InputCurve curve(5, 3.0f);
+		art::PoseFilter filter(FusionSettings);
+		static art::Seqlock<DeviceSnapshot> cell;
+		static art::Mailbox<art::OdometryState> box;
+		static art::SpscQueue<uint32_t, 16> queue;
+
+		printf("benchmarks, host clock:\n");
+		GenerateTrajectory generate = {&arena};
+		bench("trajectory generate", iterations / 1000 + 1, generate);
+		ResamplePath resample = {&arena, &trajectory};
+		bench("path resample", iterations / 100 + 1, resample);
+		SampleTrajectory sample = {&trajectory};
+		bench("trajectory sample", iterations, sample);
+		FollowPath follow = {&follower, &path};
+		bench("pure pursuit update", iterations, follow);
+		TrackTrajectory track = {&ramsete, &trajectory};
+		bench("ramsete update", iterations, track);
+		FuseWalls fuse = {&filter};
+		bench("fusion update", iterations, fuse);
+		ShapeAxis shape = {&curve};
+		bench("input curve", iterations, shape);
+		EncodeTelemetry encode;
+		bench("telemetry encode", iterations, encode);
+		PublishSnapshot publish = {&cell};
+		bench("snapshot publish", iterations, publish);
+		PassPose pass = {&box};
+		bench("mailbox pose", iterations, pass);
+		PassMessages messages = {&queue};
+		bench("queue 8 messages", iterations, messages);
+		EmptyScope scope;
+		bench("empty PROFILE_SCOPE", iterations, scope);
+
+		printf("math kernels, %s against scalar, %lu channels:\n",
+			   art::kernels::vectorized() ? "NEON" : "no NEON in this build, scalar", (unsigned long)kChannels);
+		Channels channels;
+		channels.fill();
+		WheelSpeeds<true> wheels = {art::kernels::mecanumLayout(15.0f, 12.0f)};
+		bench("wheel speeds", iterations, wheels);
+		WheelSpeeds<false> scalarWheels = {wheels.layout};
+		bench("  scalar", iterations, scalarWheels);
+		LowPass<true> lowPass = {&channels};
+		bench("low-pass", iterations, lowPass);
+		LowPass<false> scalarLowPass = {&channels};
+		bench("  scalar", iterations, scalarLowPass);
+		Kalman<true> kalman = {&channels};
+		bench("kalman", iterations, kalman);
+		Kalman<false> scalarKalman = {&channels};
+		bench("  scalar", iterations, scalarKalman);
+		Transform<true> transform = {&channels};
+		bench("pose transform", iterations, transform);
+		Transform<false> scalarTransform = {&channels};
+		bench("  scalar", iterations, scalarTransform);
+		printf("  largest kernel difference from scalar: %g\n", kernelError());
+
+		printf("controllers, float against Q16.16:\n");
+		art::Pid<art::FloatMath> floatPid(kVelocityGains, 10);
+		art::Pid<art::FixedMath> fixedPid(kVelocityGains, 10);
+		ControlLoop<art::FloatMath> floatLoop = controlLoop(floatPid);
+		bench("pid float", iterations, floatLoop);
+		ControlLoop<art::FixedMath> fixedLoop = controlLoop(fixedPid);
+		bench("pid fixed", iterations, fixedLoop);
+		printf("  largest output difference: %g V\n", pidError());
+
+		DriveModel model = {{0.0f, 0.0f}};
+		art::VelocityController controller(WheelSpeedGains);
+		controller.setMeasure(DriveModel::measure, &model);
+		controller.setOutput(DriveModel::output, &model);
+		VelocityStep velocity = {&controller};
+		bench("velocity update", iterations, velocity);
+	}
+} // namespace sim
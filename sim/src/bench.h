@@ -0,0 +1,24 @@
+/**
+ * @file bench.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring the host benchmark suite
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace sim
+{
+	/**
+	 * @brief Times each subsystem's per-tick work in isolation and prints the
+	 * cost per call
+	 *
+	 * @param iterations calls timed per benchmark; the slow ones use fewer
+	 */
+	void runBenchmarks(uint32_t iterations);
+} // namespace sim
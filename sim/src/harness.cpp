@@ -0,0 +1,869 @@
+/**
+ * @file harness.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Entry point of the host simulator: plays a match against the robot
+ * code, or runs the benchmark suite
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The robot's own main() is compiled as robot_main() and started as the first
+ * vex::task, exactly as the V5 would. The harness then acts as the field
+ * controller and the driver: a few seconds of pre_auton, the 15 second
+ * autonomous period, a short disable, then usercontrol with scripted stick
+ * and button input. At the end it prints how well odometry kept up with the
+ * true pose, how the scheduler loops held their period, and the profiler's
+ * per-section CPU cost measured on the host clock.
+ *
+ * If the SD directory has no routes.bin, an example with two routes is
+ * written there first (see @ref route_format). --auton picks the routine
+ * as if the selector had been touched that many times.
+ *
+ * The simulated sensors are not perfect: the tracking wheels read 0.5% long
+ * and the inertial sensor drifts by 1.2 degrees a minute, about what real
+ * ones do. --no-walls unplugs the distance sensors, to see how far the
+ * odometry drifts without their corrections.
+ *
+ * Every 12 seconds of usercontrol the driver lets go of the turn stick for
+ * two seconds, then holds L1 for two more, and the harness measures how far
+ * the heading carries on after the release and how well the robot ends up
+ * aimed at the goal. --no-assist turns the driver assist off for comparison.
+ *
+ * Field control switches to autonomous three seconds after power-on, by
+ * which time startup has long finished. --pre-auton shortens that, to see
+ * autonomous wait for the startup stages it needs.
+ *
+ * --tune name=value sends the value over the tuning link just before
+ * autonomous, as a laptop on the USB port would, after asking for the list of
+ * entries; it can be given up to eight times. The harness then reports what
+ * the link answered. Edits are saved to the SD directory's params.bin, and
+ * every later run there starts from them.
+ *
+ * --hog ms adds a task that keeps the CPU to itself for that long every
+ * 100 ms from autonomous on, like a runaway computation would, to see the
+ * task watchdog notice the late control loops and shed the screen and log.
+ *
+ * The simulated field has only its walls. --obstacle x,y puts a robot-sized
+ * round obstacle there, up to four of them, for the distance sensors to find
+ * and autonomous to drive around; the report then says how many detours
+ * were planned and how often the robot ran into one anyway. On the built-in
+ * route, --obstacle 76,104 is passed by a detour that finishes at the goal,
+ * and --obstacle 60,90 sits on the goal itself: the robot stops short of it,
+ * waits, then gives up on the path, and the routine fails there without
+ * scoring. The report says whether the routine gave up and for how long the
+ * intake ran afterwards; --expect-blocked makes the run exit with 1 unless it
+ * gave up and the intake stayed off, so that such a case can be checked by a
+ * script.
+ *
+ * --replay file plays a recorded match log back instead (see replay.h): the
+ * devices and the controller read what was recorded, each period starts
+ * when the recording says it did, and the autonomous routine is picked by
+ * name. The log the replay writes is then compared with the recording,
+ * which shows whether a change to the control code makes it act differently
+ * on the same match. Logs from the Brain's SD card replay the same way,
+ * given the SD directory they were recorded with for the routes and tuning.
+ * --tune and --no-assist apply to a replay too, to see what they change.
+ *
+ * Usage: art_sim [--bench [iterations]] [--driver seconds] [--sd directory]
+ *                [--auton index] [--no-walls] [--pre-auton seconds] [--no-assist]
+ *                [--tune name=value]... [--hog ms] [--obstacle x,y]... [--expect-blocked]
+ *                [--replay file]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "bench.h"
+#include "replay.h"
+#include "sim.h"
+
+#include "assist.h"
+#include "command.h"
+#include "display.h"
+#include "fieldMap.h"
+#include "params.h"
+#include "profiler.h"
+#include "replan.h"
+#include "robotConfig.h"
+#include "routes.h"
+#include "scheduler.h"
+#include "startup.h"
+#include "telemetry.h"
+#include "tuneLink.h"
+#include "watchdog.h"
+
+int robot_main();
+
+extern art::Scheduler AutonLoop;
+extern art::Scheduler DriverLoop;
+extern art::AutonSelector AutonChoice;
+extern art::Startup RobotStartup;
+extern art::DriveAssist DriverAssist;
+extern art::TuneLink TuneSerial;
+extern art::Watchdog TaskWatchdog;
+extern art::FieldMap AutonMap;
+extern art::Replanner RouteReplanner;
+extern art::Command *AutonRoutine;
+
+namespace
+{
+	const uint64_t kAutonomousUs = 15000000;
+	const uint64_t kDisabledUs = 1000000;
+	const uint64_t kStepUs = 10000;
+	const uint64_t kHogPeriodUs = 100000;
+	const uint64_t kFlushUs = 1500000; /**< long enough after a match for MatchLog to write out its buffers */
+	const double kObstacleRadius = 9.0; /**< inches, about half another robot */
+	const sim::Pose kStart = {24.0, 24.0, 0.0};
+
+	struct Options
+	{
+		bool bench;
+		uint32_t iterations;
+		double driverSeconds;
+		const char *sdRoot;
+		uint32_t auton;
+		bool walls;
+		double preAutonSeconds;
+		bool assist;
+		const char *tunes[8]; /**< name=value edits for the tuning link */
+		uint32_t tuneCount;
+		const char *replay;   /**< match log to replay, or NULL to simulate */
+		double hogMs;         /**< CPU time taken by the hog task every kHogPeriodUs */
+		double obstacles[4][2]; /**< x, y of each --obstacle, inches */
+		uint32_t obstacleCount;
+		bool expectBlocked;   /**< fail the run unless autonomous gave up at a block */
+	};
+
+	/** @brief Worst odometry error and driver assist results while the match ran */
+	struct Tracking
+	{
+		double worstPosition;
+		double worstHeading;
+		double releaseHeading; /**< true heading when the turn stick was last let go */
+		double worstCarry;     /**< largest heading change after letting go */
+		double aimError;       /**< summed over aimSamples */
+		double worstAimError;
+		uint32_t aimSamples;
+		bool gaveUp;            /**< the autonomous routine finished failed() */
+		uint32_t intakeAfterMs; /**< how long the intake was driven in autonomous after that */
+		double intakeVolts;     /**< intake voltage at the last step of autonomous */
+	};
+
+	/** @brief Usercontrol script cycle, how long it lets go of the turn stick, and aims */
+	const double kCycleSeconds = 12.0;
+	const double kReleaseAt = 6.0;
+	const double kAimAt = 8.0;
+	const double kAimUntil = 10.0;
+	const double kGoal[2] = {120.0, 120.0};
+
+	/** @brief Builds a route file in memory, the way a route editor would */
+	class RouteWriter
+	{
+	public:
+		RouteWriter() : m_size(16), m_routes(0) {}
+
+		void route(const char *name, uint16_t maxVelocity, uint8_t flags)
+		{
+			m_route = m_size;
+			char padded[16] = {0};
+			strncpy(padded, name, sizeof(padded) - 1);
+			bytes(padded, sizeof(padded));
+			u16(maxVelocity);
+			u16(0);
+			u8(0);
+			u8(0);
+			u8(flags);
+			u8(0);
+			m_routes++;
+		}
+
+		void waypoint(double x, double y, double theta)
+		{
+			u16((uint16_t)(int16_t)lround(x * 64.0));
+			u16((uint16_t)(int16_t)lround(y * 64.0));
+			u16((uint16_t)(int16_t)lround(theta * 32768.0 / 3.14159265358979));
+			m_data[m_route + 20]++;
+		}
+
+		void action(uint8_t type, int16_t value, double at, uint16_t durationMs)
+		{
+			u8(type);
+			u8(0);
+			u16((uint16_t)value);
+			u16(at < 0.0 ? art::kRouteAtEnd : (uint16_t)lround(at * 16.0));
+			u16(durationMs);
+			m_data[m_route + 21]++;
+		}
+
+		bool save(const char *path)
+		{
+			uint32_t hash = 2166136261u;
+			for (size_t i = 16; i < m_size; i++)
+			{
+				hash = (hash ^ m_data[i]) * 16777619u;
+			}
+			size_t size = m_size;
+			m_size = 0;
+			bytes("ARTR", 4);
+			u16(1);
+			u16(m_routes);
+			u32((uint32_t)size);
+			u32(hash);
+			FILE *f = fopen(path, "wb");
+			bool ok = f && fwrite(m_data, 1, size, f) == size;
+			if (f)
+			{
+				fclose(f);
+			}
+			return ok;
+		}
+
+	private:
+		void bytes(const void *data, size_t n)
+		{
+			memcpy(m_data + m_size, data, n);
+			m_size += n;
+		}
+		void u8(uint8_t v) { m_data[m_size++] = v; }
+		void u16(uint16_t v)
+		{
+			u8((uint8_t)v);
+			u8((uint8_t)(v >> 8));
+		}
+		void u32(uint32_t v)
+		{
+			u16((uint16_t)v);
+			u16((uint16_t)(v >> 16));
+		}
+
+		uint8_t m_data[1024];
+		size_t m_size;
+		size_t m_route;
+		uint16_t m_routes;
+	};
+
+	/**
+	 * @brief Writes two example routes starting at kStart: a sweep to the far
+	 * side collecting on the way, and a short hop at a reduced speed limit
+	 */
+	void writeExampleRoutes(const char *sdRoot)
+	{
+		char path[512];
+		snprintf(path, sizeof(path), "%s/routes.bin", sdRoot);
+		FILE *existing = fopen(path, "rb");
+		if (existing)
+		{
+			fclose(existing);
+			return;
+		}
+
+		RouteWriter writer;
+		writer.route("Sweep", 0, 0);
+		writer.waypoint(24.0, 24.0, 0.0);
+		writer.waypoint(96.0, 30.0, 0.5);
+		writer.waypoint(110.0, 84.0, 1.5708);
+		writer.action(art::kRouteIntake, 12000, 12.0, 0);
+		writer.action(art::kRouteIntake, 0, 70.0, 0);
+		writer.action(art::kRouteWait, 0, -1.0, 250);
+		writer.action(art::kRouteIntake, -12000, -1.0, 750);
+
+		writer.route("Slow", 24 * 16, 0);
+		writer.waypoint(24.0, 24.0, 0.0);
+		writer.waypoint(60.0, 40.0, 0.6);
+		writer.action(art::kRouteIntake, -12000, -1.0, 500);
+
+		writer.save(path);
+	}
+
+	int robotTask(void *)
+	{
+		robot_main();
+		return 0;
+	}
+
+	/** @brief Keeps the CPU for *(double *)ms milliseconds every kHogPeriodUs */
+	int hogTask(void *ms)
+	{
+		uint64_t busyUs = (uint64_t)(*static_cast<double *>(ms) * 1000.0);
+		while (true)
+		{
+			sim::busy(busyUs);
+			sim::sleepUntilUs(sim::nowUs() + kHogPeriodUs - (busyUs < kHogPeriodUs ? busyUs : 0));
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief The simulated robot, built from RobotLayout and the geometry in
+	 * robotConfig.cpp
+	 */
+	sim::RobotModel robotModel(bool walls)
+	{
+		sim::RobotModel model;
+		memset(&model, 0, sizeof(model));
+		for (int i = 0; i < 4; i++)
+		{
+			model.leftPorts[i] = -1;
+			model.rightPorts[i] = -1;
+			model.distancePorts[i] = -1;
+		}
+		int left = 0;
+		int right = 0;
+		for (int i = 0; i < kMotorCount && left < 4 && right < 4; i++)
+		{
+			if (Motors.inGroup(i, kLeftDrive))
+			{
+				model.leftPorts[left++] = Motors.spec(i).port;
+			}
+			else if (Motors.inGroup(i, kRightDrive))
+			{
+				model.rightPorts[right++] = Motors.spec(i).port;
+			}
+		}
+		model.motorsPerSide = left;
+		model.wheelDiameter = DriveConfig.wheelDiameter;
+		model.driveRatio = DriveConfig.gearRatio;
+		model.trackWidth = DriveConfig.trackWidth;
+		model.massKg = 6.0;
+		model.forwardTracker = RobotLayout::kForwardTrackerPort;
+		model.forwardOffset = OdomConfig.forwardOffset;
+		model.sidewaysTracker = RobotLayout::kSidewaysTrackerPort;
+		model.sidewaysOffset = OdomConfig.sidewaysOffset;
+		model.trackerDiameter = OdomConfig.trackerDiameter;
+		model.imuPort = RobotLayout::kImuPort;
+		for (int i = 0; i < kDistanceCount && walls; i++)
+		{
+			model.distancePorts[i] = RobotLayout::kDistancePorts[i];
+			model.distanceMount[i][0] = RobotLayout::kDistanceMounts[i].forward;
+			model.distanceMount[i][1] = RobotLayout::kDistanceMounts[i].left;
+			model.distanceMount[i][2] = RobotLayout::kDistanceMounts[i].angle;
+		}
+		model.imuDriftDps = 0.02;
+		model.trackerScale = 1.005;
+		return model;
+	}
+
+	/**
+	 * @brief Stick and button input for usercontrol, as a function of time
+	 *
+	 * Sweeps forward and turn at different rates so the drive covers a good
+	 * mix of speeds, and taps R1 every few seconds to exercise the input
+	 * handlers. Part of each cycle it lets go of the turn stick, then aims.
+	 */
+	void drive(double seconds)
+	{
+		sim::ControllerState &pad = sim::controller();
+		double cycle = fmod(seconds, kCycleSeconds);
+		bool steering = cycle < kReleaseAt || cycle >= kAimUntil;
+		pad.axis[2] = (int32_t)(110.0 * sin(seconds * 0.7));
+		pad.axis[0] = steering ? (int32_t)(60.0 * sin(seconds * 1.9)) : 0;
+		bool tap = fmod(seconds, 4.0) < 0.1;
+		pad.buttons = tap ? 1u << art::kButtonR1 : 0;
+		if (cycle >= kAimAt && cycle < kAimUntil)
+		{
+			pad.buttons |= 1u << art::kButtonL1;
+		}
+	}
+
+	/** @brief Measures the heading after letting go of the stick, and the aim at the end of aiming */
+	void assess(double seconds, Tracking &tracking)
+	{
+		const sim::Pose &truth = sim::truth();
+		double cycle = fmod(seconds, kCycleSeconds);
+		if (cycle >= kReleaseAt && cycle < kReleaseAt + kStepUs * 1e-6)
+		{
+			tracking.releaseHeading = truth.theta;
+		}
+		else if (cycle > kReleaseAt && cycle < kAimAt)
+		{
+			double carry = fabs(art::wrapAngle((float)(truth.theta - tracking.releaseHeading)));
+			tracking.worstCarry = fmax(tracking.worstCarry, carry);
+		}
+		else if (cycle >= kAimUntil - 0.5 && cycle < kAimUntil &&
+				 hypot(kGoal[0] - truth.x, kGoal[1] - truth.y) > AssistSettings.aimMinRange)
+		{
+			double bearing = atan2(kGoal[1] - truth.y, kGoal[0] - truth.x);
+			double error = fabs(art::wrapAngle((float)(bearing - truth.theta)));
+			tracking.aimError += error;
+			tracking.worstAimError = fmax(tracking.worstAimError, error);
+			tracking.aimSamples++;
+		}
+	}
+
+	void track(Tracking &tracking)
+	{
+		const sim::Pose &truth = sim::truth();
+		art::Pose estimate = Odom.pose();
+		double position = hypot(estimate.x - truth.x, estimate.y - truth.y);
+		double heading = fabs(art::wrapAngle((float)(estimate.theta - truth.theta)));
+		tracking.worstPosition = fmax(tracking.worstPosition, position);
+		tracking.worstHeading = fmax(tracking.worstHeading, heading);
+	}
+
+	/**
+	 * @brief Notes whether the autonomous routine has given up, and whether
+	 * the intake has been driven since
+	 *
+	 * The limiter takes a few steps to bring the intake down from what it was
+	 * doing at the time, so only steps where its voltage grows count.
+	 */
+	void watchRoutine(Tracking &tracking)
+	{
+		double volts = fabs(sim::motor(RobotLayout::kMotors[kIntake].port).commandVolts);
+		tracking.gaveUp = AutonRoutine && AutonRoutine->failed();
+		if (tracking.gaveUp && volts > 0.01 && volts >= tracking.intakeVolts)
+		{
+			tracking.intakeAfterMs += (uint32_t)(kStepUs / 1000);
+		}
+		tracking.intakeVolts = volts;
+	}
+
+	/**
+	 * @brief Advances the match to untilUs
+	 *
+	 * @param tracking where to record odometry error, NULL before odometry
+	 * has been given the starting pose
+	 * @param driverStartUs when usercontrol began, 0 while nobody is driving
+	 */
+	void run(uint64_t untilUs, Tracking *tracking, uint64_t driverStartUs)
+	{
+		while (sim::nowUs() < untilUs)
+		{
+			if (driverStartUs)
+			{
+				drive((double)(sim::nowUs() - driverStartUs) * 1e-6);
+			}
+			sim::runUntil(sim::nowUs() + kStepUs);
+			if (tracking)
+			{
+				track(*tracking);
+			}
+			if (tracking && !driverStartUs && sim::phase() == sim::kAutonomous)
+			{
+				watchRoutine(*tracking);
+			}
+			if (tracking && driverStartUs)
+			{
+				assess((double)(sim::nowUs() - driverStartUs) * 1e-6, *tracking);
+			}
+		}
+	}
+
+	void printPose(const char *when)
+	{
+		const sim::Pose &truth = sim::truth();
+		art::Pose estimate = Odom.pose();
+		printf("%-16s truth %7.2f %7.2f %7.3f   odometry %7.2f %7.2f %7.3f\n", when, truth.x, truth.y, truth.theta,
+			   estimate.x, estimate.y, estimate.theta);
+	}
+
+	void printLoop(const char *label, const art::Scheduler &loop)
+	{
+		printf("%s: %lu loops, %lu overruns\n", label, (unsigned long)loop.loops(), (unsigned long)loop.overruns());
+		for (int h = 0; h < loop.count(); h++)
+		{
+			const art::TaskStats &stats = loop.stats(h);
+			printf("  %-10s %6lu runs %4lu late %4lu skipped, worst latency %6lu us\n", loop.name(h),
+				   (unsigned long)stats.runs, (unsigned long)stats.overruns, (unsigned long)stats.skipped,
+				   (unsigned long)stats.worstLatencyUs);
+		}
+	}
+
+	void printWatchdog()
+	{
+		printf("watchdog: shed level %d now, %lu level changes\n", TaskWatchdog.level(),
+			   (unsigned long)TaskWatchdog.levelChanges());
+		for (int i = 0; i < TaskWatchdog.count(); i++)
+		{
+			art::WatchStats stats = TaskWatchdog.stats(i);
+			printf("  %-10s %6lu check-ins %4lu late %3lu stalls, worst gap %7lu us\n", TaskWatchdog.name(i),
+				   (unsigned long)stats.checkIns, (unsigned long)stats.misses, (unsigned long)stats.stalls,
+				   (unsigned long)stats.worstGapUs);
+		}
+	}
+
+	void printStartup()
+	{
+		static const char *const kStates[] = {"pending", "running", "done", "failed"};
+		printf("startup stages:\n");
+		for (int i = 0; i < RobotStartup.count(); i++)
+		{
+			printf("  %-10s %-7s %6lu ms to %6lu ms\n", RobotStartup.name(i), kStates[RobotStartup.state(i)],
+				   (unsigned long)(RobotStartup.startedUs(i) / 1000), (unsigned long)(RobotStartup.finishedUs(i) / 1000));
+		}
+	}
+
+	void printProfile()
+	{
+		printf("CPU cost per section, host clock:\n");
+		printf("  %-12s %8s %9s %9s %9s %9s\n", "section", "count", "min ns", "avg ns", "p99 ns", "max ns");
+		for (size_t i = 0; i < art::profiler::count(); i++)
+		{
+			art::profiler::SectionStats s = art::profiler::stats(i);
+			printf("  %-12s %8lu %9lu %9lu %9lu %9lu\n", s.name, (unsigned long)s.count, (unsigned long)s.minNs,
+				   (unsigned long)s.avgNs, (unsigned long)s.p99Ns, (unsigned long)s.maxNs);
+		}
+	}
+
+	/** @brief Queues one tuning request on the robot's serial port */
+	void sendTune(uint8_t type, const uint8_t *payload, uint8_t length)
+	{
+		uint8_t frame[4 + 255] = {art::TuneLink::kSync, type, length, 0};
+		uint32_t sum = type + length;
+		for (uint8_t i = 0; i < length; i++)
+		{
+			frame[4 + i] = payload[i];
+			sum += payload[i];
+		}
+		frame[3] = (uint8_t)sum;
+		sim::serialFeed(frame, 4u + length);
+	}
+
+	/**
+	 * @brief Asks for the list of entries, then sends each name=value edit
+	 * and asks for them to be saved
+	 */
+	void sendTunes(const Options &options)
+	{
+		if (options.tuneCount == 0)
+		{
+			return;
+		}
+		sendTune(art::kTuneList, NULL, 0);
+		for (uint32_t i = 0; i < options.tuneCount; i++)
+		{
+			char name[art::ParamRegistry::kNameLength] = {0};
+			const char *equals = strchr(options.tunes[i], '=');
+			size_t length = equals ? (size_t)(equals - options.tunes[i]) : 0;
+			memcpy(name, options.tunes[i], length < sizeof(name) - 1 ? length : sizeof(name) - 1);
+			int index = art::Params.find(name);
+			if (!equals || index < 0)
+			{
+				printf("tuning: no entry called %s\n", name);
+				continue;
+			}
+			uint8_t payload[8] = {(uint8_t)index, 0, 0, 0};
+			float value = (float)atof(equals + 1);
+			memcpy(payload + 4, &value, sizeof(value));
+			sendTune(art::kTuneSet, payload, sizeof(payload));
+		}
+		sendTune(art::kTuneSave, NULL, 0);
+	}
+
+	/** @brief Decodes what the robot answered on the tuning link */
+	void printTuning()
+	{
+		uint32_t infos = 0, values = 0, saved = 0, errors = 0;
+		uint8_t out[8192];
+		uint32_t size = sim::serialTake(out, sizeof(out));
+		for (uint32_t at = 0; at + 4 <= size && out[at] == art::TuneLink::kSync; at += 4u + out[at + 2])
+		{
+			const uint8_t *payload = out + at + 4;
+			switch (out[at + 1])
+			{
+			case art::kTuneInfo:
+				infos++;
+				break;
+			case art::kTuneValue:
+			{
+				float value;
+				memcpy(&value, payload + 4, sizeof(value));
+				printf("tuning: %s set to %g\n", art::Params.name(payload[0]), value);
+				values++;
+				break;
+			}
+			case art::kTuneSaved:
+				saved++;
+				break;
+			case art::kTuneError:
+				printf("tuning: request %02x for entry %u refused, reason %u\n", payload[0], payload[1], payload[2]);
+				errors++;
+				break;
+			}
+		}
+		printf("tuning: %lu entries, %lu loaded, %lu applied, %lu saves; link %lu requests, %lu listed, "
+			   "%lu set, %lu saved, %lu refused\n",
+			   (unsigned long)art::Params.size(), (unsigned long)art::Params.loaded(),
+			   (unsigned long)art::Params.applied(), (unsigned long)art::Params.saves(),
+			   (unsigned long)TuneSerial.requests(), (unsigned long)infos, (unsigned long)values,
+			   (unsigned long)saved, (unsigned long)errors);
+	}
+
+	int playMatch(const Options &options)
+	{
+		mkdir(options.sdRoot, 0755);
+		sim::setSdRoot(options.sdRoot);
+		writeExampleRoutes(options.sdRoot);
+		sim::configure(robotModel(options.walls), kStart);
+		for (uint32_t i = 0; i < options.obstacleCount; i++)
+		{
+			sim::addObstacle(options.obstacles[i][0], options.obstacles[i][1], kObstacleRadius);
+		}
+		sim::spawn(robotTask, NULL, vex::task::taskPriorityNormal);
+
+		Tracking tracking;
+		memset(&tracking, 0, sizeof(tracking));
+		DriverAssist.setEnabled(options.assist);
+		uint64_t autonStartUs = (uint64_t)(options.preAutonSeconds * 1e6);
+		uint64_t driverStartUs = autonStartUs + kAutonomousUs + kDisabledUs;
+		uint64_t endUs = driverStartUs + (uint64_t)(options.driverSeconds * 1e6);
+
+		run(autonStartUs, NULL, 0);
+		sendTunes(options);
+		for (uint32_t i = 0; i < options.auton; i++)
+		{
+			AutonChoice.touch(0, 0);
+		}
+		printf("autonomous routine: %s\n", AutonChoice.selectedName());
+		static double hogMs = options.hogMs;
+		if (hogMs > 0.0)
+		{
+			sim::spawn(hogTask, &hogMs, vex::task::taskPriorityNormal);
+		}
+		sim::setPhase(sim::kAutonomous, true);
+		run(autonStartUs + kAutonomousUs, &tracking, 0);
+		printPose("autonomous end");
+		printf("autonomous routine %s, intake ran %lu ms after\n", tracking.gaveUp ? "gave up" : "did not give up",
+			   (unsigned long)tracking.intakeAfterMs);
+
+		sim::setPhase(sim::kDisabled, true);
+		run(driverStartUs, &tracking, 0);
+		sim::setPhase(sim::kDriver, true);
+		run(endUs, &tracking, driverStartUs);
+		printPose("match end");
+		sim::setPhase(sim::kDisabled, true);
+		run(endUs + kFlushUs, NULL, 0);
+
+		printStartup();
+		printTuning();
+		printf("odometry worst error: %.2f in, %.2f deg\n", tracking.worstPosition,
+			   tracking.worstHeading * 180.0 / 3.14159265358979);
+		printf("driver assist %s: heading carried %.1f deg after letting go, aim error %.1f deg average, "
+			   "%.1f deg worst, stick to wheels %lu us worst\n",
+			   options.assist ? "on" : "off", tracking.worstCarry * 180.0 / 3.14159265358979,
+			   tracking.aimSamples ? tracking.aimError / tracking.aimSamples * 180.0 / 3.14159265358979 : 0.0,
+			   tracking.worstAimError * 180.0 / 3.14159265358979, (unsigned long)DriverAssist.worstLatencyUs());
+		printf("wall corrections: %lu used, %lu rejected\n", (unsigned long)Odom.filter().accepted(),
+			   (unsigned long)Odom.filter().rejected());
+		printf("replanner: %lu detours, %lu blocked, %lu out of memory; map %lu marks; obstacle contacts %lu\n",
+			   (unsigned long)RouteReplanner.replans(), (unsigned long)RouteReplanner.failures(),
+			   (unsigned long)RouteReplanner.outOfMemory(),
+			   (unsigned long)AutonMap.marks(), (unsigned long)sim::obstacleContacts());
+		printLoop("AutonLoop", AutonLoop);
+		printLoop("DriverLoop", DriverLoop);
+		printWatchdog();
+		printf("limiter: %lu ticks derated, drive budget %.2f now\n", (unsigned long)Limiter.limitedTicks(),
+			   Limiter.budgetScale());
+		printf("telemetry %s: %lu frames, %lu dropped, %lu bytes, %lu write errors\n", art::MatchLog.fileName(),
+			   (unsigned long)art::MatchLog.frames(), (unsigned long)art::MatchLog.dropped(),
+			   (unsigned long)art::MatchLog.bytesWritten(), (unsigned long)art::MatchLog.writeErrors());
+		printf("screen: %lu frames, %lu widgets drawn, %llu pixels\n", (unsigned long)art::BrainDisplay.frames(),
+			   (unsigned long)art::BrainDisplay.widgetsDrawn(), (unsigned long long)sim::screen().pixels);
+		printProfile();
+		return options.expectBlocked && (!tracking.gaveUp || tracking.intakeAfterMs) ? 1 : 0;
+	}
+
+	/** @brief The ports of the devices a match log records, from RobotLayout */
+	sim::ReplayPorts replayPorts()
+	{
+		sim::ReplayPorts ports;
+		memset(&ports, 0, sizeof(ports));
+		for (int i = 0; i < kMotorCount && i < sim::kPorts; i++)
+		{
+			ports.motors[i] = Motors.spec(i).port;
+		}
+		ports.motorCount = kMotorCount < sim::kPorts ? kMotorCount : sim::kPorts;
+		ports.forwardTracker = RobotLayout::kForwardTrackerPort;
+		ports.sidewaysTracker = RobotLayout::kSidewaysTrackerPort;
+		ports.imu = RobotLayout::kImuPort;
+		for (int i = 0; i < 4; i++)
+		{
+			ports.distance[i] = i < kDistanceCount ? RobotLayout::kDistancePorts[i] : -1;
+		}
+		return ports;
+	}
+
+	/** @brief Touches the selector until it shows routine; false if it never does */
+	bool selectRoutine(const char *routine)
+	{
+		for (int touches = 0; touches < 64; touches++)
+		{
+			if (strcmp(AutonChoice.selectedName(), routine) == 0)
+			{
+				return true;
+			}
+			AutonChoice.touch(0, 0);
+		}
+		return false;
+	}
+
+	int replayMatch(const Options &options)
+	{
+		mkdir(options.sdRoot, 0755);
+		sim::setSdRoot(options.sdRoot);
+		if (!sim::loadReplay(options.replay, replayPorts()))
+		{
+			fprintf(stderr, "%s: not a match log with sensor samples\n", options.replay);
+			return 1;
+		}
+		sim::spawn(robotTask, NULL, vex::task::taskPriorityNormal);
+		DriverAssist.setEnabled(options.assist);
+
+		uint64_t startNs = art::profiler::clockNs();
+		for (size_t i = 0; i < sim::replayPhases(); i++)
+		{
+			const sim::ReplayPhase &phase = sim::replayPhase(i);
+			sim::runUntil(phase.startUs);
+			if (i == 0)
+			{
+				sendTunes(options);
+			}
+			if (phase.phase == sim::kAutonomous)
+			{
+				bool found = selectRoutine(phase.routine);
+				printf("autonomous routine: %s%s\n", AutonChoice.selectedName(), found ? "" : " (recorded one not found)");
+			}
+			sim::setPhase(phase.phase, true);
+			sim::runUntil(phase.endUs);
+			sim::setPhase(sim::kDisabled, true);
+			art::Pose estimate = Odom.pose();
+			printf("%-16s odometry %7.2f %7.2f %7.3f\n", phase.phase == sim::kAutonomous ? "autonomous end" : "match end",
+				   estimate.x, estimate.y, estimate.theta);
+		}
+		uint64_t endUs = sim::nowUs() + kFlushUs;
+		sim::runUntil(endUs);
+		double hostSeconds = (art::profiler::clockNs() - startNs) * 1e-9;
+
+		char path[512];
+		snprintf(path, sizeof(path), "%s/%s", options.sdRoot, art::MatchLog.fileName());
+		sim::ReplayDiff diff;
+		if (!sim::compareReplay(path, diff))
+		{
+			fprintf(stderr, "%s: cannot read the replay's log\n", path);
+			return 1;
+		}
+		printf("replayed %s: %lu periods, %lu bytes skipped, %.1f s of match in %.2f s, %.0fx real time\n",
+			   options.replay, (unsigned long)sim::replayPhases(), (unsigned long)sim::replaySkipped(), endUs * 1e-6,
+			   hostSeconds, hostSeconds > 0.0 ? endUs * 1e-6 / hostSeconds : 0.0);
+		printf("against the recording, logged as %s:\n", art::MatchLog.fileName());
+		printf("  pose    %6lu frames, worst %.2f in %.2f deg, rms %.3f in\n", (unsigned long)diff.poses,
+			   diff.worstPosition, diff.worstHeading * 180.0 / 3.14159265358979, diff.rmsPosition);
+		printf("  motors  %6lu frames, worst %.2f V, rms %.3f V\n", (unsigned long)diff.motorFrames, diff.worstVoltage,
+			   diff.rmsVoltage);
+		printf("  sensors %6lu frames, %lu not identical\n", (unsigned long)diff.sensorFrames,
+			   (unsigned long)diff.sensorMismatches);
+		printTuning();
+		printLoop("AutonLoop", AutonLoop);
+		printLoop("DriverLoop", DriverLoop);
+		printProfile();
+		return 0;
+	}
+
+	bool parse(int argc, char **argv, Options &options)
+	{
+		options.bench = false;
+		options.iterations = 100000;
+		options.driverSeconds = 105.0;
+		options.sdRoot = "build/sim/sd";
+		options.auton = 0;
+		options.walls = true;
+		options.preAutonSeconds = 3.0;
+		options.assist = true;
+		options.tuneCount = 0;
+		options.replay = NULL;
+		options.hogMs = 0.0;
+		options.obstacleCount = 0;
+		options.expectBlocked = false;
+		for (int i = 1; i < argc; i++)
+		{
+			if (strcmp(argv[i], "--bench") == 0)
+			{
+				options.bench = true;
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+				{
+					options.iterations = (uint32_t)strtoul(argv[++i], NULL, 10);
+				}
+			}
+			else if (strcmp(argv[i], "--driver") == 0 && i + 1 < argc)
+			{
+				options.driverSeconds = atof(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--sd") == 0 && i + 1 < argc)
+			{
+				options.sdRoot = argv[++i];
+			}
+			else if (strcmp(argv[i], "--pre-auton") == 0 && i + 1 < argc)
+			{
+				options.preAutonSeconds = atof(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--no-assist") == 0)
+			{
+				options.assist = false;
+			}
+			else if (strcmp(argv[i], "--tune") == 0 && i + 1 < argc && options.tuneCount < 8)
+			{
+				options.tunes[options.tuneCount++] = argv[++i];
+			}
+			else if (strcmp(argv[i], "--hog") == 0 && i + 1 < argc)
+			{
+				options.hogMs = atof(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--obstacle") == 0 && i + 1 < argc && options.obstacleCount < 4)
+			{
+				double *obstacle = options.obstacles[options.obstacleCount++];
+				if (sscanf(argv[++i], "%lf,%lf", &obstacle[0], &obstacle[1]) != 2)
+				{
+					return false;
+				}
+			}
+			else if (strcmp(argv[i], "--expect-blocked") == 0)
+			{
+				options.expectBlocked = true;
+			}
+			else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			{
+				options.replay = argv[++i];
+			}
+			else if (strcmp(argv[i], "--no-walls") == 0)
+			{
+				options.walls = false;
+			}
+			else if (strcmp(argv[i], "--auton") == 0 && i + 1 < argc)
+			{
+				options.auton = (uint32_t)strtoul(argv[++i], NULL, 10);
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!parse(argc, argv, options))
+	{
+		fprintf(stderr, "usage: %s [--bench [iterations]] [--driver seconds] [--sd directory] [--auton index] "
+				"[--no-walls] [--pre-auton seconds] [--no-assist] [--tune name=value]... [--hog ms] [--obstacle x,y]... "
+				"[--expect-blocked] [--replay file]\n",
+				argv[0]);
+		return 2;
+	}
+	if (options.bench)
+	{
+		sim::runBenchmarks(options.iterations);
+		return 0;
+	}
+	if (options.replay)
+	{
+		return replayMatch(options);
+	}
+	return playMatch(options);
+}
@@ -0,0 +1,473 @@
+/**
+ * @file physics.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief The simulated world: motors, drivetrain, sensors, competition state
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The drivetrain model is deliberately simple: every motor is a DC motor with
+ * the V5 cartridge's free speed, a 2.5 A current limit and a first-order
+ * thermal model, and each side of the drive accelerates half the robot's mass.
+ * It is accurate enough to close the control loops and to load them the way
+ * a real robot would, which is the point of the simulator.
+ */
+
+#include "sim.h"
+
+#include "replay.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace sim
+{
+	namespace
+	{
+		const double kFreeRpm[3] = {100.0, 200.0, 600.0};
+		const double kStallTorque[3] = {2.1, 1.05, 0.35}; // Nm at the output shaft
+		const double kStallAmps = 2.5;
+		const double kNominalVolts = 12.0;
+		const double kAmbientC = 25.0;
+		const double kInchToM = 0.0254;
+		const double kFieldInches = 144.0;
+		const double kRobotHalf = 9.0; // an 18 inch robot stops this far from a wall
+		const double kPi = 3.14159265358979323846;
+
+		MotorState s_motors[kPorts];
+		TrackerState s_trackers[kPorts];
+		ImuState s_imus[kPorts];
+		DistanceState s_distances[kPorts];
+		ControllerState s_controller;
+		BatteryState s_battery = {12.8, -1.0};
+		ScreenStats s_screen;
+
+		RobotModel s_model;
+		bool s_configured = false;
+		Pose s_truth = {0.0, 0.0, 0.0};
+		double s_vLeft = 0.0;  // in/s
+		double s_vRight = 0.0; // in/s
+		double s_imuDriftDeg = 0.0;
+
+		Phase s_phase = kDisabled;
+		bool s_field = false;
+		void (*s_autonomous)(void) = 0;
+		void (*s_driver)(void) = 0;
+		int32_t s_competitionTask = -1;
+
+		uint8_t s_serial[4096];
+		uint32_t s_serialHead = 0;
+		uint32_t s_serialTail = 0;
+		uint8_t s_serialOut[8192];
+		uint32_t s_serialOutSize = 0;
+
+		char s_sdRoot[256] = "";
+
+		struct Obstacle
+		{
+			double x;
+			double y;
+			double radius;
+		};
+		Obstacle s_obstacles[kMaxObstacles];
+		int s_obstacleCount = 0;
+		uint32_t s_contacts = 0;
+
+		bool isDrive(int port)
+		{
+			for (int i = 0; i < s_model.motorsPerSide; i++)
+			{
+				if (s_model.leftPorts[i] == port || s_model.rightPorts[i] == port)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Electrical model of one motor at a given output speed
+		 *
+		 * @return shaft torque in Nm
+		 */
+		double updateElectrical(MotorState &m, double dt)
+		{
+			double freeRpm = kFreeRpm[m.gearing];
+			double volts = m.commandVolts;
+			if (m.velocityMode)
+			{
+				// stand-in for the firmware velocity loop
+				double error = m.targetRpm - m.velocityRpm;
+				m.integrator += error * dt * 0.5;
+				volts = m.targetRpm / freeRpm * kNominalVolts + error * 0.05 + m.integrator;
+			}
+			if (volts > kNominalVolts)
+			{
+				volts = kNominalVolts;
+			}
+			if (volts < -kNominalVolts)
+			{
+				volts = -kNominalVolts;
+			}
+
+			// firmware thermal protection: derate at 55 C, cut off at 70 C
+			double limit = kStallAmps;
+			if (m.temperatureC >= 70.0)
+			{
+				limit = 0.0;
+			}
+			else if (m.temperatureC >= 55.0)
+			{
+				limit = kStallAmps * (70.0 - m.temperatureC) / 15.0;
+			}
+
+			double backEmf = m.velocityRpm / freeRpm * kNominalVolts;
+			double resistance = kNominalVolts / kStallAmps;
+			double amps = (volts - backEmf) / resistance;
+			if (amps > limit)
+			{
+				amps = limit;
+			}
+			if (amps < -limit)
+			{
+				amps = -limit;
+			}
+			m.appliedVolts = volts;
+			m.currentAmp = amps;
+
+			// I^2 R heating against a fixed thermal mass
+			double heat = amps * amps * resistance * 0.35;
+			m.temperatureC += (heat - (m.temperatureC - kAmbientC) * 0.04) * dt / 4.0;
+
+			return amps / kStallAmps * kStallTorque[m.gearing];
+		}
+
+		void stepFreeMotor(MotorState &m, double dt)
+		{
+			double torque = updateElectrical(m, dt);
+			// small inertial load with viscous friction
+			double accel = (torque - m.velocityRpm * 0.002) / 0.004; // rpm/s scale
+			m.velocityRpm += accel * dt;
+			m.positionDeg += m.velocityRpm * 6.0 * dt;
+		}
+
+		double sideForce(const int *ports, double wheelVel, double dt)
+		{
+			double torque = 0.0;
+			double wheelRadiusM = s_model.wheelDiameter * 0.5 * kInchToM;
+			double motorRpm = wheelVel / (kPi * s_model.wheelDiameter) * 60.0 / s_model.driveRatio;
+			for (int i = 0; i < s_model.motorsPerSide; i++)
+			{
+				// the program's reversal flags are taken to match how the
+				// motors are mounted, so a reversed motor turns its wheel
+				// forwards for negative physical voltage
+				MotorState &m = s_motors[ports[i]];
+				double mount = m.reversed ? -1.0 : 1.0;
+				m.velocityRpm = motorRpm * mount;
+				torque += updateElectrical(m, dt) * mount;
+				m.positionDeg += m.velocityRpm * 6.0 * dt;
+			}
+			return torque * s_model.driveRatio / wheelRadiusM;
+		}
+
+		double castRay(double x, double y, double angle)
+		{
+			double dx = cos(angle);
+			double dy = sin(angle);
+			double best = 1e9;
+			if (dx > 1e-9)
+			{
+				best = fmin(best, (kFieldInches - x) / dx);
+			}
+			if (dx < -1e-9)
+			{
+				best = fmin(best, -x / dx);
+			}
+			if (dy > 1e-9)
+			{
+				best = fmin(best, (kFieldInches - y) / dy);
+			}
+			if (dy < -1e-9)
+			{
+				best = fmin(best, -y / dy);
+			}
+			for (int i = 0; i < s_obstacleCount; i++)
+			{
+				// nearest crossing of the circle in front of the sensor
+				const Obstacle &o = s_obstacles[i];
+				double along = (o.x - x) * dx + (o.y - y) * dy;
+				double across = (o.x - x) * dy - (o.y - y) * dx;
+				double half = o.radius * o.radius - across * across;
+				if (half >= 0.0 && along - sqrt(half) > 0.0)
+				{
+					best = fmin(best, along - sqrt(half));
+				}
+			}
+			return best;
+		}
+
+		/** @brief True if moving the robot's centre to x, y pushes it into an obstacle */
+		bool intoObstacle(double x, double y)
+		{
+			for (int i = 0; i < s_obstacleCount; i++)
+			{
+				const Obstacle &o = s_obstacles[i];
+				double reach = o.radius + kRobotHalf;
+				double now = hypot(s_truth.x - o.x, s_truth.y - o.y);
+				double next = hypot(x - o.x, y - o.y);
+				if (next < reach && next < now)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	} // namespace
+
+	MotorState &motor(int32_t port) { return s_motors[port]; }
+	TrackerState &tracker(int32_t port) { return s_trackers[port]; }
+	ImuState &imu(int32_t port) { return s_imus[port]; }
+	DistanceState &distance(int32_t port) { return s_distances[port]; }
+	ControllerState &controller() { return s_controller; }
+	BatteryState &battery() { return s_battery; }
+	ScreenStats &screen() { return s_screen; }
+	const Pose &truth() { return s_truth; }
+	uint32_t obstacleContacts() { return s_contacts; }
+
+	bool addObstacle(double x, double y, double radius)
+	{
+		if (s_obstacleCount >= kMaxObstacles)
+		{
+			return false;
+		}
+		Obstacle &o = s_obstacles[s_obstacleCount++];
+		o.x = x;
+		o.y = y;
+		o.radius = radius;
+		return true;
+	}
+
+	void configure(const RobotModel &model, const Pose &start)
+	{
+		s_model = model;
+		s_truth = start;
+		s_configured = true;
+		for (int i = 0; i < kPorts; i++)
+		{
+			s_motors[i].temperatureC = kAmbientC;
+		}
+	}
+
+	void stepPhysics(double dt)
+	{
+		if (replaying())
+		{
+			stepReplay(nowUs());
+			return;
+		}
+		for (int port = 0; port < kPorts; port++)
+		{
+			if (s_motors[port].installed && (!s_configured || !isDrive(port)))
+			{
+				stepFreeMotor(s_motors[port], dt);
+			}
+		}
+		if (!s_configured)
+		{
+			return;
+		}
+
+		// drivetrain: each side carries half the mass, plus rolling resistance
+		double halfMass = s_model.massKg * 0.5;
+		double fLeft = sideForce(s_model.leftPorts, s_vLeft, dt);
+		double fRight = sideForce(s_model.rightPorts, s_vRight, dt);
+		double drag = 4.0; // N per (m/s)
+		double vlM = s_vLeft * kInchToM;
+		double vrM = s_vRight * kInchToM;
+		vlM += (fLeft - drag * vlM) / halfMass * dt;
+		vrM += (fRight - drag * vrM) / halfMass * dt;
+		s_vLeft = vlM / kInchToM;
+		s_vRight = vrM / kInchToM;
+
+		double v = (s_vLeft + s_vRight) * 0.5;
+		double omega = (s_vRight - s_vLeft) / s_model.trackWidth;
+		double dTheta = omega * dt;
+		double mid = s_truth.theta + dTheta * 0.5;
+		double x = fmin(fmax(s_truth.x + v * dt * cos(mid), kRobotHalf), kFieldInches - kRobotHalf);
+		double y = fmin(fmax(s_truth.y + v * dt * sin(mid), kRobotHalf), kFieldInches - kRobotHalf);
+		if (intoObstacle(x, y))
+		{
+			x = s_truth.x;
+			y = s_truth.y;
+			s_contacts++;
+		}
+
+		// against a wall or an obstacle the drive stalls: keep only the motion allowed
+		double moved = (x - s_truth.x) * cos(mid) + (y - s_truth.y) * sin(mid);
+		if (fabs(moved - v * dt) > 1e-9)
+		{
+			double blocked = v - moved / dt;
+			s_vLeft -= blocked;
+			s_vRight -= blocked;
+			v -= blocked;
+		}
+		s_truth.x = x;
+		s_truth.y = y;
+		s_truth.theta += dTheta;
+
+		double trackerCirc = kPi * s_model.trackerDiameter / (s_model.trackerScale > 0.0 ? s_model.trackerScale : 1.0);
+		if (s_model.forwardTracker >= 0)
+		{
+			TrackerState &t = s_trackers[s_model.forwardTracker];
+			double travel = v * dt + s_model.forwardOffset * dTheta;
+			t.positionDeg += travel / trackerCirc * 360.0;
+			t.velocityDps = travel / dt / trackerCirc * 360.0;
+		}
+		if (s_model.sidewaysTracker >= 0)
+		{
+			TrackerState &t = s_trackers[s_model.sidewaysTracker];
+			double travel = -s_model.sidewaysOffset * dTheta;
+			t.positionDeg += travel / trackerCirc * 360.0;
+			t.velocityDps = travel / dt / trackerCirc * 360.0;
+		}
+		if (s_model.imuPort >= 0)
+		{
+			// the V5 IMU reports clockwise-positive rotation
+			s_imuDriftDeg += s_model.imuDriftDps * dt;
+			s_imus[s_model.imuPort].rotationDeg = -s_truth.theta * 180.0 / kPi + s_imuDriftDeg;
+		}
+		for (int i = 0; i < 4; i++)
+		{
+			int port = s_model.distancePorts[i];
+			if (port < 0)
+			{
+				continue;
+			}
+			const double *mount = s_model.distanceMount[i];
+			double c = cos(s_truth.theta);
+			double s = sin(s_truth.theta);
+			double sx = s_truth.x + mount[0] * c - mount[1] * s;
+			double sy = s_truth.y + mount[0] * s + mount[1] * c;
+			double range = castRay(sx, sy, s_truth.theta + mount[2]);
+			double mm = range * 25.4;
+			s_distances[port].detected = mm < 2000.0;
+			s_distances[port].mm = s_distances[port].detected ? mm : 9999.0;
+		}
+	}
+
+	void setPhase(Phase phase, bool fieldControl)
+	{
+		s_field = fieldControl;
+		if (phase == s_phase)
+		{
+			return;
+		}
+		s_phase = phase;
+		if (s_competitionTask >= 0)
+		{
+			kill(s_competitionTask);
+			s_competitionTask = -1;
+		}
+		void (*callback)(void) = phase == kAutonomous ? s_autonomous : phase == kDriver ? s_driver : 0;
+		if (callback)
+		{
+			struct Launch
+			{
+				static int run(void *arg)
+				{
+					((void (*)(void))arg)();
+					return 0;
+				}
+			};
+			s_competitionTask = spawn(Launch::run, (void *)callback, 7);
+		}
+		if (phase == kDisabled)
+		{
+			for (int port = 0; port < kPorts; port++)
+			{
+				s_motors[port].commandVolts = 0.0;
+				s_motors[port].velocityMode = false;
+			}
+		}
+	}
+
+	Phase phase() { return s_phase; }
+	bool fieldControl() { return s_field; }
+	void setAutonomousCallback(void (*callback)(void)) { s_autonomous = callback; }
+	void setDriverCallback(void (*callback)(void)) { s_driver = callback; }
+
+	void serialFeed(const uint8_t *data, uint32_t len)
+	{
+		for (uint32_t i = 0; i < len; i++)
+		{
+			uint32_t next = (s_serialHead + 1) % sizeof(s_serial);
+			if (next == s_serialTail)
+			{
+				return;
+			}
+			s_serial[s_serialHead] = data[i];
+			s_serialHead = next;
+		}
+	}
+
+	int32_t serialRead()
+	{
+		if (s_serialTail == s_serialHead)
+		{
+			return -1;
+		}
+		uint8_t c = s_serial[s_serialTail];
+		s_serialTail = (s_serialTail + 1) % sizeof(s_serial);
+		return c;
+	}
+
+	void serialSend(const uint8_t *data, uint32_t len)
+	{
+		uint32_t room = sizeof(s_serialOut) - s_serialOutSize;
+		len = len < room ? len : room;
+		memcpy(s_serialOut + s_serialOutSize, data, len);
+		s_serialOutSize += len;
+	}
+
+	uint32_t serialTake(uint8_t *out, uint32_t max)
+	{
+		uint32_t len = s_serialOutSize < max ? s_serialOutSize : max;
+		memcpy(out, s_serialOut, len);
+		memmove(s_serialOut, s_serialOut + len, s_serialOutSize - len);
+		s_serialOutSize -= len;
+		return len;
+	}
+
+	void setSdRoot(const char *path)
+	{
+		strncpy(s_sdRoot, path, sizeof(s_sdRoot) - 1);
+	}
+
+	const char *sdRoot()
+	{
+		return s_sdRoot;
+	}
+} // namespace sim
+
+extern "C" {
+
+int32_t vexSerialWriteBuffer(uint32_t channel, uint8_t *data, uint32_t data_len)
+{
+	(void)channel;
+	sim::serialSend(data, data_len);
+	return (int32_t)data_len;
+}
+
+int32_t vexSerialReadChar(uint32_t channel)
+{
+	(void)channel;
+	return sim::serialRead();
+}
+
+int32_t vexSerialWriteFree(uint32_t channel)
+{
+	(void)channel;
+	return 2048;
+}
+}
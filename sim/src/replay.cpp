@@ -0,0 +1,455 @@
+/**
+ * @file replay.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining match replay
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The whole log is read into memory and each record type the replay needs
+ * is indexed into its own time-ordered list. Simulated time only moves
+ * forward, so each list keeps a cursor on the last sample at or before now
+ * and the lookup per millisecond is a step or two. Each device is written
+ * so the mock reads back the recorded value whatever offset the program has
+ * set on it since.
+ */
+
+#include "replay.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "telemetry.h"
+
+namespace sim
+{
+	namespace
+	{
+		const double kGearRpm[3] = {100.0, 200.0, 600.0};
+		const double kNominalVolts = 12.0;
+		const double kPi = 3.14159265358979323846;
+
+		/** @brief Longest gap between two sensor samples of the same competition period */
+		const uint32_t kPhaseGapMs = 100;
+
+		const size_t kMaxPhases = 8;
+
+		struct Frame
+		{
+			uint32_t ms;
+			uint8_t length;
+			const uint8_t *payload;
+		};
+
+		/** @brief Frames of one type in time order, and the last one at or before now */
+		struct Track
+		{
+			Frame *frames;
+			size_t count;
+			size_t cursor;
+		};
+
+		uint8_t *s_data = NULL;
+		size_t s_skipped = 0;
+		Track s_sensors;
+		Track s_motors;
+		Track s_pads;
+		Track s_poses;
+		ReplayPorts s_ports;
+		ReplayPhase s_phases[kMaxPhases];
+		size_t s_phaseCount = 0;
+
+		bool readFile(const char *path, uint8_t *&data, size_t &size)
+		{
+			FILE *f = fopen(path, "rb");
+			if (!f)
+			{
+				return false;
+			}
+			fseek(f, 0, SEEK_END);
+			long length = ftell(f);
+			fseek(f, 0, SEEK_SET);
+			data = length > 0 ? (uint8_t *)malloc((size_t)length) : NULL;
+			bool ok = data && fread(data, 1, (size_t)length, f) == (size_t)length;
+			fclose(f);
+			if (!ok)
+			{
+				free(data);
+				data = NULL;
+				return false;
+			}
+			size = (size_t)length;
+			return true;
+		}
+
+		/** @brief Indexes the frames of one type at least minLength long */
+		Track collect(const uint8_t *data, size_t size, uint8_t type, size_t minLength)
+		{
+			Track track = {NULL, 0, 0};
+			art::TelemetryFrame frame;
+			art::TelemetryReader counter(data, size);
+			while (counter.next(frame))
+			{
+				track.count += frame.type == type && frame.length >= minLength;
+			}
+			track.frames = (Frame *)malloc((track.count ? track.count : 1) * sizeof(Frame));
+
+			size_t n = 0;
+			art::TelemetryReader reader(data, size);
+			while (reader.next(frame))
+			{
+				if (frame.type == type && frame.length >= minLength)
+				{
+					Frame &f = track.frames[n++];
+					f.ms = frame.timeMs;
+					f.length = frame.length;
+					f.payload = frame.payload;
+				}
+			}
+			return track;
+		}
+
+		/**
+		 * @brief Moves the cursor to the last frame at or before ms, or the
+		 * first frame if there is none
+		 *
+		 * @return weight of the frame after the cursor, 0 to 1
+		 */
+		double seek(Track &track, double ms)
+		{
+			while (track.cursor + 1 < track.count && track.frames[track.cursor + 1].ms <= ms)
+			{
+				track.cursor++;
+			}
+			if (track.cursor + 1 >= track.count)
+			{
+				return 0.0;
+			}
+			const Frame &a = track.frames[track.cursor];
+			const Frame &b = track.frames[track.cursor + 1];
+			double f = (ms - a.ms) / (double)(b.ms - a.ms);
+			return f < 0.0 ? 0.0 : (f > 1.0 ? 1.0 : f);
+		}
+
+		template <typename T>
+		T decode(const Track &track, size_t index, size_t offset = 0)
+		{
+			T value;
+			memcpy(&value, track.frames[index].payload + offset, sizeof(value));
+			return value;
+		}
+
+		double lerp(double a, double b, double f)
+		{
+			return a + (b - a) * f;
+		}
+
+		void replaySensors(double ms)
+		{
+			double f = seek(s_sensors, ms);
+			size_t i = s_sensors.cursor;
+			size_t j = i + 1 < s_sensors.count ? i + 1 : i;
+			art::SensorRecord a = decode<art::SensorRecord>(s_sensors, i);
+			art::SensorRecord b = decode<art::SensorRecord>(s_sensors, j);
+			double spanS = (s_sensors.frames[j].ms - s_sensors.frames[i].ms) * 1e-3;
+
+			const int trackers[2] = {s_ports.forwardTracker, s_ports.sidewaysTracker};
+			const int32_t from[2] = {a.forward, a.sideways};
+			const int32_t to[2] = {b.forward, b.sideways};
+			for (int k = 0; k < 2; k++)
+			{
+				if (trackers[k] < 0)
+				{
+					continue;
+				}
+				TrackerState &t = tracker(trackers[k]);
+				t.positionDeg = lerp(from[k], to[k], f) / 256.0 + t.offsetDeg;
+				t.velocityDps = spanS > 0.0 ? (to[k] - from[k]) / 256.0 / spanS : 0.0;
+			}
+			if (s_ports.imu >= 0)
+			{
+				ImuState &s = imu(s_ports.imu);
+				s.rotationDeg = lerp(a.rotation, b.rotation, f) / 256.0 + s.offsetDeg;
+			}
+
+			for (int k = 0; k < 4; k++)
+			{
+				if (s_ports.distance[k] < 0)
+				{
+					continue;
+				}
+				DistanceState &d = distance(s_ports.distance[k]);
+				d.detected = a.distance[k] >= 0;
+				d.mm = d.detected ? a.distance[k] / 64.0 * 25.4 : 9999.0;
+			}
+
+			battery().volts = a.batteryVoltage / 1000.0;
+			battery().currentAmp = a.batteryCurrent > 0 ? a.batteryCurrent / 1000.0 : 0.0;
+		}
+
+		void replayMotors(double ms)
+		{
+			double f = seek(s_motors, ms);
+			size_t i = s_motors.cursor;
+			size_t j = i + 1 < s_motors.count ? i + 1 : i;
+			size_t count = s_motors.frames[i].length / sizeof(art::MotorRecord);
+			bool sameLayout = s_motors.frames[j].length == s_motors.frames[i].length;
+			for (size_t k = 0; k < count; k++)
+			{
+				art::MotorRecord a = decode<art::MotorRecord>(s_motors, i, k * sizeof(art::MotorRecord));
+				art::MotorRecord b = sameLayout ? decode<art::MotorRecord>(s_motors, j, k * sizeof(art::MotorRecord)) : a;
+				if (b.index != a.index)
+				{
+					b = a;
+				}
+				if (a.index >= s_ports.motorCount || s_ports.motors[a.index] < 0)
+				{
+					continue;
+				}
+				MotorState &m = motor(s_ports.motors[a.index]);
+				double sign = m.reversed ? -1.0 : 1.0;
+				m.positionDeg = lerp(a.position, b.position, f) / 16.0 * sign + m.offsetDeg;
+				m.velocityRpm = lerp(a.velocity, b.velocity, f) / 8.0 * sign;
+				m.currentAmp = lerp(a.current, b.current, f) / 1000.0;
+				m.temperatureC = lerp(a.temperature, b.temperature, f);
+			}
+		}
+
+		void replayController(double ms)
+		{
+			seek(s_pads, ms);
+			ControllerState &pad = controller();
+			if (s_pads.frames[s_pads.cursor].ms > ms)
+			{
+				memset(&pad, 0, sizeof(pad));
+				return;
+			}
+			art::ControllerRecord record = decode<art::ControllerRecord>(s_pads, s_pads.cursor);
+			for (int k = 0; k < 4; k++)
+			{
+				// the smallest raw value the mock turns back into the same percentage
+				int32_t percent = record.axis[k] < 0 ? -record.axis[k] : record.axis[k];
+				int32_t raw = (percent * 127 + 99) / 100;
+				pad.axis[k] = record.axis[k] < 0 ? -raw : raw;
+			}
+			pad.buttons = record.buttons;
+		}
+
+		/** @brief The program's commands, read back as what the motors applied */
+		void applyCommands()
+		{
+			for (int port = 0; port < kPorts; port++)
+			{
+				MotorState &m = motor(port);
+				if (!m.installed)
+				{
+					continue;
+				}
+				double volts = m.velocityMode ? m.targetRpm / kGearRpm[m.gearing] * kNominalVolts : m.commandVolts;
+				m.appliedVolts = fmax(-kNominalVolts, fmin(kNominalVolts, volts));
+			}
+		}
+
+		/** @brief Finds each competition period from its phase frame and the sensor samples after it */
+		void findPhases(const Track &phases)
+		{
+			s_phaseCount = 0;
+			size_t s = 0;
+			for (size_t p = 0; p < phases.count && s_phaseCount < kMaxPhases; p++)
+			{
+				art::PhaseRecord record = decode<art::PhaseRecord>(phases, p);
+				uint32_t startMs = phases.frames[p].ms;
+				uint32_t nextMs = p + 1 < phases.count ? phases.frames[p + 1].ms : UINT32_MAX;
+				while (s < s_sensors.count && s_sensors.frames[s].ms < startMs)
+				{
+					s++;
+				}
+				if (s >= s_sensors.count || s_sensors.frames[s].ms >= nextMs)
+				{
+					continue;
+				}
+				size_t last = s;
+				while (last + 1 < s_sensors.count && s_sensors.frames[last + 1].ms < nextMs &&
+					   s_sensors.frames[last + 1].ms - s_sensors.frames[last].ms <= kPhaseGapMs)
+				{
+					last++;
+				}
+				uint32_t periodMs = last > s ? s_sensors.frames[last].ms - s_sensors.frames[last - 1].ms : 10;
+
+				ReplayPhase &phase = s_phases[s_phaseCount++];
+				phase.phase = record.phase == art::kPhaseAutonomous ? kAutonomous : kDriver;
+				phase.startUs = (uint64_t)startMs * 1000;
+				phase.endUs = ((uint64_t)s_sensors.frames[last].ms + periodMs) * 1000;
+				memcpy(phase.routine, record.routine, sizeof(phase.routine));
+				phase.routine[sizeof(phase.routine) - 1] = '\0';
+				s = last + 1;
+			}
+		}
+
+		typedef void (*CompareFn)(const Frame &recorded, const Frame &replayed, ReplayDiff &diff);
+
+		/** @brief Runs compare on every pair of frames logged at the same millisecond */
+		void pair(const Track &recorded, const Track &replayed, CompareFn compare, ReplayDiff &diff)
+		{
+			size_t i = 0;
+			size_t j = 0;
+			while (i < recorded.count && j < replayed.count)
+			{
+				uint32_t a = recorded.frames[i].ms;
+				uint32_t b = replayed.frames[j].ms;
+				if (a == b)
+				{
+					compare(recorded.frames[i++], replayed.frames[j++], diff);
+				}
+				else if (a < b)
+				{
+					i++;
+				}
+				else
+				{
+					j++;
+				}
+			}
+		}
+
+		void comparePoses(const Frame &recorded, const Frame &replayed, ReplayDiff &diff)
+		{
+			art::PoseRecord a;
+			art::PoseRecord b;
+			memcpy(&a, recorded.payload, sizeof(a));
+			memcpy(&b, replayed.payload, sizeof(b));
+			double position = hypot((a.x - b.x) / 64.0, (a.y - b.y) / 64.0);
+			double heading = fabs((int16_t)(uint16_t)(a.heading - b.heading) * 2.0 * kPi / 65536.0);
+			diff.poses++;
+			diff.worstPosition = fmax(diff.worstPosition, position);
+			diff.rmsPosition += position * position;
+			diff.worstHeading = fmax(diff.worstHeading, heading);
+		}
+
+		void compareMotors(const Frame &recorded, const Frame &replayed, ReplayDiff &diff)
+		{
+			size_t count = recorded.length / sizeof(art::MotorRecord);
+			if (replayed.length != recorded.length || count == 0)
+			{
+				return;
+			}
+			double squares = 0.0;
+			for (size_t k = 0; k < count; k++)
+			{
+				art::MotorRecord a;
+				art::MotorRecord b;
+				memcpy(&a, recorded.payload + k * sizeof(a), sizeof(a));
+				memcpy(&b, replayed.payload + k * sizeof(b), sizeof(b));
+				double volts = fabs(a.voltage - b.voltage) / 1000.0;
+				diff.worstVoltage = fmax(diff.worstVoltage, volts);
+				squares += volts * volts;
+			}
+			diff.motorFrames++;
+			diff.rmsVoltage += squares / count;
+		}
+
+		void compareSensors(const Frame &recorded, const Frame &replayed, ReplayDiff &diff)
+		{
+			diff.sensorFrames++;
+			if (recorded.length != replayed.length || memcmp(recorded.payload, replayed.payload, recorded.length) != 0)
+			{
+				diff.sensorMismatches++;
+			}
+		}
+	} // namespace
+
+	bool loadReplay(const char *path, const ReplayPorts &ports)
+	{
+		uint8_t *data = NULL;
+		size_t size = 0;
+		if (s_data || !readFile(path, data, size))
+		{
+			return false;
+		}
+		s_sensors = collect(data, size, art::kTelemetrySensors, sizeof(art::SensorRecord));
+		if (s_sensors.count == 0)
+		{
+			free(s_sensors.frames);
+			free(data);
+			return false;
+		}
+		s_motors = collect(data, size, art::kTelemetryMotors, sizeof(art::MotorRecord));
+		s_pads = collect(data, size, art::kTelemetryController, sizeof(art::ControllerRecord));
+		s_poses = collect(data, size, art::kTelemetryPose, sizeof(art::PoseRecord));
+		Track phases = collect(data, size, art::kTelemetryPhase, sizeof(art::PhaseRecord));
+		findPhases(phases);
+		free(phases.frames);
+
+		art::TelemetryFrame frame;
+		art::TelemetryReader reader(data, size);
+		while (reader.next(frame))
+		{
+		}
+		s_skipped = reader.skipped();
+		s_ports = ports;
+		s_data = data;
+		return true;
+	}
+
+	bool replaying()
+	{
+		return s_data != NULL;
+	}
+
+	size_t replayPhases()
+	{
+		return s_phaseCount;
+	}
+
+	const ReplayPhase &replayPhase(size_t index)
+	{
+		return s_phases[index];
+	}
+
+	size_t replaySkipped()
+	{
+		return s_skipped;
+	}
+
+	void stepReplay(uint64_t nowUs)
+	{
+		double ms = nowUs / 1000.0;
+		replaySensors(ms);
+		if (s_motors.count)
+		{
+			replayMotors(ms);
+		}
+		if (s_pads.count)
+		{
+			replayController(ms);
+		}
+		applyCommands();
+	}
+
+	bool compareReplay(const char *path, ReplayDiff &diff)
+	{
+		memset(&diff, 0, sizeof(diff));
+		uint8_t *data = NULL;
+		size_t size = 0;
+		if (!s_data || !readFile(path, data, size))
+		{
+			return false;
+		}
+		Track poses = collect(data, size, art::kTelemetryPose, sizeof(art::PoseRecord));
+		Track motors = collect(data, size, art::kTelemetryMotors, sizeof(art::MotorRecord));
+		Track sensors = collect(data, size, art::kTelemetrySensors, sizeof(art::SensorRecord));
+		pair(s_poses, poses, comparePoses, diff);
+		pair(s_motors, motors, compareMotors, diff);
+		pair(s_sensors, sensors, compareSensors, diff);
+		diff.rmsPosition = diff.poses ? sqrt(diff.rmsPosition / diff.poses) : 0.0;
+		diff.rmsVoltage = diff.motorFrames ? sqrt(diff.rmsVoltage / diff.motorFrames) : 0.0;
+		free(poses.frames);
+		free(motors.frames);
+		free(sensors.frames);
+		free(data);
+		return true;
+	}
+} // namespace sim
@@ -0,0 +1,99 @@
+/**
+ * @file replay.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Header declaring match replay: the simulated devices driven from a
+ * recorded telemetry log instead of the physics
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A match log holds every reading the control code acted on: the tracking
+ * wheels, inertial sensor, distance sensors and battery every control tick,
+ * the motors every other tick and the controller every input tick (see
+ * @ref telemetry_format). Replaying it feeds those readings back to the
+ * program through the mock devices at the times they were recorded, so the
+ * same code sees the same match again, as fast as the host can run it.
+ *
+ * The trackers, inertial sensor and motors are interpolated between
+ * samples, since odometry and the wheel speed loop read them more often than
+ * they are logged. The controller and distance sensors are only read on
+ * sample ticks, and hold their last recorded value. The voltages the program
+ * commands are read back as applied, so the log written during a replay can
+ * be compared with the recording to find where a change to the code made it
+ * act differently.
+ *
+ * Values edited over the tuning link during the recorded match are not in
+ * the log; the replay runs with whatever params.bin holds.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sim.h"
+
+namespace sim
+{
+	/** @brief Where the recorded devices are plugged in, zero-based; negative if not fitted */
+	struct ReplayPorts
+	{
+		int motors[kPorts];   /**< port of each motor index in a MotorRecord */
+		int motorCount;
+		int forwardTracker;
+		int sidewaysTracker;
+		int imu;
+		int distance[4];       /**< port of each distance slot in a SensorRecord */
+	};
+
+	/** @brief One competition period found in a recording */
+	struct ReplayPhase
+	{
+		Phase phase;
+		uint64_t startUs;      /**< when the period's callback logged that it started */
+		uint64_t endUs;        /**< one sample period after the last recorded sample */
+		char routine[16];      /**< autonomous routine, empty for usercontrol */
+	};
+
+	/** @brief How far a replay's log is from the recording, over frames logged at the same time */
+	struct ReplayDiff
+	{
+		uint32_t poses;
+		double worstPosition;  /**< inches */
+		double rmsPosition;
+		double worstHeading;   /**< radians */
+		uint32_t motorFrames;
+		double worstVoltage;   /**< volts, over every motor */
+		double rmsVoltage;
+		uint32_t sensorFrames;
+		uint32_t sensorMismatches; /**< sensor frames not identical to the recording */
+	};
+
+	/**
+	 * @brief Loads a match log and starts replaying it
+	 *
+	 * @return false if the file cannot be read or holds no sensor samples
+	 */
+	bool loadReplay(const char *path, const ReplayPorts &ports);
+
+	/** @brief True once a recording is loaded */
+	bool replaying();
+
+	/** @brief Competition periods in the recording, in order */
+	size_t replayPhases();
+	const ReplayPhase &replayPhase(size_t index);
+
+	/** @brief Frames in the recording that failed their checksum, in bytes skipped */
+	size_t replaySkipped();
+
+	/** @brief Sets every recorded device to its value at nowUs; run by stepPhysics */
+	void stepReplay(uint64_t nowUs);
+
+	/**
+	 * @brief Compares the log at path with the recording being replayed
+	 *
+	 * @return false if the log cannot be read
+	 */
+	bool compareReplay(const char *path, ReplayDiff &diff);
+} // namespace sim
@@ -0,0 +1,253 @@
+/**
+ * @file scheduler_sim.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Virtual-time cooperative task scheduler behind the mock vex::task
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Tasks are ucontext coroutines. The harness calls runUntil(), which keeps
+ * switching to the highest-priority task whose wake time has passed. When no
+ * task is ready, the clock jumps to the earliest wake time and the physics is
+ * stepped for every millisecond crossed on the way.
+ */
+
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+namespace sim
+{
+	namespace
+	{
+		const int kMaxTasks = 64;
+		const size_t kStackSize = 512 * 1024;
+
+		struct Task
+		{
+			bool used;
+			bool alive;
+			bool suspended;
+			int32_t priority;
+			uint64_t wakeUs;
+			uint64_t order;
+			int (*fn)(void *);
+			void *arg;
+			char *stack;
+			ucontext_t context;
+		};
+
+		Task s_tasks[kMaxTasks];
+		ucontext_t s_harness;
+		int32_t s_current = -1;
+		uint64_t s_now = 0;
+		uint64_t s_order = 0;
+
+		void freeTask(int32_t id)
+		{
+			free(s_tasks[id].stack);
+			s_tasks[id].stack = NULL;
+			s_tasks[id].used = false;
+		}
+
+		void trampoline()
+		{
+			Task &task = s_tasks[s_current];
+			task.fn(task.arg);
+			task.alive = false;
+			swapcontext(&task.context, &s_harness);
+		}
+
+		void switchToHarness()
+		{
+			int32_t id = s_current;
+			swapcontext(&s_tasks[id].context, &s_harness);
+		}
+
+		void advanceTo(uint64_t target)
+		{
+			while (s_now < target)
+			{
+				uint64_t nextMs = (s_now / 1000 + 1) * 1000;
+				if (nextMs > target)
+				{
+					s_now = target;
+					break;
+				}
+				s_now = nextMs;
+				stepPhysics(0.001);
+			}
+		}
+
+		/**
+		 * @brief Points a task's context at the trampoline on its own stack
+		 *
+		 * Kept out of spawn() because getcontext() counts as returning twice,
+		 * which would make the compiler distrust every local in the loop.
+		 */
+		void prepareContext(Task &task)
+		{
+			getcontext(&task.context);
+			task.context.uc_stack.ss_sp = task.stack;
+			task.context.uc_stack.ss_size = kStackSize;
+			task.context.uc_link = NULL;
+			makecontext(&task.context, trampoline, 0);
+		}
+	} // namespace
+
+	uint64_t nowUs()
+	{
+		return s_now;
+	}
+
+	int32_t spawn(int (*fn)(void *), void *arg, int32_t priority)
+	{
+		for (int32_t id = 0; id < kMaxTasks; id++)
+		{
+			if (s_tasks[id].used)
+			{
+				continue;
+			}
+			Task &task = s_tasks[id];
+			task.used = true;
+			task.alive = true;
+			task.suspended = false;
+			task.priority = priority;
+			task.wakeUs = s_now;
+			task.order = ++s_order;
+			task.fn = fn;
+			task.arg = arg;
+			task.stack = (char *)malloc(kStackSize);
+			prepareContext(task);
+			return id;
+		}
+		fprintf(stderr, "sim: out of task slots\n");
+		abort();
+	}
+
+	void kill(int32_t id)
+	{
+		if (id < 0 || id >= kMaxTasks || !s_tasks[id].used)
+		{
+			return;
+		}
+		s_tasks[id].alive = false;
+		if (id == s_current)
+		{
+			switchToHarness();
+		}
+	}
+
+	void suspend(int32_t id, bool suspended)
+	{
+		if (id < 0 || id >= kMaxTasks || !s_tasks[id].used)
+		{
+			return;
+		}
+		s_tasks[id].suspended = suspended;
+		if (suspended && id == s_current)
+		{
+			switchToHarness();
+		}
+	}
+
+	int32_t current()
+	{
+		return s_current;
+	}
+
+	int32_t priority(int32_t id)
+	{
+		return (id >= 0 && id < kMaxTasks) ? s_tasks[id].priority : 0;
+	}
+
+	void setPriority(int32_t id, int32_t priority)
+	{
+		if (id >= 0 && id < kMaxTasks)
+		{
+			s_tasks[id].priority = priority;
+		}
+	}
+
+	void sleepUntilUs(uint64_t wakeUs)
+	{
+		if (s_current < 0)
+		{
+			// called from the harness: just run the world forward
+			runUntil(wakeUs);
+			return;
+		}
+		Task &task = s_tasks[s_current];
+		task.wakeUs = wakeUs > s_now ? wakeUs : s_now;
+		task.order = ++s_order;
+		switchToHarness();
+	}
+
+	void yield()
+	{
+		sleepUntilUs(s_now);
+	}
+
+	void busy(uint64_t us)
+	{
+		advanceTo(s_now + us);
+	}
+
+	void runUntil(uint64_t endUs)
+	{
+		while (true)
+		{
+			int32_t next = -1;
+			uint64_t earliest = UINT64_MAX;
+			for (int32_t id = 0; id < kMaxTasks; id++)
+			{
+				Task &task = s_tasks[id];
+				if (!task.used || !task.alive || task.suspended)
+				{
+					continue;
+				}
+				if (task.wakeUs <= s_now)
+				{
+					if (next < 0 || task.priority > s_tasks[next].priority ||
+						(task.priority == s_tasks[next].priority && task.order < s_tasks[next].order))
+					{
+						next = id;
+					}
+				}
+				else if (task.wakeUs < earliest)
+				{
+					earliest = task.wakeUs;
+				}
+			}
+
+			if (next < 0)
+			{
+				uint64_t target = earliest < endUs ? earliest : endUs;
+				advanceTo(target);
+				if (target >= endUs)
+				{
+					return;
+				}
+				continue;
+			}
+
+			s_current = next;
+			swapcontext(&s_harness, &s_tasks[next].context);
+			s_current = -1;
+			if (!s_tasks[next].alive)
+			{
+				freeTask(next);
+			}
+			for (int32_t id = 0; id < kMaxTasks; id++)
+			{
+				if (s_tasks[id].used && !s_tasks[id].alive)
+				{
+					freeTask(id);
+				}
+			}
+		}
+	}
+} // namespace sim
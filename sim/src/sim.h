@@ -0,0 +1,239 @@
+/**
+ * @file sim.h
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Internal interface of the host simulator: virtual clock, cooperative
+ * task scheduler and the physical world the mock devices read from
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * None of this is visible to robot code. The mock vex classes in vex_mock.cpp
+ * and the harness in harness.cpp are the only users. Every vex::task runs on
+ * its own ucontext stack and only one runs at a time, switching only when it
+ * waits or yields, the same way the V5 scheduler behaves. When every task is
+ * asleep the clock jumps straight to the next wake-up, stepping the physics
+ * once per simulated millisecond, so a match runs as fast as the host can
+ * execute the control code.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace sim
+{
+	/** @brief Number of smart ports modelled */
+	const int kPorts = 21;
+
+	/**
+	 * @brief Current simulated time in microseconds since program start
+	 */
+	uint64_t nowUs();
+
+	/**
+	 * @brief Creates a task; returns its id
+	 */
+	int32_t spawn(int (*fn)(void *), void *arg, int32_t priority);
+
+	/** @brief Removes a task; it never runs again */
+	void kill(int32_t id);
+
+	/** @brief Parks or re-arms a task without destroying it */
+	void suspend(int32_t id, bool suspended);
+
+	/** @brief Id of the running task, or -1 from the harness */
+	int32_t current();
+
+	int32_t priority(int32_t id);
+	void setPriority(int32_t id, int32_t priority);
+
+	/** @brief Blocks the running task until the given absolute time */
+	void sleepUntilUs(uint64_t wakeUs);
+
+	/** @brief Lets every other ready task run once */
+	void yield();
+
+	/**
+	 * @brief Moves the clock on without letting any other task run, as if the
+	 * running task spent that long computing
+	 */
+	void busy(uint64_t us);
+
+	/**
+	 * @brief Runs tasks until the clock reaches endUs or nothing is left to run
+	 */
+	void runUntil(uint64_t endUs);
+
+	/** @brief Competition phase as reported to vex::competition */
+	enum Phase
+	{
+		kDisabled,
+		kAutonomous,
+		kDriver
+	};
+
+	/**
+	 * @brief Switches the competition phase, stopping the old competition task
+	 * and starting the registered callback for the new one
+	 */
+	void setPhase(Phase phase, bool fieldControl);
+	Phase phase();
+	bool fieldControl();
+	void setAutonomousCallback(void (*callback)(void));
+	void setDriverCallback(void (*callback)(void));
+
+	/** @brief Simulated state of one smart motor */
+	struct MotorState
+	{
+		bool installed;
+		bool reversed;
+		int gearing;          /**< 0 = 36:1, 1 = 18:1, 2 = 6:1 */
+		double commandVolts;  /**< voltage requested by the program */
+		double appliedVolts;  /**< voltage after the thermal limiter */
+		double positionDeg;   /**< output shaft position */
+		double velocityRpm;   /**< output shaft velocity */
+		double currentAmp;
+		double temperatureC;
+		double offsetDeg;     /**< subtracted from positionDeg when read */
+		bool velocityMode;    /**< firmware velocity loop instead of voltage */
+		double targetRpm;
+		double integrator;
+	};
+
+	/** @brief Simulated rotation sensor mounted on a tracking wheel */
+	struct TrackerState
+	{
+		bool installed;
+		double positionDeg;
+		double velocityDps;
+		double offsetDeg;
+	};
+
+	/** @brief Simulated inertial sensor */
+	struct ImuState
+	{
+		bool installed;
+		uint64_t calibrateUntilUs;
+		double rotationDeg;  /**< clockwise positive, unbounded */
+		double offsetDeg;
+	};
+
+	/** @brief Simulated distance sensor */
+	struct DistanceState
+	{
+		bool installed;
+		double mm;
+		bool detected;
+	};
+
+	/** @brief Controller input as seen by vex::controller */
+	struct ControllerState
+	{
+		int32_t axis[4];   /**< Axis1..Axis4, -127..127 */
+		uint32_t buttons;  /**< bit per button, in v5_vcs.h declaration order */
+	};
+
+	/** @brief Battery as seen by vex::brain::battery */
+	struct BatteryState
+	{
+		double volts;
+		double currentAmp;  /**< negative: report the sum of the motor currents */
+	};
+
+	/** @brief Sum of what the program drew, for UI cost accounting */
+	struct ScreenStats
+	{
+		uint64_t primitives;
+		uint64_t pixels;
+	};
+
+	MotorState &motor(int32_t port);
+	TrackerState &tracker(int32_t port);
+	ImuState &imu(int32_t port);
+	DistanceState &distance(int32_t port);
+	ControllerState &controller();
+	BatteryState &battery();
+	ScreenStats &screen();
+
+	/** @brief Robot pose in the field frame, inches and radians CCW from +x */
+	struct Pose
+	{
+		double x;
+		double y;
+		double theta;
+	};
+
+	/**
+	 * @brief Describes how the simulated drivetrain and sensors are mounted
+	 *
+	 * Port numbers are the zero-based smart port indices used by the SDK. A
+	 * negative port means "not fitted".
+	 */
+	struct RobotModel
+	{
+		int leftPorts[4];
+		int rightPorts[4];
+		int motorsPerSide;
+		double wheelDiameter;     /**< inches */
+		double driveRatio;        /**< wheel turns per motor output turn */
+		double trackWidth;        /**< inches */
+		double massKg;
+		int forwardTracker;
+		double forwardOffset;     /**< inches right of the tracking centre */
+		int sidewaysTracker;
+		double sidewaysOffset;    /**< inches forward of the tracking centre */
+		double trackerDiameter;   /**< inches */
+		int imuPort;
+		int distancePorts[4];
+		double distanceMount[4][3]; /**< forward, left (inches), angle (rad CCW) */
+		double imuDriftDps;         /**< degrees per second the heading drifts by */
+		double trackerScale;        /**< distance the trackers report per inch really travelled */
+	};
+
+	/** @brief Installs the model and places the robot on the field */
+	void configure(const RobotModel &model, const Pose &start);
+
+	/** @brief True pose of the simulated robot */
+	const Pose &truth();
+
+	/** @brief Most obstacles the field can hold */
+	const int kMaxObstacles = 8;
+
+	/**
+	 * @brief Puts a round obstacle on the field, such as a parked robot
+	 *
+	 * The distance sensors see it and the drive stalls against it, as at a
+	 * wall.
+	 *
+	 * @return false if the field already holds kMaxObstacles
+	 */
+	bool addObstacle(double x, double y, double radius);
+
+	/** @brief Physics steps in which an obstacle held the robot back */
+	uint32_t obstacleContacts();
+
+	/**
+	 * @brief Advances the world by dt seconds
+	 *
+	 * While a recording is being replayed (see replay.h) the devices are set
+	 * from it instead.
+	 */
+	void stepPhysics(double dt);
+
+	/** @brief Pushes bytes into the mock USB serial receive buffer */
+	void serialFeed(const uint8_t *data, uint32_t len);
+
+	/** @brief Pops one byte from the serial receive buffer, -1 when empty */
+	int32_t serialRead();
+
+	/** @brief Appends bytes the robot wrote to the USB serial port */
+	void serialSend(const uint8_t *data, uint32_t len);
+
+	/** @brief Removes and returns up to max bytes the robot has written */
+	uint32_t serialTake(uint8_t *out, uint32_t max);
+
+	/** @brief Directory used as the SD card root */
+	void setSdRoot(const char *path);
+	const char *sdRoot();
+} // namespace sim
@@ -0,0 +1,811 @@
+/**
+ * @file vex_mock.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Host implementation of the mock vex classes declared in v5_vcs.h
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Each device is a thin view onto the per-port state owned by physics.cpp,
+ * and every timing call is routed to the virtual-time scheduler.
+ */
+
+#include "v5_vcs.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sim.h"
+
+namespace
+{
+	const double kGearRpm[3] = {100.0, 200.0, 600.0};
+
+	double motorSign(const sim::MotorState &m, bool reversed)
+	{
+		return (m.reversed != reversed) ? -1.0 : 1.0;
+	}
+
+	sim::MotorState &motorAt(int32_t index)
+	{
+		return sim::motor(index);
+	}
+
+	bool validPort(int32_t index)
+	{
+		return index >= 0 && index < sim::kPorts;
+	}
+} // namespace
+
+namespace vex
+{
+	const color color::black(0x000000);
+	const color color::white(0xFFFFFF);
+	const color color::red(0xFF0000);
+	const color color::green(0x00FF00);
+	const color color::blue(0x0000FF);
+	const color color::yellow(0xFFFF00);
+	const color color::orange(0xFF9900);
+	const color color::purple(0xFF00FF);
+	const color color::cyan(0x00FFFF);
+	const color color::transparent(0x000000);
+
+	void wait(double time, timeUnits units)
+	{
+		double us = units == timeUnits::sec ? time * 1e6 : time * 1e3;
+		sim::sleepUntilUs(sim::nowUs() + (uint64_t)(us > 0 ? us : 0));
+	}
+
+	// ---- timer ---------------------------------------------------------
+
+	timer::timer() : m_start(sim::nowUs()) {}
+
+	double timer::time(timeUnits units) const
+	{
+		double us = (double)(sim::nowUs() - m_start);
+		return units == timeUnits::sec ? us / 1e6 : us / 1e3;
+	}
+
+	void timer::clear()
+	{
+		m_start = sim::nowUs();
+	}
+
+	uint32_t timer::system()
+	{
+		return (uint32_t)(sim::nowUs() / 1000);
+	}
+
+	uint64_t timer::systemHighResolution()
+	{
+		return sim::nowUs();
+	}
+
+	// ---- task ----------------------------------------------------------
+
+	namespace
+	{
+		int voidTrampoline(void *arg)
+		{
+			int (*fn)(void) = (int (*)(void))arg;
+			return fn();
+		}
+	} // namespace
+
+	task::task() : m_id(-1) {}
+
+	task::task(int (*callback)(void))
+		: m_id(sim::spawn(voidTrampoline, (void *)callback, taskPriorityNormal)) {}
+
+	task::task(int (*callback)(void), int32_t priority)
+		: m_id(sim::spawn(voidTrampoline, (void *)callback, priority)) {}
+
+	task::task(int (*callback)(void *), void *arg)
+		: m_id(sim::spawn(callback, arg, taskPriorityNormal)) {}
+
+	task::task(int (*callback)(void *), void *arg, int32_t priority)
+		: m_id(sim::spawn(callback, arg, priority)) {}
+
+	void task::stop()
+	{
+		sim::kill(m_id);
+	}
+
+	void task::suspend()
+	{
+		sim::suspend(m_id, true);
+	}
+
+	void task::resume()
+	{
+		sim::suspend(m_id, false);
+	}
+
+	int32_t task::priority()
+	{
+		return sim::priority(m_id);
+	}
+
+	void task::setPriority(int32_t priority)
+	{
+		sim::setPriority(m_id, priority);
+	}
+
+	void task::sleep(uint32_t time)
+	{
+		this_thread::sleep_for(time);
+	}
+
+	void task::yield()
+	{
+		sim::yield();
+	}
+
+	namespace this_thread
+	{
+		int32_t get_id()
+		{
+			return sim::current();
+		}
+
+		void sleep_for(uint32_t time_ms)
+		{
+			sim::sleepUntilUs(sim::nowUs() + (uint64_t)time_ms * 1000);
+		}
+
+		void sleep_until(uint32_t time)
+		{
+			sim::sleepUntilUs((uint64_t)time * 1000);
+		}
+
+		void yield()
+		{
+			sim::yield();
+		}
+	} // namespace this_thread
+
+	// ---- mutex ---------------------------------------------------------
+
+	void mutex::lock()
+	{
+		while (!try_lock())
+		{
+			sim::yield();
+		}
+	}
+
+	bool mutex::try_lock()
+	{
+		int32_t self = sim::current();
+		if (m_owner == -1 || m_owner == self)
+		{
+			m_owner = self;
+			m_depth++;
+			return true;
+		}
+		return false;
+	}
+
+	void mutex::unlock()
+	{
+		if (m_depth > 0 && --m_depth == 0)
+		{
+			m_owner = -1;
+		}
+	}
+
+	// ---- motor ---------------------------------------------------------
+
+	motor::motor(int32_t index) : motor(index, gearSetting::ratio18_1, false) {}
+	motor::motor(int32_t index, bool reverse) : motor(index, gearSetting::ratio18_1, reverse) {}
+	motor::motor(int32_t index, gearSetting gears) : motor(index, gears, false) {}
+
+	motor::motor(int32_t index, gearSetting gears, bool reverse) : m_index(index)
+	{
+		if (!validPort(index))
+		{
+			return;
+		}
+		sim::MotorState &m = motorAt(index);
+		m.installed = true;
+		m.reversed = reverse;
+		m.gearing = gears == gearSetting::ratio36_1 ? 0 : gears == gearSetting::ratio6_1 ? 2 : 1;
+	}
+
+	bool motor::installed()
+	{
+		return validPort(m_index) && motorAt(m_index).installed;
+	}
+
+	void motor::spin(directionType dir)
+	{
+		(void)dir;
+	}
+
+	void motor::spin(directionType dir, double velocity, velocityUnits units)
+	{
+		sim::MotorState &m = motorAt(m_index);
+		double rpm = velocity;
+		if (units == velocityUnits::pct)
+		{
+			rpm = velocity / 100.0 * kGearRpm[m.gearing];
+		}
+		else if (units == velocityUnits::dps)
+		{
+			rpm = velocity / 6.0;
+		}
+		m.velocityMode = true;
+		m.targetRpm = (dir == directionType::rev ? -rpm : rpm) * (m.reversed ? -1.0 : 1.0);
+	}
+
+	void motor::spin(directionType dir, double velocity, percentUnits units)
+	{
+		(void)units;
+		spin(dir, velocity, velocityUnits::pct);
+	}
+
+	void motor::spin(directionType dir, double voltage, voltageUnits units)
+	{
+		sim::MotorState &m = motorAt(m_index);
+		double volts = units == voltageUnits::mV ? voltage / 1000.0 : voltage;
+		if (volts > 12.0)
+		{
+			volts = 12.0;
+		}
+		if (volts < -12.0)
+		{
+			volts = -12.0;
+		}
+		m.velocityMode = false;
+		m.commandVolts = (dir == directionType::rev ? -volts : volts) * (m.reversed ? -1.0 : 1.0);
+	}
+
+	void motor::stop()
+	{
+		stop(brakeType::coast);
+	}
+
+	void motor::stop(brakeType mode)
+	{
+		(void)mode;
+		sim::MotorState &m = motorAt(m_index);
+		m.velocityMode = false;
+		m.commandVolts = 0.0;
+	}
+
+	void motor::setStopping(brakeType mode)
+	{
+		(void)mode;
+	}
+
+	void motor::setVelocity(double velocity, velocityUnits units)
+	{
+		(void)velocity;
+		(void)units;
+	}
+
+	void motor::setVelocity(double velocity, percentUnits units)
+	{
+		(void)velocity;
+		(void)units;
+	}
+
+	void motor::setReversed(bool value)
+	{
+		motorAt(m_index).reversed = value;
+	}
+
+	void motor::setMaxTorque(double value, percentUnits units)
+	{
+		(void)value;
+		(void)units;
+	}
+
+	void motor::resetPosition()
+	{
+		sim::MotorState &m = motorAt(m_index);
+		m.offsetDeg = m.positionDeg;
+	}
+
+	void motor::setPosition(double value, rotationUnits units)
+	{
+		sim::MotorState &m = motorAt(m_index);
+		double deg = units == rotationUnits::rev ? value * 360.0 : value;
+		m.offsetDeg = m.positionDeg - deg * motorSign(m, false);
+	}
+
+	double motor::position(rotationUnits units)
+	{
+		sim::MotorState &m = motorAt(m_index);
+		double deg = (m.positionDeg - m.offsetDeg) * motorSign(m, false);
+		return units == rotationUnits::rev ? deg / 360.0 : deg;
+	}
+
+	double motor::velocity(velocityUnits units)
+	{
+		sim::MotorState &m = motorAt(m_index);
+		double rpm = m.velocityRpm * motorSign(m, false);
+		if (units == velocityUnits::pct)
+		{
+			return rpm / kGearRpm[m.gearing] * 100.0;
+		}
+		if (units == velocityUnits::dps)
+		{
+			return rpm * 6.0;
+		}
+		return rpm;
+	}
+
+	double motor::velocity(percentUnits units)
+	{
+		(void)units;
+		return velocity(velocityUnits::pct);
+	}
+
+	double motor::current(currentUnits units)
+	{
+		(void)units;
+		return fabs(motorAt(m_index).currentAmp);
+	}
+
+	double motor::voltage(voltageUnits units)
+	{
+		sim::MotorState &m = motorAt(m_index);
+		double volts = m.appliedVolts * motorSign(m, false);
+		return units == voltageUnits::mV ? volts * 1000.0 : volts;
+	}
+
+	double motor::temperature(temperatureUnits units)
+	{
+		double c = motorAt(m_index).temperatureC;
+		return units == temperatureUnits::fahrenheit ? c * 1.8 + 32.0 : c;
+	}
+
+	double motor::torque()
+	{
+		return 0.0;
+	}
+
+	double motor::power()
+	{
+		sim::MotorState &m = motorAt(m_index);
+		return fabs(m.appliedVolts * m.currentAmp);
+	}
+
+	double motor::efficiency()
+	{
+		return 0.0;
+	}
+
+	// ---- inertial ------------------------------------------------------
+
+	inertial::inertial(int32_t index) : m_index(index)
+	{
+		if (validPort(index))
+		{
+			sim::imu(index).installed = true;
+		}
+	}
+
+	bool inertial::installed()
+	{
+		return validPort(m_index) && sim::imu(m_index).installed;
+	}
+
+	void inertial::calibrate()
+	{
+		sim::imu(m_index).calibrateUntilUs = sim::nowUs() + 2000000;
+	}
+
+	bool inertial::isCalibrating()
+	{
+		return sim::nowUs() < sim::imu(m_index).calibrateUntilUs;
+	}
+
+	void inertial::resetHeading()
+	{
+		setHeading(0.0, rotationUnits::deg);
+	}
+
+	void inertial::resetRotation()
+	{
+		setRotation(0.0, rotationUnits::deg);
+	}
+
+	void inertial::setHeading(double value, rotationUnits units)
+	{
+		setRotation(value, units);
+	}
+
+	void inertial::setRotation(double value, rotationUnits units)
+	{
+		sim::ImuState &s = sim::imu(m_index);
+		double deg = units == rotationUnits::rev ? value * 360.0 : value;
+		s.offsetDeg = s.rotationDeg - deg;
+	}
+
+	double inertial::heading(rotationUnits units)
+	{
+		double deg = fmod(rotation(rotationUnits::deg), 360.0);
+		if (deg < 0)
+		{
+			deg += 360.0;
+		}
+		return units == rotationUnits::rev ? deg / 360.0 : deg;
+	}
+
+	double inertial::rotation(rotationUnits units)
+	{
+		sim::ImuState &s = sim::imu(m_index);
+		double deg = s.rotationDeg - s.offsetDeg;
+		return units == rotationUnits::rev ? deg / 360.0 : deg;
+	}
+
+	// ---- rotation ------------------------------------------------------
+
+	rotation::rotation(int32_t index, bool reverse) : m_index(index), m_reverse(reverse)
+	{
+		if (validPort(index))
+		{
+			sim::tracker(index).installed = true;
+		}
+	}
+
+	bool rotation::installed()
+	{
+		return validPort(m_index) && sim::tracker(m_index).installed;
+	}
+
+	void rotation::setReversed(bool value)
+	{
+		m_reverse = value;
+	}
+
+	void rotation::resetPosition()
+	{
+		sim::TrackerState &s = sim::tracker(m_index);
+		s.offsetDeg = s.positionDeg;
+	}
+
+	void rotation::setPosition(double value, rotationUnits units)
+	{
+		sim::TrackerState &s = sim::tracker(m_index);
+		double deg = units == rotationUnits::rev ? value * 360.0 : value;
+		s.offsetDeg = s.positionDeg - (m_reverse ? -deg : deg);
+	}
+
+	double rotation::position(rotationUnits units)
+	{
+		sim::TrackerState &s = sim::tracker(m_index);
+		double deg = s.positionDeg - s.offsetDeg;
+		deg = m_reverse ? -deg : deg;
+		return units == rotationUnits::rev ? deg / 360.0 : deg;
+	}
+
+	double rotation::velocity(velocityUnits units)
+	{
+		sim::TrackerState &s = sim::tracker(m_index);
+		double dps = m_reverse ? -s.velocityDps : s.velocityDps;
+		return units == velocityUnits::rpm ? dps / 6.0 : dps;
+	}
+
+	// ---- distance ------------------------------------------------------
+
+	distance::distance(int32_t index) : m_index(index)
+	{
+		if (validPort(index))
+		{
+			sim::distance(index).installed = true;
+		}
+	}
+
+	bool distance::installed()
+	{
+		return validPort(m_index) && sim::distance(m_index).installed;
+	}
+
+	double distance::objectDistance(distanceUnits units)
+	{
+		double mm = sim::distance(m_index).mm;
+		if (units == distanceUnits::in)
+		{
+			return mm / 25.4;
+		}
+		if (units == distanceUnits::cm)
+		{
+			return mm / 10.0;
+		}
+		return mm;
+	}
+
+	bool distance::isObjectDetected()
+	{
+		return sim::distance(m_index).detected;
+	}
+
+	// ---- controller ----------------------------------------------------
+
+	int32_t controller::axis::value() const
+	{
+		return sim::controller().axis[m_id];
+	}
+
+	int32_t controller::axis::position(percentUnits units) const
+	{
+		(void)units;
+		return sim::controller().axis[m_id] * 100 / 127;
+	}
+
+	bool controller::button::pressing() const
+	{
+		return (sim::controller().buttons >> m_id) & 1u;
+	}
+
+	void controller::lcd::setCursor(int32_t row, int32_t col)
+	{
+		(void)row;
+		(void)col;
+	}
+
+	void controller::lcd::print(const char *format, ...)
+	{
+		(void)format;
+	}
+
+	void controller::lcd::clearScreen() {}
+	void controller::lcd::clearLine(int32_t number) { (void)number; }
+	void controller::lcd::clearLine() {}
+	void controller::lcd::newLine() {}
+
+	controller::controller() : controller(controllerType::primary) {}
+
+	controller::controller(controllerType id)
+		: Axis1(0), Axis2(1), Axis3(2), Axis4(3),
+		  ButtonL1(0), ButtonL2(1), ButtonR1(2), ButtonR2(3),
+		  ButtonUp(4), ButtonDown(5), ButtonLeft(6), ButtonRight(7),
+		  ButtonX(8), ButtonB(9), ButtonY(10), ButtonA(11)
+	{
+		(void)id;
+	}
+
+	bool controller::installed()
+	{
+		return true;
+	}
+
+	void controller::rumble(const char *pattern)
+	{
+		(void)pattern;
+	}
+
+	// ---- brain screen --------------------------------------------------
+
+	namespace
+	{
+		void count(uint64_t pixels)
+		{
+			sim::screen().primitives++;
+			sim::screen().pixels += pixels;
+		}
+	} // namespace
+
+	void brain::lcd::setFont(fontType font) { (void)font; }
+	void brain::lcd::setPenWidth(uint32_t width) { (void)width; }
+	void brain::lcd::setPenColor(const color &c) { (void)c; }
+	void brain::lcd::setFillColor(const color &c) { (void)c; }
+	void brain::lcd::clearScreen() { count(480 * 272); }
+	void brain::lcd::clearScreen(const color &c) { (void)c; count(480 * 272); }
+	void brain::lcd::setCursor(int32_t row, int32_t col) { (void)row; (void)col; }
+
+	void brain::lcd::print(const char *format, ...)
+	{
+		count(strlen(format) * 200);
+	}
+
+	void brain::lcd::printAt(int32_t x, int32_t y, const char *format, ...)
+	{
+		(void)x;
+		(void)y;
+		count(strlen(format) * 200);
+	}
+
+	void brain::lcd::newLine() {}
+	void brain::lcd::drawPixel(int x, int y) { (void)x; (void)y; count(1); }
+
+	void brain::lcd::drawLine(int x1, int y1, int x2, int y2)
+	{
+		count((uint64_t)(abs(x2 - x1) + abs(y2 - y1) + 1));
+	}
+
+	void brain::lcd::drawRectangle(int x, int y, int width, int height)
+	{
+		(void)x;
+		(void)y;
+		count((uint64_t)(width > 0 ? width : 0) * (uint64_t)(height > 0 ? height : 0));
+	}
+
+	void brain::lcd::drawRectangle(int x, int y, int width, int height, const color &c)
+	{
+		(void)c;
+		drawRectangle(x, y, width, height);
+	}
+
+	void brain::lcd::drawCircle(int x, int y, int radius)
+	{
+		(void)x;
+		(void)y;
+		count((uint64_t)(3.14159 * radius * radius));
+	}
+
+	bool brain::lcd::render()
+	{
+		count(480 * 272);
+		return true;
+	}
+
+	bool brain::lcd::pressing() { return false; }
+	int32_t brain::lcd::xPosition() { return 0; }
+	int32_t brain::lcd::yPosition() { return 0; }
+
+	// ---- SD card -------------------------------------------------------
+
+	namespace
+	{
+		void sdPath(char *out, size_t len, const char *name)
+		{
+			snprintf(out, len, "%s/%s", sim::sdRoot(), name);
+		}
+	} // namespace
+
+	bool brain::sdcard::isInserted()
+	{
+		return sim::sdRoot()[0] != '\0';
+	}
+
+	int32_t brain::sdcard::loadfile(const char *name, uint8_t *buffer, int32_t len)
+	{
+		char path[512];
+		sdPath(path, sizeof(path), name);
+		FILE *f = fopen(path, "rb");
+		if (!f)
+		{
+			return 0;
+		}
+		int32_t n = (int32_t)fread(buffer, 1, (size_t)len, f);
+		fclose(f);
+		return n;
+	}
+
+	int32_t brain::sdcard::savefile(const char *name, uint8_t *buffer, int32_t len)
+	{
+		char path[512];
+		sdPath(path, sizeof(path), name);
+		FILE *f = fopen(path, "wb");
+		if (!f)
+		{
+			return 0;
+		}
+		int32_t n = (int32_t)fwrite(buffer, 1, (size_t)len, f);
+		fclose(f);
+		return n;
+	}
+
+	int32_t brain::sdcard::appendfile(const char *name, uint8_t *buffer, int32_t len)
+	{
+		char path[512];
+		sdPath(path, sizeof(path), name);
+		FILE *f = fopen(path, "ab");
+		if (!f)
+		{
+			return 0;
+		}
+		int32_t n = (int32_t)fwrite(buffer, 1, (size_t)len, f);
+		fclose(f);
+		return n;
+	}
+
+	int32_t brain::sdcard::size(const char *name)
+	{
+		char path[512];
+		sdPath(path, sizeof(path), name);
+		FILE *f = fopen(path, "rb");
+		if (!f)
+		{
+			return 0;
+		}
+		fseek(f, 0, SEEK_END);
+		int32_t n = (int32_t)ftell(f);
+		fclose(f);
+		return n;
+	}
+
+	bool brain::sdcard::exists(const char *name)
+	{
+		char path[512];
+		sdPath(path, sizeof(path), name);
+		FILE *f = fopen(path, "rb");
+		if (!f)
+		{
+			return false;
+		}
+		fclose(f);
+		return true;
+	}
+
+	// ---- battery -------------------------------------------------------
+
+	double brain::battery::voltage(voltageUnits units)
+	{
+		double volts = sim::battery().volts;
+		return units == voltageUnits::mV ? volts * 1000.0 : volts;
+	}
+
+	double brain::battery::current(currentUnits units)
+	{
+		(void)units;
+		if (sim::battery().currentAmp >= 0.0)
+		{
+			return sim::battery().currentAmp;
+		}
+		double total = 0.0;
+		for (int32_t port = 0; port < sim::kPorts; port++)
+		{
+			total += fabs(sim::motor(port).currentAmp);
+		}
+		return total;
+	}
+
+	uint32_t brain::battery::capacity(percentUnits units)
+	{
+		(void)units;
+		return 100;
+	}
+
+	double brain::battery::temperature(percentUnits units)
+	{
+		(void)units;
+		return 30.0;
+	}
+
+	// ---- competition ---------------------------------------------------
+
+	competition::competition() {}
+
+	void competition::autonomous(void (*callback)(void))
+	{
+		sim::setAutonomousCallback(callback);
+	}
+
+	void competition::drivercontrol(void (*callback)(void))
+	{
+		sim::setDriverCallback(callback);
+	}
+
+	bool competition::isEnabled()
+	{
+		return sim::phase() != sim::kDisabled;
+	}
+
+	bool competition::isDriverControl()
+	{
+		return sim::phase() == sim::kDriver;
+	}
+
+	bool competition::isAutonomous()
+	{
+		return sim::phase() == sim::kAutonomous;
+	}
+
+	bool competition::isCompetitionSwitch()
+	{
+		return sim::fieldControl();
+	}
+
+	bool competition::isFieldControl()
+	{
+		return sim::fieldControl();
+	}
+} // namespace vex
@@ -0,0 +1,58 @@
+/**
+ * @file arena.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Arena allocator and the program-wide RobotArena
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "arena.h"
+
+namespace art
+{
+	namespace
+	{
+		/**
+		 * @brief Backing memory for RobotArena, placed in .bss so it costs
+		 * nothing in the program binary
+		 */
+		alignas(max_align_t) uint8_t s_robotArenaBuffer[ART_ARENA_SIZE];
+	} // namespace
+
+	Arena RobotArena(s_robotArenaBuffer, sizeof(s_robotArenaBuffer));
+
+	Arena::Arena(void *buffer, size_t capacity)
+		: m_buffer(static_cast<uint8_t *>(buffer)), m_capacity(capacity), m_used(0), m_peak(0),
+		  m_failures(0)
+	{
+	}
+
+	void *Arena::allocate(size_t size, size_t align)
+	{
+		uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer);
+		uintptr_t start = (base + m_used + (align - 1)) & ~(uintptr_t)(align - 1);
+		size_t offset = start - base;
+		if (offset > m_capacity || size > m_capacity - offset)
+		{
+			m_failures++;
+			return NULL;
+		}
+
+		m_used = offset + size;
+		if (m_used > m_peak)
+		{
+			m_peak = m_used;
+		}
+		return m_buffer + offset;
+	}
+
+	void Arena::rewind(size_t mark)
+	{
+		if (mark < m_used)
+		{
+			m_used = mark;
+		}
+	}
+} // namespace art
@@ -0,0 +1,104 @@
+/**
+ * @file assist.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining DriveAssist
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The prediction holds the robot's speed and turn rate constant over the
+ * lead. Like an odometry step, the displacement is then a chord of the arc,
+ * pointing along the average heading over the step: the field-frame velocity
+ * rotated by half the turn. At the leads involved, a few tens of
+ * milliseconds, the rates barely change, so nothing fancier is needed.
+ */
+
+#include "assist.h"
+
+#include <math.h>
+
+namespace art
+{
+	Pose predictPose(const OdometryState &state, float seconds)
+	{
+		float turn = state.velocity.theta * seconds;
+		float c = cosf(turn * 0.5f);
+		float s = sinf(turn * 0.5f);
+		Pose pose = {
+			state.pose.x + (state.velocity.x * c - state.velocity.y * s) * seconds,
+			state.pose.y + (state.velocity.x * s + state.velocity.y * c) * seconds,
+			state.pose.theta + turn,
+		};
+		return pose;
+	}
+
+	DriveAssist::DriveAssist(const AssistConfig &config)
+		: m_config(config), m_enabled(true), m_mode(kAssistOff), m_holdHeading(0.0f), m_predicted(), m_leadUs(0),
+		  m_latencyUs(0), m_worstLatencyUs(0), m_holdTicks(0), m_aimTicks(0)
+	{
+	}
+
+	void DriveAssist::setEnabled(bool enabled)
+	{
+		m_enabled = enabled;
+		m_mode = kAssistOff;
+	}
+
+	float DriveAssist::correction(float error, float rate, float kp, float kd) const
+	{
+		// a positive turn command drives the left side faster, turning clockwise, against theta
+		float turn = kd * rate - kp * error;
+		float limit = m_config.maxCorrection;
+		return turn > limit ? limit : (turn < -limit ? -limit : turn);
+	}
+
+	ArcadeCommand DriveAssist::update(const ArcadeCommand &driver, const OdometryState &state, uint64_t sampleUs,
+									  bool aim)
+	{
+		uint64_t now = timeUs();
+		uint32_t response = (uint32_t)(m_config.responseLatency * 1e6f);
+		m_latencyUs = (uint32_t)(now - sampleUs) + response;
+		m_worstLatencyUs = m_latencyUs > m_worstLatencyUs ? m_latencyUs : m_worstLatencyUs;
+
+		// the command takes effect a response time from now; predict the pose to then
+		float lead = (float)(now > state.timeUs ? now - state.timeUs : 0) * 1e-6f + m_config.responseLatency;
+		lead = lead < m_config.maxLead ? lead : m_config.maxLead;
+		m_leadUs = (uint32_t)(lead * 1e6f);
+		m_predicted = predictPose(state, lead);
+
+		ArcadeCommand command = driver;
+		if (!m_enabled)
+		{
+			return command;
+		}
+
+		float rate = state.velocity.theta;
+		float dx = m_config.aimX - m_predicted.x;
+		float dy = m_config.aimY - m_predicted.y;
+		if (aim && dx * dx + dy * dy > m_config.aimMinRange * m_config.aimMinRange)
+		{
+			float target = atan2f(dy, dx);
+			command.turn = correction(wrapAngle(target - m_predicted.theta), rate, m_config.aimKp, m_config.aimKd);
+			m_mode = kAssistAim;
+			m_aimTicks++;
+		}
+		else if (aim || fabsf(driver.turn) < m_config.turnDeadband)
+		{
+			if (m_mode != kAssistHold)
+			{
+				// where the turn will have carried the robot by the time it can react
+				m_holdHeading = m_predicted.theta;
+				m_mode = kAssistHold;
+			}
+			command.turn = correction(wrapAngle(m_holdHeading - m_predicted.theta), rate, m_config.holdKp,
+									  m_config.holdKd);
+			m_holdTicks++;
+		}
+		else
+		{
+			m_mode = kAssistOff;
+		}
+		return command;
+	}
+} // namespace art
@@ -0,0 +1,315 @@
+/**
+ * @file command.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the basic Commands, the groups and the
+ * CommandRunner
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "command.h"
+
+#include "scheduler.h"
+
+namespace art
+{
+	InstantCommand::InstantCommand(Fn fn, void *context) : m_fn(fn), m_context(context) {}
+
+	bool InstantCommand::update()
+	{
+		m_fn(m_context);
+		return true;
+	}
+
+	WaitCommand::WaitCommand(uint32_t durationMs) : m_durationUs(durationMs * 1000), m_startUs(0) {}
+
+	void WaitCommand::start()
+	{
+		m_startUs = timeUs();
+	}
+
+	bool WaitCommand::update()
+	{
+		return timeUs() - m_startUs >= m_durationUs;
+	}
+
+	WaitUntilCommand::WaitUntilCommand(Condition condition, void *context, uint32_t timeoutMs)
+		: m_condition(condition), m_context(context), m_timeoutMs(timeoutMs), m_startUs(0), m_timedOut(false)
+	{
+	}
+
+	void WaitUntilCommand::start()
+	{
+		m_startUs = timeUs();
+		m_timedOut = false;
+	}
+
+	bool WaitUntilCommand::update()
+	{
+		if (m_condition(m_context))
+		{
+			return true;
+		}
+		m_timedOut = m_timeoutMs != kForever && timeUs() - m_startUs >= (uint64_t)m_timeoutMs * 1000;
+		return m_timedOut;
+	}
+
+	CommandGroup::CommandGroup(Command *const *children, size_t count)
+		: m_children(children), m_count(count <= kMaxChildren ? count : 0), m_running(0),
+		  m_fits(count <= kMaxChildren), m_failed(false)
+	{
+	}
+
+	bool CommandGroup::valid() const
+	{
+		if (!m_fits)
+		{
+			return false;
+		}
+		for (size_t i = 0; i < m_count; i++)
+		{
+			if (!m_children[i]->valid())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void CommandGroup::end(bool)
+	{
+		endRunning(true);
+	}
+
+	void CommandGroup::startAll()
+	{
+		m_running = 0;
+		m_failed = false;
+		for (size_t i = 0; i < m_count; i++)
+		{
+			m_children[i]->start();
+			m_running |= 1u << i;
+		}
+	}
+
+	void CommandGroup::endRunning(bool interrupted)
+	{
+		for (size_t i = 0; i < m_count; i++)
+		{
+			if (running(i))
+			{
+				m_children[i]->end(interrupted);
+			}
+		}
+		m_running = 0;
+	}
+
+	bool CommandGroup::updateChild(size_t i)
+	{
+		if (!running(i))
+		{
+			return true;
+		}
+		if (!m_children[i]->update())
+		{
+			return false;
+		}
+		m_children[i]->end(false);
+		m_running &= ~(1u << i);
+		m_failed = m_failed || m_children[i]->failed();
+		return true;
+	}
+
+	Sequence::Sequence(Command *const *children, size_t count) : CommandGroup(children, count), m_current(0) {}
+
+	void Sequence::start()
+	{
+		m_current = 0;
+		m_running = 0;
+		m_failed = false;
+		if (m_count)
+		{
+			m_children[0]->start();
+			m_running = 1u;
+		}
+	}
+
+	bool Sequence::update()
+	{
+		while (m_current < m_count)
+		{
+			if (!updateChild(m_current))
+			{
+				return false;
+			}
+			if (m_failed)
+			{
+				return true;
+			}
+			m_current++;
+			if (m_current < m_count)
+			{
+				m_children[m_current]->start();
+				m_running = 1u << m_current;
+			}
+		}
+		return true;
+	}
+
+	Parallel::Parallel(Command *const *children, size_t count) : CommandGroup(children, count) {}
+
+	void Parallel::start()
+	{
+		startAll();
+	}
+
+	bool Parallel::update()
+	{
+		for (size_t i = 0; i < m_count; i++)
+		{
+			updateChild(i);
+		}
+		return m_running == 0;
+	}
+
+	Race::Race(Command *const *children, size_t count) : CommandGroup(children, count) {}
+
+	void Race::start()
+	{
+		startAll();
+	}
+
+	bool Race::update()
+	{
+		bool finished = m_count == 0;
+		for (size_t i = 0; i < m_count; i++)
+		{
+			finished = updateChild(i) || finished;
+		}
+		if (finished)
+		{
+			endRunning(true);
+		}
+		return finished;
+	}
+
+	Deadline::Deadline(Command *const *children, size_t count) : CommandGroup(children, count) {}
+
+	void Deadline::start()
+	{
+		startAll();
+	}
+
+	bool Deadline::update()
+	{
+		if (m_count == 0)
+		{
+			return true;
+		}
+		for (size_t i = 1; i < m_count; i++)
+		{
+			updateChild(i);
+		}
+		if (!updateChild(0))
+		{
+			return false;
+		}
+		endRunning(true);
+		return true;
+	}
+
+	CommandRunner::CommandRunner()
+	{
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			m_commands[i] = NULL;
+		}
+	}
+
+	bool CommandRunner::schedule(Command &command)
+	{
+		if (running(command) || !command.valid())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			if (!m_commands[i])
+			{
+				m_commands[i] = &command;
+				command.start();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CommandRunner::cancel(Command &command)
+	{
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			if (m_commands[i] == &command)
+			{
+				m_commands[i] = NULL;
+				command.end(true);
+			}
+		}
+	}
+
+	void CommandRunner::cancelAll()
+	{
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			if (m_commands[i])
+			{
+				Command *command = m_commands[i];
+				m_commands[i] = NULL;
+				command->end(true);
+			}
+		}
+	}
+
+	void CommandRunner::run()
+	{
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			Command *command = m_commands[i];
+			if (command && command->update())
+			{
+				m_commands[i] = NULL;
+				command->end(false);
+			}
+		}
+	}
+
+	bool CommandRunner::running(const Command &command) const
+	{
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			if (m_commands[i] == &command)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool CommandRunner::idle() const
+	{
+		for (size_t i = 0; i < kMaxCommands; i++)
+		{
+			if (m_commands[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void CommandRunner::tick(void *runner)
+	{
+		static_cast<CommandRunner *>(runner)->run();
+	}
+} // namespace art
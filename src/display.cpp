@@ -0,0 +1,256 @@
+/**
+ * @file display.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Brain screen widgets and the Display task
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "display.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "scheduler.h"
+
+namespace art
+{
+	namespace
+	{
+		const vex::color kBackground = vex::color::black;
+		const vex::color kForeground = vex::color::white;
+		const vex::color kBarEmpty = vex::color(40, 40, 40);
+		const vex::color kBarFull = vex::color::green;
+
+		/** @brief Distance from the top of a row of mono20 text to its baseline */
+		const int kBaseline = 16;
+	} // namespace
+
+	Display BrainDisplay(Brain.Screen);
+
+	Widget::Widget(int x, int y, int width, int height)
+		: m_x(x), m_y(y), m_width(width), m_height(height), m_drawnVersion(UINT32_MAX)
+	{
+	}
+
+	void Widget::clear(vex::brain::lcd &screen)
+	{
+		screen.setPenColor(kBackground);
+		screen.drawRectangle(m_x, m_y, m_width, m_height, kBackground);
+		screen.setPenColor(kForeground);
+	}
+
+	TextField::TextField(int x, int y, int width, const char *label)
+		: Widget(x, y, width, 20), m_label(label)
+	{
+	}
+
+	void TextField::set(const char *text)
+	{
+		// the caller is the only writer, so reading back never has to retry
+		if (strcmp(m_text.read().c_str(), text) == 0)
+		{
+			return;
+		}
+		m_text.write(FixedString<kLength>(text));
+	}
+
+	void TextField::setf(const char *format, ...)
+	{
+		char text[kLength + 1];
+		va_list args;
+		va_start(args, format);
+		vsnprintf(text, sizeof(text), format, args);
+		va_end(args);
+		set(text);
+	}
+
+	void TextField::draw(vex::brain::lcd &screen)
+	{
+		FixedString<kLength> text = m_text.read();
+		clear(screen);
+		screen.setFont(vex::fontType::mono20);
+		screen.printAt(m_x, m_y + kBaseline, "%s %s", m_label, text.c_str());
+	}
+
+	Gauge::Gauge(int x, int y, int width, int height, const char *label, float minimum, float maximum)
+		: Widget(x, y, width, height), m_label(label), m_minimum(minimum), m_maximum(maximum)
+	{
+		m_last.fill = -1;
+		m_last.value = 0;
+	}
+
+	void Gauge::set(float value)
+	{
+		float fraction = (value - m_minimum) / (m_maximum - m_minimum);
+		fraction = fraction < 0.0f ? 0.0f : (fraction > 1.0f ? 1.0f : fraction);
+
+		Shown shown;
+		shown.fill = (int16_t)(fraction * (float)barWidth());
+		shown.value = (int16_t)lroundf(value);
+		if (shown.fill == m_last.fill && shown.value == m_last.value)
+		{
+			return;
+		}
+		m_last = shown;
+		m_shown.write(shown);
+	}
+
+	void Gauge::draw(vex::brain::lcd &screen)
+	{
+		Shown shown = m_shown.read();
+		int barX = m_x + kLabelWidth;
+		int fill = shown.fill < 0 ? 0 : shown.fill;
+
+		clear(screen);
+		screen.setFont(vex::fontType::mono20);
+		screen.printAt(m_x, m_y + kBaseline, "%s", m_label);
+		screen.drawRectangle(barX, m_y, fill, m_height, kBarFull);
+		screen.drawRectangle(barX + fill, m_y, barWidth() - fill, m_height, kBarEmpty);
+		screen.printAt(barX + barWidth() + 6, m_y + kBaseline, "%d", shown.value);
+	}
+
+	AutonSelector::AutonSelector(int x, int y, int width, int height, const char *const *names, size_t count)
+		: Widget(x, y, width, height), m_names(names), m_count(count), m_selected(0), m_version(0)
+	{
+	}
+
+	void AutonSelector::setNames(const char *const *names, size_t count)
+	{
+		m_names = names;
+		m_count = count;
+		m_selected.store(0, std::memory_order_release);
+		m_version.fetch_add(1, std::memory_order_release);
+	}
+
+	void AutonSelector::draw(vex::brain::lcd &screen)
+	{
+		clear(screen);
+		screen.setPenColor(kForeground);
+		screen.drawRectangle(m_x, m_y, m_width, m_height, kBarEmpty);
+		screen.setFont(vex::fontType::mono20);
+		screen.printAt(m_x + 6, m_y + m_height / 2 + 6, "Auton: %s", selectedName());
+	}
+
+	void AutonSelector::touch(int, int)
+	{
+		m_selected.store((selected() + 1) % m_count, std::memory_order_release);
+		m_version.fetch_add(1, std::memory_order_release);
+	}
+
+	CustomWidget::CustomWidget(int x, int y, int width, int height, DrawFn draw, void *context)
+		: Widget(x, y, width, height), m_draw(draw), m_context(context), m_version(0)
+	{
+	}
+
+	void CustomWidget::draw(vex::brain::lcd &screen)
+	{
+		clear(screen);
+		m_draw(screen, m_x, m_y, m_context);
+	}
+
+	Display::Display(vex::brain::lcd &screen)
+		: m_screen(screen), m_started(false), m_wasPressing(false), m_frameUs(kFrameMs * 1000), m_frames(0),
+		  m_widgetsDrawn(0), m_worstFrameUs(0)
+	{
+	}
+
+	bool Display::add(Widget &widget)
+	{
+		return !m_started && m_widgets.push_back(&widget);
+	}
+
+	void Display::start()
+	{
+		if (m_started)
+		{
+			return;
+		}
+		m_started = true;
+		m_screen.clearScreen(kBackground);
+		m_task = vex::task(taskEntry, this, vex::task::taskPrioritylow);
+	}
+
+	int Display::taskEntry(void *self)
+	{
+		Display *display = static_cast<Display *>(self);
+		uint64_t release = timeUs();
+		while (true)
+		{
+			display->frame();
+			display->m_watch.checkIn();
+			release += display->m_frameUs.load(std::memory_order_relaxed);
+			uint64_t now = timeUs();
+			if (release < now)
+			{
+				// a slow frame pushes the next one back rather than bunching them up
+				release = now;
+			}
+			sleepUntil(release);
+		}
+		return 0;
+	}
+
+	bool Display::watch(Watchdog &watchdog)
+	{
+		return m_watch.attach(watchdog, "display", kFrameMs, 1000, false);
+	}
+
+	void Display::setSlowdown(uint32_t factor)
+	{
+		if (factor == 0)
+		{
+			return;
+		}
+		m_frameUs.store(kFrameMs * 1000 * factor, std::memory_order_relaxed);
+		m_watch.setPeriod(kFrameMs * factor);
+	}
+
+	void Display::frame()
+	{
+		PROFILE_SCOPE("display");
+
+		uint64_t start = timeUs();
+
+		bool pressing = m_screen.pressing();
+		if (pressing && !m_wasPressing)
+		{
+			int x = m_screen.xPosition();
+			int y = m_screen.yPosition();
+			for (size_t i = 0; i < m_widgets.size(); i++)
+			{
+				if (m_widgets[i]->contains(x, y))
+				{
+					m_widgets[i]->touch(x, y);
+				}
+			}
+		}
+		m_wasPressing = pressing;
+
+		uint32_t drawn = 0;
+		for (size_t i = 0; i < m_widgets.size(); i++)
+		{
+			Widget &widget = *m_widgets[i];
+			uint32_t version = widget.version();
+			if (version != widget.m_drawnVersion)
+			{
+				widget.m_drawnVersion = version;
+				widget.draw(m_screen);
+				drawn++;
+			}
+		}
+
+		if (drawn)
+		{
+			m_frames++;
+			m_widgetsDrawn += drawn;
+			uint32_t elapsed = (uint32_t)(timeUs() - start);
+			m_worstFrameUs = elapsed > m_worstFrameUs ? elapsed : m_worstFrameUs;
+		}
+	}
+} // namespace art
@@ -0,0 +1,179 @@
+/**
+ * @file fieldMap.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the FieldMap's queries and obstacle detection
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A reading is placed on the field by following the beam from the sensor
+ * out to its range. A hit inside the fixed layer is the wall or a known
+ * element seen from close enough that odometry error cannot put it anywhere
+ * else, and is not an obstacle. Anything else is taken to be the near side
+ * of an object the size of ObstacleConfig::radius, whose centre lies
+ * that much further along the beam, and the cells within the object's radius
+ * plus the robot's clearance of that centre are marked.
+ */
+
+#include "fieldMap.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace art
+{
+	FieldMap::FieldMap(const FieldGrid &fixed, const ObstacleConfig &config)
+		: m_fixed(fixed), m_config(config), m_marks(0), m_revision(0)
+	{
+		clearDetections();
+	}
+
+	bool FieldMap::blockedCell(int cellX, int cellY, int layers) const
+	{
+		if (cellX < 0 || cellY < 0 || cellX >= FieldGrid::kCellsPerSide || cellY >= FieldGrid::kCellsPerSide)
+		{
+			return true;
+		}
+		if ((layers & kFixedLayer) && m_fixed.occupied(cellX, cellY))
+		{
+			return true;
+		}
+		int cell = cellY * FieldGrid::kCellsPerSide + cellX;
+		return (layers & kDetectedLayer) && ((m_detected[cell >> 5] >> (cell & 31)) & 1u);
+	}
+
+	bool FieldMap::blocked(float x, float y, int layers) const
+	{
+		return blockedCell((int)floorf(x / kFieldCellInches), (int)floorf(y / kFieldCellInches), layers);
+	}
+
+	bool FieldMap::sweptBlocked(float ax, float ay, float bx, float by, int layers) const
+	{
+		// walk the cells the segment crosses in order, one border at a time
+		float gx = ax / kFieldCellInches;
+		float gy = ay / kFieldCellInches;
+		float dx = bx / kFieldCellInches - gx;
+		float dy = by / kFieldCellInches - gy;
+		int cellX = (int)floorf(gx);
+		int cellY = (int)floorf(gy);
+		int endX = (int)floorf(bx / kFieldCellInches);
+		int endY = (int)floorf(by / kFieldCellInches);
+		if (blockedCell(cellX, cellY, layers))
+		{
+			return true;
+		}
+
+		int stepX = dx > 0.0f ? 1 : -1;
+		int stepY = dy > 0.0f ? 1 : -1;
+		float deltaX = dx != 0.0f ? fabsf(1.0f / dx) : 1e30f;
+		float deltaY = dy != 0.0f ? fabsf(1.0f / dy) : 1e30f;
+		float nextX = dx > 0.0f ? (cellX + 1 - gx) * deltaX : dx < 0.0f ? (gx - cellX) * deltaX : 1e30f;
+		float nextY = dy > 0.0f ? (cellY + 1 - gy) * deltaY : dy < 0.0f ? (gy - cellY) * deltaY : 1e30f;
+		int crossings = abs(endX - cellX) + abs(endY - cellY);
+		for (int i = 0; i < crossings; i++)
+		{
+			if (nextX < nextY)
+			{
+				cellX += stepX;
+				nextX += deltaX;
+			}
+			else
+			{
+				cellY += stepY;
+				nextY += deltaY;
+			}
+			if (blockedCell(cellX, cellY, layers))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool FieldMap::observe(int sensor, const Pose &pose, const RangeMount &mount, float range)
+	{
+		if (sensor < 0 || sensor >= kMaxSensors)
+		{
+			return false;
+		}
+		Hit &last = m_last[sensor];
+		if (range < 0.0f || range > m_config.maxRange)
+		{
+			last.valid = false;
+			return false;
+		}
+
+		float c = cosf(pose.theta);
+		float s = sinf(pose.theta);
+		float beam = pose.theta + mount.angle;
+		float beamX = cosf(beam);
+		float beamY = sinf(beam);
+		float x = pose.x + mount.forward * c - mount.left * s + range * beamX;
+		float y = pose.y + mount.forward * s + mount.left * c + range * beamY;
+		if (blocked(x, y, kFixedLayer))
+		{
+			last.valid = false;
+			return false;
+		}
+
+		bool confirmed = last.valid && hypotf(x - last.x, y - last.y) <= m_config.confirm;
+		last.x = x;
+		last.y = y;
+		last.valid = true;
+		if (!confirmed)
+		{
+			return false;
+		}
+		return markDisc(x + m_config.radius * beamX, y + m_config.radius * beamY,
+						m_config.radius + m_fixed.clearance());
+	}
+
+	bool FieldMap::markDisc(float x, float y, float radius)
+	{
+		int side = FieldGrid::kCellsPerSide;
+		int minX = (int)floorf((x - radius) / kFieldCellInches);
+		int maxX = (int)floorf((x + radius) / kFieldCellInches);
+		int minY = (int)floorf((y - radius) / kFieldCellInches);
+		int maxY = (int)floorf((y + radius) / kFieldCellInches);
+		minX = minX < 0 ? 0 : minX;
+		minY = minY < 0 ? 0 : minY;
+		maxX = maxX >= side ? side - 1 : maxX;
+		maxY = maxY >= side ? side - 1 : maxY;
+
+		bool marked = false;
+		for (int cellY = minY; cellY <= maxY; cellY++)
+		{
+			float cy = (cellY + 0.5f) * kFieldCellInches - y;
+			for (int cellX = minX; cellX <= maxX; cellX++)
+			{
+				float cx = (cellX + 0.5f) * kFieldCellInches - x;
+				int cell = cellY * FieldGrid::kCellsPerSide + cellX;
+				uint32_t bit = 1u << (cell & 31);
+				if (cx * cx + cy * cy <= radius * radius && !(m_detected[cell >> 5] & bit))
+				{
+					m_detected[cell >> 5] |= bit;
+					marked = true;
+				}
+			}
+		}
+		if (marked)
+		{
+			m_marks++;
+			m_revision++;
+		}
+		return marked;
+	}
+
+	void FieldMap::clearDetections()
+	{
+		memset(m_detected, 0, sizeof(m_detected));
+		for (int i = 0; i < kMaxSensors; i++)
+		{
+			m_last[i].valid = false;
+		}
+		m_marks = 0;
+		m_revision++;
+	}
+} // namespace art
@@ -0,0 +1,260 @@
+/**
+ * @file follower.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining Path, PurePursuit and Ramsete
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "follower.h"
+
+#include <math.h>
+
+namespace art
+{
+	namespace
+	{
+		const float kPi = 3.14159265f;
+
+		/**
+		 * @brief Walks a trajectory, calling emit every `spacing` inches
+		 *
+		 * @return number of points emitted
+		 */
+		template <typename Emit>
+		size_t resample(const Trajectory &trajectory, float spacing, Emit emit)
+		{
+			size_t emitted = 0;
+			TrajectoryState previous = trajectory.at(0);
+			float travelled = 0.0f;
+			float next = 0.0f;
+			for (uint32_t k = 1; k < trajectory.count(); k++)
+			{
+				TrajectoryState current = trajectory.at(k);
+				float step = hypotf(current.pose.x - previous.pose.x, current.pose.y - previous.pose.y);
+				while (step > 0.0f && next <= travelled + step)
+				{
+					float frac = (next - travelled) / step;
+					PathPoint point;
+					point.x = previous.pose.x + (current.pose.x - previous.pose.x) * frac;
+					point.y = previous.pose.y + (current.pose.y - previous.pose.y) * frac;
+					point.distance = next;
+					point.velocity = previous.velocity + (current.velocity - previous.velocity) * frac;
+					emit(emitted++, point);
+					next += spacing;
+				}
+				travelled += step;
+				previous = current;
+			}
+
+			// always finish exactly on the last sample
+			PathPoint last;
+			last.x = previous.pose.x;
+			last.y = previous.pose.y;
+			last.distance = travelled;
+			last.velocity = 0.0f;
+			emit(emitted++, last);
+			return emitted;
+		}
+
+		struct CountPoints
+		{
+			void operator()(size_t, const PathPoint &) {}
+		};
+
+		struct StorePoints
+		{
+			PathPoint *points;
+			void operator()(size_t i, const PathPoint &point) { points[i] = point; }
+		};
+
+		float distanceTo(const PathPoint &point, const Pose &pose)
+		{
+			return hypotf(point.x - pose.x, point.y - pose.y);
+		}
+	} // namespace
+
+	Path::Path() : m_points(NULL), m_count(0), m_spacing(1.0f)
+	{
+	}
+
+	Path::Path(const PathPoint *points, size_t count, float spacing)
+		: m_points(points), m_count(count), m_spacing(spacing)
+	{
+	}
+
+	Path Path::fromTrajectory(const Trajectory &trajectory, float spacing, Arena &arena)
+	{
+		if (!trajectory.valid() || trajectory.count() < 2 || spacing <= 0.0f)
+		{
+			return Path();
+		}
+
+		size_t count = resample(trajectory, spacing, CountPoints());
+		PathPoint *points = arena.createArray<PathPoint>(count);
+		if (!points)
+		{
+			return Path();
+		}
+		StorePoints store = {points};
+		resample(trajectory, spacing, store);
+		return Path(points, count, spacing);
+	}
+
+	PurePursuit::PurePursuit(const PursuitConfig &config)
+		: m_config(config), m_path(), m_index(0), m_window(0), m_finished(true), m_target()
+	{
+	}
+
+	void PurePursuit::begin(const Path &path)
+	{
+		m_path = path;
+		m_index = 0;
+		m_finished = !path.valid();
+		m_window = m_config.window;
+		if (m_window == 0)
+		{
+			// enough segments to reach past the lookahead circle with room to spare
+			m_window = (size_t)ceilf(2.0f * m_config.lookahead / path.spacing()) + 4;
+		}
+	}
+
+	DriveCommand PurePursuit::update(const Pose &pose)
+	{
+		DriveCommand stop = {0.0f, 0.0f};
+		if (m_finished)
+		{
+			return stop;
+		}
+
+		size_t last = m_path.size() - 1;
+		size_t end = m_index + m_window < last ? m_index + m_window : last;
+
+		// closest segment, searched only forward from the previous match
+		size_t closest = m_index;
+		float best = 1e30f;
+		for (size_t i = m_index; i < end; i++)
+		{
+			const PathPoint &a = m_path[i];
+			const PathPoint &b = m_path[i + 1];
+			float dx = b.x - a.x;
+			float dy = b.y - a.y;
+			float lengthSq = dx * dx + dy * dy;
+			float t = lengthSq > 0.0f ? ((pose.x - a.x) * dx + (pose.y - a.y) * dy) / lengthSq : 0.0f;
+			t = fminf(fmaxf(t, 0.0f), 1.0f);
+			float ex = a.x + dx * t - pose.x;
+			float ey = a.y + dy * t - pose.y;
+			float distanceSq = ex * ex + ey * ey;
+			if (distanceSq < best)
+			{
+				best = distanceSq;
+				closest = i;
+			}
+		}
+		m_index = closest;
+
+		const PathPoint &end0 = m_path[last - 1];
+		const PathPoint &end1 = m_path[last];
+		float past = (pose.x - end1.x) * (end1.x - end0.x) + (pose.y - end1.y) * (end1.y - end0.y);
+		if (m_index + 1 >= last && (past >= 0.0f || distanceTo(end1, pose) < m_config.endTolerance))
+		{
+			m_finished = true;
+			return stop;
+		}
+
+		// lookahead point: the furthest crossing of the circle before the path leaves it
+		float lookahead = m_config.lookahead;
+		bool found = false;
+		float tx = m_path[last].x;
+		float ty = m_path[last].y;
+		end = m_index + m_window < last ? m_index + m_window : last;
+		for (size_t i = m_index; i < end; i++)
+		{
+			const PathPoint &a = m_path[i];
+			const PathPoint &b = m_path[i + 1];
+			float dx = b.x - a.x;
+			float dy = b.y - a.y;
+			float fx = a.x - pose.x;
+			float fy = a.y - pose.y;
+			float qa = dx * dx + dy * dy;
+			float qb = 2.0f * (fx * dx + fy * dy);
+			float qc = fx * fx + fy * fy - lookahead * lookahead;
+			float discriminant = qb * qb - 4.0f * qa * qc;
+			if (qa > 0.0f && discriminant >= 0.0f)
+			{
+				float root = sqrtf(discriminant);
+				float t = (-qb + root) / (2.0f * qa);
+				// the last segment carries on past the end, so the robot lines
+				// up with the final heading instead of steering onto a point
+				bool extended = i + 1 == last;
+				if (t >= 0.0f && (t <= 1.0f || extended))
+				{
+					tx = a.x + dx * t;
+					ty = a.y + dy * t;
+					found = true;
+				}
+			}
+			if (found && distanceTo(b, pose) > lookahead)
+			{
+				break;
+			}
+		}
+		if (!found)
+		{
+			// off the path entirely: head back toward the next point on it
+			tx = m_path[m_index + 1].x;
+			ty = m_path[m_index + 1].y;
+		}
+
+		float velocity = m_path[m_index].velocity;
+		bool reversed = velocity < 0.0f || (velocity == 0.0f && m_path[m_index + 1].velocity < 0.0f);
+		float speed = fmaxf(fabsf(velocity), m_config.minVelocity);
+
+		// curvature of the arc through the target, in the direction of travel
+		float heading = reversed ? pose.theta + kPi : pose.theta;
+		float dx = tx - pose.x;
+		float dy = ty - pose.y;
+		float lateral = -sinf(heading) * dx + cosf(heading) * dy;
+		float distanceSq = dx * dx + dy * dy;
+		float curvature = distanceSq > 1e-6f ? 2.0f * lateral / distanceSq : 0.0f;
+
+		m_target.x = tx;
+		m_target.y = ty;
+		m_target.theta = atan2f(dy, dx);
+
+		float v = reversed ? -speed : speed;
+		float omega = curvature * speed;
+		float turn = omega * m_config.trackWidth * 0.5f;
+		DriveCommand command = {v - turn, v + turn};
+		return command;
+	}
+
+	Ramsete::Ramsete(const RamseteConfig &config) : m_config(config)
+	{
+	}
+
+	DriveCommand Ramsete::update(const Pose &pose, const TrajectoryState &target) const
+	{
+		float dx = target.pose.x - pose.x;
+		float dy = target.pose.y - pose.y;
+		float c = cosf(pose.theta);
+		float s = sinf(pose.theta);
+		float errorX = c * dx + s * dy;
+		float errorY = -s * dx + c * dy;
+		float errorTheta = wrapAngle(target.pose.theta - pose.theta);
+
+		float vd = target.velocity;
+		float wd = target.angularVelocity;
+		float k = 2.0f * m_config.zeta * sqrtf(wd * wd + m_config.b * vd * vd);
+		float sinc = fabsf(errorTheta) > 1e-4f ? sinf(errorTheta) / errorTheta : 1.0f;
+
+		float v = vd * cosf(errorTheta) + k * errorX;
+		float omega = wd + k * errorTheta + m_config.b * vd * sinc * errorY;
+
+		float turn = omega * m_config.trackWidth * 0.5f;
+		DriveCommand command = {v - turn, v + turn};
+		return command;
+	}
+} // namespace art
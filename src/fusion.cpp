@@ -0,0 +1,157 @@
+/**
+ * @file fusion.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining PoseFilter
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The motion model is the same arc integration Odometry has always done, so
+ * with no readings the filter's pose is exactly the dead-reckoned one. Its
+ * Jacobian only couples heading into position: turning the start of a step
+ * by a small angle swings the step's displacement sideways.
+ *
+ * A wall reading is modelled as the length of the beam from the sensor to
+ * the first wall along it. For a wall at x = W the beam from (sx, sy) at
+ * angle phi has length h = (W - sx) / cos(phi), and the walls at y = 0 and
+ * y = W are the same with sin(phi). Their derivatives with respect to x, y
+ * and theta make up the 1x3 measurement Jacobian.
+ */
+
+#include "fusion.h"
+
+#include <math.h>
+
+#include "odometry.h"
+
+namespace art
+{
+	namespace
+	{
+		/** @brief Beams landing closer than this to a corner could be seeing either wall */
+		const float kCornerMargin = 6.0f;
+
+		/** @brief Starting uncertainty after reset(): a quarter inch and about a degree */
+		const float kResetPositionVariance = 0.0625f;
+		const float kResetHeadingVariance = 0.0003f;
+	} // namespace
+
+	PoseFilter::PoseFilter(const FusionConfig &config) : m_config(config), m_accepted(0), m_rejected(0)
+	{
+		Pose origin = {0.0f, 0.0f, 0.0f};
+		reset(origin);
+	}
+
+	void PoseFilter::reset(const Pose &pose)
+	{
+		m_state(0, 0) = pose.x;
+		m_state(1, 0) = pose.y;
+		m_state(2, 0) = pose.theta;
+		m_covariance = Covariance::zero();
+		m_covariance(0, 0) = kResetPositionVariance;
+		m_covariance(1, 1) = kResetPositionVariance;
+		m_covariance(2, 2) = kResetHeadingVariance;
+	}
+
+	Pose PoseFilter::pose() const
+	{
+		Pose pose = {m_state(0, 0), m_state(1, 0), m_state(2, 0)};
+		return pose;
+	}
+
+	void PoseFilter::predict(float forward, float right, float turn, float dt)
+	{
+		float average = m_state(2, 0) + turn * 0.5f;
+		float c = cosf(average);
+		float s = sinf(average);
+		float dx = forward * c + right * s;
+		float dy = forward * s - right * c;
+
+		m_state(0, 0) += dx;
+		m_state(1, 0) += dy;
+		m_state(2, 0) += turn;
+
+		Covariance jacobian = Covariance::identity();
+		jacobian(0, 2) = -dy;
+		jacobian(1, 2) = dx;
+
+		float slip = m_config.slipVariance * (fabsf(forward) + fabsf(right));
+		Covariance noise = Covariance::zero();
+		noise(0, 0) = slip;
+		noise(1, 1) = slip;
+		noise(2, 2) = m_config.turnVariance * fabsf(turn) + m_config.driftVariance * dt;
+
+		m_covariance = jacobian * m_covariance * jacobian.transpose() + noise;
+	}
+
+	bool PoseFilter::correctRange(const RangeMount &mount, float range)
+	{
+		float theta = m_state(2, 0);
+		float c = cosf(theta);
+		float s = sinf(theta);
+		float sx = m_state(0, 0) + mount.forward * c - mount.left * s;
+		float sy = m_state(1, 0) + mount.forward * s + mount.left * c;
+		float phi = theta + mount.angle;
+		float cp = cosf(phi);
+		float sp = sinf(phi);
+		float size = m_config.fieldSize;
+
+		// length of the beam to the walls it points toward on each axis
+		float tx = cp > 1e-3f ? (size - sx) / cp : (cp < -1e-3f ? -sx / cp : INFINITY);
+		float ty = sp > 1e-3f ? (size - sy) / sp : (sp < -1e-3f ? -sy / sp : INFINITY);
+		bool xWall = tx < ty;
+		float predicted = xWall ? tx : ty;
+		float along = xWall ? sy + predicted * sp : sx + predicted * cp;
+		float incidence = fabsf(xWall ? cp : sp);
+
+		if (range > m_config.maxRange || predicted > m_config.maxRange || incidence < m_config.minIncidence ||
+			along < kCornerMargin || along > size - kCornerMargin)
+		{
+			m_rejected.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		Matrix<1, 3> h;
+		if (xWall)
+		{
+			h(0, 0) = -1.0f / cp;
+			h(0, 1) = 0.0f;
+			h(0, 2) = (mount.forward * s + mount.left * c) / cp + predicted * sp / cp;
+		}
+		else
+		{
+			h(0, 0) = 0.0f;
+			h(0, 1) = -1.0f / sp;
+			h(0, 2) = -(mount.forward * c - mount.left * s) / sp - predicted * cp / sp;
+		}
+
+		float sigma = m_config.rangeNoise + m_config.rangeNoiseFraction * range;
+		Matrix<3, 1> ph = m_covariance * h.transpose();
+		float innovationVariance = (h * ph)(0, 0) + sigma * sigma;
+		float innovation = range - predicted;
+		if (innovation * innovation > m_config.gate * m_config.gate * innovationVariance)
+		{
+			m_rejected.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		Matrix<3, 1> gain = ph * (1.0f / innovationVariance);
+		m_state += gain * innovation;
+		m_covariance -= gain * ph.transpose();
+
+		// keep the covariance exactly symmetric despite rounding
+		for (size_t i = 0; i < 3; i++)
+		{
+			for (size_t j = i + 1; j < 3; j++)
+			{
+				float mean = 0.5f * (m_covariance(i, j) + m_covariance(j, i));
+				m_covariance(i, j) = mean;
+				m_covariance(j, i) = mean;
+			}
+		}
+
+		m_accepted.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+} // namespace art
@@ -0,0 +1,129 @@
+/**
+ * @file heapGuard.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the heap guard and, when ART_HEAP_GUARD is defined,
+ * the counting replacements for the global operator new
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The replacements only record the allocation; printing from inside operator
+ * new could itself allocate, so reporting is left to report().
+ */
+
+#include "heapGuard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <new>
+
+namespace art
+{
+	namespace heap
+	{
+		namespace
+		{
+			volatile bool s_sealed = false;
+			volatile uint32_t s_lateCount = 0;
+			volatile size_t s_lateBytes = 0;
+			volatile size_t s_lastLateSize = 0;
+		} // namespace
+
+		void seal()
+		{
+			s_sealed = true;
+		}
+
+		bool sealed()
+		{
+			return s_sealed;
+		}
+
+		uint32_t lateAllocations()
+		{
+			return s_lateCount;
+		}
+
+		size_t lateBytes()
+		{
+			return s_lateBytes;
+		}
+
+		void report()
+		{
+#ifdef ART_HEAP_GUARD
+			static uint32_t s_reported = 0;
+			uint32_t count = s_lateCount;
+			if (count == s_reported)
+			{
+				return;
+			}
+			s_reported = count;
+			printf("heap guard: %lu allocation(s) after pre_auton, %lu bytes, last %lu bytes\n",
+				   (unsigned long)count, (unsigned long)s_lateBytes, (unsigned long)s_lastLateSize);
+#endif
+		}
+
+#ifdef ART_HEAP_GUARD
+		namespace
+		{
+			void *guardedAllocate(size_t size)
+			{
+				if (s_sealed)
+				{
+					s_lateCount = s_lateCount + 1;
+					s_lateBytes = s_lateBytes + size;
+					s_lastLateSize = size;
+				}
+				return malloc(size ? size : 1);
+			}
+		} // namespace
+#endif
+	} // namespace heap
+} // namespace art
+
+#ifdef ART_HEAP_GUARD
+
+void *operator new(size_t size)
+{
+	return art::heap::guardedAllocate(size);
+}
+
+void *operator new[](size_t size)
+{
+	return art::heap::guardedAllocate(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+	return art::heap::guardedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+	return art::heap::guardedAllocate(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept
+{
+	free(memory);
+}
+
+#endif
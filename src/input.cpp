@@ -0,0 +1,145 @@
+/**
+ * @file input.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Input subsystem and InputCurve
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "input.h"
+
+#include <math.h>
+
+#include "scheduler.h"
+
+namespace art
+{
+	InputCurve::InputCurve(int deadband, float exponent)
+	{
+		deadband = deadband < 0 ? 0 : (deadband > 99 ? 99 : deadband);
+		exponent = exponent < 1.0f ? 1.0f : exponent;
+		for (int i = 0; i <= 100; i++)
+		{
+			if (i <= deadband)
+			{
+				m_table[i] = 0.0f;
+				continue;
+			}
+			float travel = (float)(i - deadband) / (float)(100 - deadband);
+			m_table[i] = 100.0f * powf(travel, exponent);
+		}
+	}
+
+	Input::Input(vex::controller &controller)
+		: m_controller(controller), m_sampleUs(0), m_buttons(0), m_heldSent(0), m_tapUsed(0), m_handlerCount(0),
+		  m_overflows(0)
+	{
+		vex::controller::button *sources[kButtonCount] = {
+			&controller.ButtonL1, &controller.ButtonL2, &controller.ButtonR1, &controller.ButtonR2,
+			&controller.ButtonUp, &controller.ButtonDown, &controller.ButtonLeft, &controller.ButtonRight,
+			&controller.ButtonX, &controller.ButtonB, &controller.ButtonY, &controller.ButtonA,
+		};
+		for (int i = 0; i < kButtonCount; i++)
+		{
+			m_sources[i] = sources[i];
+			m_pressedMs[i] = 0;
+		}
+		for (int i = 0; i < kAxisCount; i++)
+		{
+			m_curves[i] = NULL;
+			m_axes[i] = 0;
+		}
+	}
+
+	bool Input::on(Button button, InputEvent event, InputHandler handler, void *context)
+	{
+		if (m_handlerCount >= kMaxHandlers || !handler)
+		{
+			return false;
+		}
+		Handler &entry = m_handlers[m_handlerCount++];
+		entry.button = (uint8_t)button;
+		entry.event = (uint8_t)event;
+		entry.fn = handler;
+		entry.context = context;
+		return true;
+	}
+
+	void Input::queue(int button, InputEvent event)
+	{
+		QueuedEvent queued = {(uint8_t)button, (uint8_t)event};
+		if (!m_queue.push(queued))
+		{
+			m_overflows++;
+		}
+	}
+
+	void Input::update()
+	{
+		m_sampleUs = timeUs();
+		uint32_t now = (uint32_t)(m_sampleUs / 1000);
+
+		m_axes[kAxis1] = (int8_t)m_controller.Axis1.position(vex::percentUnits::pct);
+		m_axes[kAxis2] = (int8_t)m_controller.Axis2.position(vex::percentUnits::pct);
+		m_axes[kAxis3] = (int8_t)m_controller.Axis3.position(vex::percentUnits::pct);
+		m_axes[kAxis4] = (int8_t)m_controller.Axis4.position(vex::percentUnits::pct);
+
+		uint16_t buttons = 0;
+		for (int i = 0; i < kButtonCount; i++)
+		{
+			if (m_sources[i]->pressing())
+			{
+				buttons |= (uint16_t)(1u << i);
+			}
+		}
+
+		uint16_t pressed = buttons & ~m_buttons;
+		uint16_t released = m_buttons & ~buttons;
+		m_buttons = buttons;
+
+		for (int i = 0; i < kButtonCount; i++)
+		{
+			uint16_t bit = (uint16_t)(1u << i);
+			if (pressed & bit)
+			{
+				queue(i, kPressed);
+				// a third quick press starts a new pair rather than another double tap
+				if (!(m_tapUsed & bit) && now - m_pressedMs[i] <= kDoubleTapMs)
+				{
+					queue(i, kDoubleTap);
+					m_tapUsed |= bit;
+				}
+				else
+				{
+					m_tapUsed &= (uint16_t)~bit;
+				}
+				m_pressedMs[i] = now;
+				m_heldSent &= (uint16_t)~bit;
+			}
+			else if (released & bit)
+			{
+				queue(i, kReleased);
+			}
+			else if ((buttons & bit) && !(m_heldSent & bit) && now - m_pressedMs[i] >= kHoldMs)
+			{
+				queue(i, kHeld);
+				m_heldSent |= bit;
+			}
+		}
+
+		QueuedEvent event;
+		while (m_queue.pop(event))
+		{
+			for (size_t h = 0; h < m_handlerCount; h++)
+			{
+				const Handler &handler = m_handlers[h];
+				if (handler.button == event.button && handler.event == event.event)
+				{
+					handler.fn((Button)event.button, (InputEvent)event.event, handler.context);
+				}
+			}
+		}
+	}
+} // namespace art
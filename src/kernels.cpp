@@ -0,0 +1,236 @@
+/**
+ * @file kernels.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the vectorized math kernels and their scalar
+ * references
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The NEON loops handle four channels per iteration and hand whatever is left
+ * over to the scalar version. NEON has no float divide, so the Kalman gain
+ * uses the reciprocal estimate refined by two Newton-Raphson steps, which is
+ * good to about one part in 10^7 and well inside float precision.
+ */
+
+#include "kernels.h"
+
+#include <math.h>
+
+#ifdef ART_NEON
+#include <arm_neon.h>
+#endif
+
+namespace art
+{
+	namespace kernels
+	{
+		namespace
+		{
+			const float kRootHalf = 0.70710678f;
+
+			/**
+			 * @brief Coefficients of outX = a*x + b*y + e, outY = c*x + d*y + f
+			 */
+			struct Affine
+			{
+				float a, b, c, d, e, f;
+			};
+
+			Affine fieldFrom(const Pose &frame)
+			{
+				float c = cosf(frame.theta);
+				float s = sinf(frame.theta);
+				Affine m = {c, -s, s, c, frame.x, frame.y};
+				return m;
+			}
+
+			Affine frameFrom(const Pose &frame)
+			{
+				float c = cosf(frame.theta);
+				float s = sinf(frame.theta);
+				Affine m = {c, s, -s, c, -(frame.x * c + frame.y * s), frame.x * s - frame.y * c};
+				return m;
+			}
+
+			void applyScalar(const Affine &m, const float *x, const float *y, float *outX, float *outY, size_t count)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					float px = x[i];
+					float py = y[i];
+					outX[i] = m.a * px + m.b * py + m.e;
+					outY[i] = m.c * px + m.d * py + m.f;
+				}
+			}
+
+#ifdef ART_NEON
+			void applyNeon(const Affine &m, const float *x, const float *y, float *outX, float *outY, size_t count)
+			{
+				float32x4_t a = vdupq_n_f32(m.a);
+				float32x4_t b = vdupq_n_f32(m.b);
+				float32x4_t c = vdupq_n_f32(m.c);
+				float32x4_t d = vdupq_n_f32(m.d);
+				float32x4_t e = vdupq_n_f32(m.e);
+				float32x4_t f = vdupq_n_f32(m.f);
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					float32x4_t px = vld1q_f32(x + i);
+					float32x4_t py = vld1q_f32(y + i);
+					float32x4_t qx = vmlaq_f32(vmlaq_f32(e, a, px), b, py);
+					float32x4_t qy = vmlaq_f32(vmlaq_f32(f, c, px), d, py);
+					vst1q_f32(outX + i, qx);
+					vst1q_f32(outY + i, qy);
+				}
+				applyScalar(m, x + i, y + i, outX + i, outY + i, count - i);
+			}
+#endif
+		} // namespace
+
+		WheelLayout mecanumLayout(float trackWidth, float wheelBase)
+		{
+			float k = (trackWidth + wheelBase) * 0.5f;
+			WheelLayout layout = {
+				{1.0f, 1.0f, 1.0f, 1.0f},
+				{-1.0f, 1.0f, 1.0f, -1.0f},
+				{-k, k, -k, k},
+			};
+			return layout;
+		}
+
+		WheelLayout xDriveLayout(float radius)
+		{
+			WheelLayout layout = {
+				{kRootHalf, kRootHalf, kRootHalf, kRootHalf},
+				{-kRootHalf, kRootHalf, kRootHalf, -kRootHalf},
+				{-radius, radius, -radius, radius},
+			};
+			return layout;
+		}
+
+		namespace scalar
+		{
+			void wheelSpeeds(const WheelLayout &layout, float vx, float vy, float omega, float speeds[4])
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					speeds[i] = layout.forward[i] * vx + layout.strafe[i] * vy + layout.turn[i] * omega;
+				}
+			}
+
+			void lowPass(float *state, const float *input, float alpha, size_t count)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					state[i] += alpha * (input[i] - state[i]);
+				}
+			}
+
+			void kalman(float *estimate, float *variance, const float *measurement, float processNoise,
+						float measurementNoise, size_t count)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					float p = variance[i] + processNoise;
+					float gain = p / (p + measurementNoise);
+					estimate[i] += gain * (measurement[i] - estimate[i]);
+					variance[i] = p * (1.0f - gain);
+				}
+			}
+
+			void toField(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count)
+			{
+				applyScalar(fieldFrom(frame), x, y, outX, outY, count);
+			}
+
+			void toFrame(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count)
+			{
+				applyScalar(frameFrom(frame), x, y, outX, outY, count);
+			}
+		} // namespace scalar
+
+#ifdef ART_NEON
+		void wheelSpeeds(const WheelLayout &layout, float vx, float vy, float omega, float speeds[4])
+		{
+			float32x4_t result = vmulq_n_f32(vld1q_f32(layout.forward), vx);
+			result = vmlaq_n_f32(result, vld1q_f32(layout.strafe), vy);
+			result = vmlaq_n_f32(result, vld1q_f32(layout.turn), omega);
+			vst1q_f32(speeds, result);
+		}
+
+		void lowPass(float *state, const float *input, float alpha, size_t count)
+		{
+			float32x4_t weight = vdupq_n_f32(alpha);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4_t s = vld1q_f32(state + i);
+				float32x4_t x = vld1q_f32(input + i);
+				vst1q_f32(state + i, vmlaq_f32(s, weight, vsubq_f32(x, s)));
+			}
+			scalar::lowPass(state + i, input + i, alpha, count - i);
+		}
+
+		void kalman(float *estimate, float *variance, const float *measurement, float processNoise,
+					float measurementNoise, size_t count)
+		{
+			float32x4_t q = vdupq_n_f32(processNoise);
+			float32x4_t r = vdupq_n_f32(measurementNoise);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4_t p = vaddq_f32(vld1q_f32(variance + i), q);
+				float32x4_t sum = vaddq_f32(p, r);
+				float32x4_t inverse = vrecpeq_f32(sum);
+				inverse = vmulq_f32(vrecpsq_f32(sum, inverse), inverse);
+				inverse = vmulq_f32(vrecpsq_f32(sum, inverse), inverse);
+				float32x4_t gain = vmulq_f32(p, inverse);
+
+				float32x4_t x = vld1q_f32(estimate + i);
+				x = vmlaq_f32(x, gain, vsubq_f32(vld1q_f32(measurement + i), x));
+				vst1q_f32(estimate + i, x);
+				vst1q_f32(variance + i, vmlsq_f32(p, gain, p));
+			}
+			scalar::kalman(estimate + i, variance + i, measurement + i, processNoise, measurementNoise, count - i);
+		}
+
+		void toField(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count)
+		{
+			applyNeon(fieldFrom(frame), x, y, outX, outY, count);
+		}
+
+		void toFrame(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count)
+		{
+			applyNeon(frameFrom(frame), x, y, outX, outY, count);
+		}
+#else
+		void wheelSpeeds(const WheelLayout &layout, float vx, float vy, float omega, float speeds[4])
+		{
+			scalar::wheelSpeeds(layout, vx, vy, omega, speeds);
+		}
+
+		void lowPass(float *state, const float *input, float alpha, size_t count)
+		{
+			scalar::lowPass(state, input, alpha, count);
+		}
+
+		void kalman(float *estimate, float *variance, const float *measurement, float processNoise,
+					float measurementNoise, size_t count)
+		{
+			scalar::kalman(estimate, variance, measurement, processNoise, measurementNoise, count);
+		}
+
+		void toField(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count)
+		{
+			scalar::toField(frame, x, y, outX, outY, count);
+		}
+
+		void toFrame(const Pose &frame, const float *x, const float *y, float *outX, float *outY, size_t count)
+		{
+			scalar::toFrame(frame, x, y, outX, outY, count);
+		}
+#endif
+	} // namespace kernels
+} // namespace art
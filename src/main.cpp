@@ -13,8 +13,32 @@
  * during pre_auton.
  */
 
+#include <atomic>
+
 #include "vex.h"
 
+#include "assist.h"
+#include "command.h"
+#include "display.h"
+#include "fieldMap.h"
+#include "follower.h"
+#include "heapGuard.h"
+#include "paramMenu.h"
+#include "params.h"
+#include "profiler.h"
+#include "replan.h"
+#include "robotConfig.h"
+#include "routes.h"
+#include "routine.h"
+#include "scheduler.h"
+#include "startup.h"
+#include "telemetry.h"
+#include "topics.h"
+#include "trajectory.h"
+#include "tuneLink.h"
+#include "wait.h"
+#include "watchdog.h"
+
 /**
  * @brief A global instance of competition
  *
@@ -23,6 +47,967 @@
  */
 vex::competition Competition;
 
+/**
+ * @brief The Scheduler running the usercontrol jobs
+ *
+ * Jobs are registered in pre_auton and run at fixed rates from usercontrol.
+ * Its statistics (overruns, worst-case loop time) can be inspected at any time
+ * to see whether the driver loop is holding its period.
+ */
+art::Scheduler DriverLoop;
+
+/**
+ * @brief The Scheduler running the autonomous jobs
+ */
+art::Scheduler AutonLoop;
+
+/**
+ * @brief Where the robot is placed at the start of autonomous
+ */
+const art::Pose AutonStart = {24.0f, 24.0f, 0.0f};
+
+/**
+ * @brief Waypoints of the autonomous route, starting at AutonStart
+ */
+const art::Waypoint AutonWaypoints[] = {
+	{24.0f, 24.0f, 0.0f},
+	{72.0f, 48.0f, 1.5708f},
+	{48.0f, 96.0f, 3.1416f},
+};
+
+/**
+ * @brief The autonomous route, generated from AutonWaypoints in pre_auton
+ */
+art::Trajectory AutonPath;
+
+/**
+ * @brief AutonPath resampled every inch, for the pure pursuit follower
+ */
+art::Path AutonRoute;
+
+/**
+ * @brief Tuning of the autonomous path follower
+ */
+const art::PursuitConfig AutonPursuit = {
+	12.0f, // lookahead
+	12.0f, // trackWidth, matches DriveConfig
+	6.0f,  // minVelocity
+	1.0f,  // endTolerance
+	0,     // window, sized from the lookahead
+};
+
+/**
+ * @brief Follows AutonRoute from the odometry pose
+ */
+art::PurePursuit AutonFollower(AutonPursuit);
+
+/**
+ * @brief The field during autonomous: FieldLayout, plus whatever the distance
+ * sensors have found on it since the period started
+ */
+art::FieldMap AutonMap(FieldLayout::kGrid, ObstacleSettings);
+
+/**
+ * @brief Tuning of the detours around obstacles in AutonMap
+ *
+ * 36 inches ahead is over twice the 15 inches the robot needs to stop from
+ * full speed. loadRoutes() sizes each scratch Arena for a copy of the longest
+ * route, and scratchBytes on top holds the detour: its trajectory, sampled
+ * every 10 ms, its points, and their copies in the spliced path. That came
+ * to at most 4 KB in the simulator's obstacle cases.
+ */
+const art::ReplanConfig AutonReplan = {
+	36.0f,     // checkDistance
+	12.0f,     // lead
+	6.0f,      // offsetStep
+	36.0f,     // maxOffset
+	24.0f,     // minVelocity
+	8 * 1024,  // scratchBytes
+};
+
+/**
+ * @brief How long FollowPath holds still at a block it cannot get round, in
+ * case a later reading opens a way, before it gives up on the path
+ */
+const uint32_t kBlockedHoldMs = 2000;
+
+/**
+ * @brief Steers AutonFollower round obstacles in AutonMap
+ */
+art::Replanner RouteReplanner(AutonMap, AutonReplan);
+
+/**
+ * @brief Samples every device into the shared DeviceSnapshot, then publishes
+ * a summary of it to StatusTopic
+ *
+ * Registered before driveTick at the same rate, so each drive tick works from
+ * a fresh sample taken just before it. The sensors are recorded to MatchLog
+ * every tick, so a recorded match holds everything the control code read.
+ */
+void sampleTick(void *)
+{
+	sampleDevices();
+
+	DeviceSnapshot devices = Devices.read();
+	art::MatchLog.logSensors(art::SensorRecord::encode(devices.forwardTracker, devices.sidewaysTracker,
+													   devices.imuRotation, devices.distance, kDistanceCount,
+													   devices.batteryVoltage, devices.batteryCurrent));
+
+	RobotStatus status;
+	status.batteryVoltage = devices.batteryVoltage;
+	status.batteryCurrent = devices.batteryCurrent;
+	status.hottestDrive = 0.0f;
+	for (int i = 0; i < kMotorCount; i++)
+	{
+		if (Motors.inGroup(i, kDrive) && devices.motorTemperature[i] > status.hottestDrive)
+		{
+			status.hottestDrive = devices.motorTemperature[i];
+		}
+	}
+	status.driveBudget = Limiter.budgetScale();
+	art::Scheduler &loop = Competition.isAutonomous() ? AutonLoop : DriverLoop;
+	status.overruns = loop.overruns();
+	status.worstLoopUs = loop.worstLoopUs();
+	StatusTopic.publish(status);
+}
+
+/**
+ * @brief Places this tick's distance readings on AutonMap
+ *
+ * Registered in AutonLoop after sampleTick and before the commands, so a
+ * follower checking its path sees obstacles from the same tick's sample.
+ */
+void scanTick(void *)
+{
+	PROFILE_SCOPE("scan");
+
+	DeviceSnapshot devices = Devices.read();
+	const art::Pose &pose = PoseTopic.subscriber<kControlPose>().latest().pose;
+	for (int i = 0; i < kDistanceCount; i++)
+	{
+		AutonMap.observe(i, pose, RobotLayout::kDistanceMounts[i], devices.distance[i]);
+	}
+}
+
+/**
+ * @brief Records the pose and motors to MatchLog
+ *
+ * Runs every 20 milliseconds in both autonomous and usercontrol. Each call
+ * only copies a few dozen bytes into RAM; the SD card is written from
+ * MatchLog's own task.
+ */
+void logTick(void *)
+{
+	PROFILE_SCOPE("log");
+
+	DeviceSnapshot devices = Devices.read();
+	art::MotorRecord motors[kMotorCount];
+	for (int i = 0; i < kMotorCount; i++)
+	{
+		motors[i] = art::MotorRecord::encode((uint8_t)i, devices.motorPosition[i], devices.motorVelocity[i],
+											 devices.motorCurrent[i], devices.motorVoltage[i],
+											 devices.motorTemperature[i]);
+	}
+
+	art::MatchLog.logPose(PoseTopic.subscriber<kLogPose>().latest());
+	art::MatchLog.logMotors(motors, kMotorCount);
+}
+
+/**
+ * @brief Response of the drive sticks: a small deadband, then a cubic curve
+ * for finer control at low speed
+ */
+const art::InputCurve DriveCurve(5, 3.0f);
+
+/**
+ * @brief Whether the intake is running, toggled by R1
+ */
+bool IntakeOn = false;
+
+/**
+ * @brief Toggles the intake on each press of R1
+ */
+void toggleIntake(art::Button, art::InputEvent, void *)
+{
+	IntakeOn = !IntakeOn;
+	setVoltage(kIntake, IntakeOn ? 12.0f : 0.0f);
+}
+
+/**
+ * @brief Runs the intake backwards while R2 is held down
+ */
+void reverseIntake(art::Button, art::InputEvent event, void *)
+{
+	bool down = event == art::kPressed;
+	float volts = down ? -12.0f : (IntakeOn ? 12.0f : 0.0f);
+	setVoltage(kIntake, volts);
+}
+
+/**
+ * @brief Samples Controller1 and dispatches its button events
+ *
+ * Registered ahead of driveTick, so the drive reads this tick's sticks. Every
+ * sample is recorded to MatchLog, as logged sticks that skip a tick could not
+ * be replayed exactly.
+ */
+void inputTick(void *)
+{
+	PROFILE_SCOPE("input");
+
+	DriverInput.update();
+	art::ControllerRecord pad = {
+		{(int8_t)DriverInput.raw(art::kAxis1), (int8_t)DriverInput.raw(art::kAxis2),
+		 (int8_t)DriverInput.raw(art::kAxis3), (int8_t)DriverInput.raw(art::kAxis4)},
+		DriverInput.buttons(),
+	};
+	art::MatchLog.logController(pad);
+}
+
+/**
+ * @brief Heading hold and auto-aim for the driver, see AssistSettings
+ */
+art::DriveAssist DriverAssist(AssistSettings);
+
+/**
+ * @brief Updates the drivetrain from the sticks
+ *
+ * Runs every 10 milliseconds while usercontrol is active. The sticks were
+ * sampled by inputTick just before; buttons are handled by the handlers
+ * registered in pre_auton rather than polled here.
+ *
+ * The sticks go through DriverAssist, which holds the heading while the turn
+ * stick is centred and aims at the goal while L1 is held.
+ */
+void driveTick(void *)
+{
+	PROFILE_SCOPE("drive");
+
+	art::ArcadeCommand sticks = {
+		DriverInput.axis(art::kAxis3) * 0.12f,
+		DriverInput.axis(art::kAxis1) * 0.12f,
+	};
+	art::ArcadeCommand command = DriverAssist.update(sticks, PoseTopic.subscriber<kDrivePose>().latest(),
+													 DriverInput.sampleUs(), DriverInput.pressing(art::kButtonL1));
+	driveVoltage(command.forward + command.turn, command.forward - command.turn);
+}
+
+/**
+ * @brief The gains Params edits, starting from the compiled-in ones
+ *
+ * Only Params.apply() writes them, at the start of a control tick; the apply
+ * functions below then hand them to whatever uses them.
+ */
+art::PidGains WheelSpeedTuning = WheelSpeedGains;
+art::AssistConfig AssistTuning = AssistSettings; /**< see WheelSpeedTuning */
+
+/**
+ * @brief Posts new speed loop gains to DriveVelocity's task
+ */
+void applyWheelSpeed(void *)
+{
+	DriveVelocity.setGains(WheelSpeedTuning);
+}
+
+/**
+ * @brief Hands DriverAssist its new gains; it runs on the same task as apply()
+ */
+void applyAssist(void *)
+{
+	DriverAssist.setConfig(AssistTuning);
+}
+
+/**
+ * @brief File on the SD card tuned values are kept in, see @ref param_format
+ */
+const char *const kParamFile = "params.bin";
+
+art::TuneLink TuneSerial(art::Params);                  /**< tuning over the USB serial port */
+art::ParamMenu TuneMenu(art::Params, Controller1.Screen); /**< tuning from the controller, X to open */
+
+/**
+ * @brief Registers the values the tuning channels may change
+ *
+ * Ranges are wide enough for any sensible tune, and narrow enough that a
+ * slip on the controller cannot make the robot dangerous.
+ */
+void registerParams()
+{
+	int speed = art::Params.addGroup("speed", applyWheelSpeed);
+	art::Params.add(speed, "kP", &WheelSpeedTuning.kP, 0.0f, 2.0f, 0.01f);
+	art::Params.add(speed, "kI", &WheelSpeedTuning.kI, 0.0f, 10.0f, 0.1f);
+	art::Params.add(speed, "kD", &WheelSpeedTuning.kD, 0.0f, 0.5f, 0.005f);
+	art::Params.add(speed, "kS", &WheelSpeedTuning.kS, 0.0f, 3.0f, 0.05f);
+	art::Params.add(speed, "kV", &WheelSpeedTuning.kV, 0.0f, 1.0f, 0.005f);
+	art::Params.add(speed, "kA", &WheelSpeedTuning.kA, 0.0f, 0.5f, 0.005f);
+
+	int assist = art::Params.addGroup("assist", applyAssist);
+	art::Params.add(assist, "latency", &AssistTuning.responseLatency, 0.0f, 0.2f, 0.005f);
+	art::Params.add(assist, "holdKp", &AssistTuning.holdKp, 0.0f, 40.0f, 0.5f);
+	art::Params.add(assist, "holdKd", &AssistTuning.holdKd, 0.0f, 5.0f, 0.05f);
+	art::Params.add(assist, "aimKp", &AssistTuning.aimKp, 0.0f, 40.0f, 0.5f);
+	art::Params.add(assist, "aimKd", &AssistTuning.aimKd, 0.0f, 5.0f, 0.05f);
+}
+
+/**
+ * @brief Answers the tuning link, then applies every edit made since the
+ * last tick
+ *
+ * Registered first in both loops, so the jobs after it in the same tick all
+ * see the same values.
+ */
+void tuneTick(void *)
+{
+	TuneSerial.poll();
+	art::Params.apply();
+}
+
+/**
+ * @brief Drives along a Path with a PurePursuit follower
+ *
+ * Each update steers from the odometry pose, searching only a few points ahead
+ * of where the follower was last tick, and hands its wheel speeds to
+ * DriveVelocity, which holds them closed-loop. With a Replanner, the path
+ * ahead is checked first and the follower sent round anything found on it;
+ * each detour, each block it cannot get round, and each detour that did not
+ * fit in the replanner's memory is noted in MatchLog. At a block of either
+ * kind the robot stops instead of pushing on into it, and the path is given
+ * up if no way round turns up within kBlockedHoldMs. The command then
+ * finishes failed(), so that nothing meant for the end of the path is done
+ * at the block.
+ */
+class FollowPath : public art::Command
+{
+public:
+	FollowPath(art::PurePursuit &follower, const art::Path &path, art::Replanner *replanner = NULL)
+		: m_follower(follower), m_path(path), m_replanner(replanner), m_result(art::kPathClear), m_blockedUs(0),
+		  m_gaveUp(false)
+	{
+	}
+
+	void start()
+	{
+		m_follower.begin(m_path);
+		m_result = art::kPathClear;
+		m_gaveUp = false;
+	}
+
+	bool update()
+	{
+		PROFILE_SCOPE("follow");
+
+		if (m_replanner && stopped(replan()))
+		{
+			return hold();
+		}
+		art::DriveCommand command = m_follower.update(PoseTopic.subscriber<kControlPose>().latest().pose);
+		if (m_follower.finished())
+		{
+			return true;
+		}
+		DriveVelocity.setTarget(command.left, command.right);
+		return false;
+	}
+
+	void end(bool)
+	{
+		DriveVelocity.stop();
+	}
+
+	/** @brief True if the last run stopped at a block short of the end of the path */
+	bool gaveUp() const { return m_gaveUp; }
+
+	bool failed() const { return m_gaveUp; }
+
+private:
+	art::ReplanResult replan()
+	{
+		PROFILE_SCOPE("replan");
+
+		art::ReplanResult result = m_replanner->update(m_follower);
+		if (result != m_result && result != art::kPathClear)
+		{
+			logAtIndex(result == art::kPathReplanned ? "detour"
+					   : result == art::kPathNoMemory ? "no memory for detour"
+													  : "blocked");
+		}
+		if (stopped(result) && !stopped(m_result))
+		{
+			m_blockedUs = art::timeUs();
+		}
+		m_result = result;
+		return result;
+	}
+
+	/** @brief True if the robot must stand still for result: in the way, and not driven round */
+	static bool stopped(art::ReplanResult result)
+	{
+		return result == art::kPathBlocked || result == art::kPathNoMemory;
+	}
+
+	/** @brief Stands still at a block; true once it is time to give up on the path */
+	bool hold()
+	{
+		DriveVelocity.stop();
+		if (art::timeUs() - m_blockedUs < (uint64_t)kBlockedHoldMs * 1000)
+		{
+			return false;
+		}
+		logAtIndex("gave up");
+		m_gaveUp = true;
+		return true;
+	}
+
+	/** @brief Notes in MatchLog what happened, at how far along the path */
+	void logAtIndex(const char *what)
+	{
+		char text[32];
+		snprintf(text, sizeof(text), "%s at %.0f in", what, m_follower.path()[m_follower.index()].distance);
+		art::MatchLog.logText(text);
+	}
+
+	art::PurePursuit &m_follower;
+	const art::Path &m_path;
+	art::Replanner *m_replanner;
+	art::ReplanResult m_result;
+	uint64_t m_blockedUs; /**< when the current block was first found */
+	bool m_gaveUp;        /**< the path was given up at a block */
+};
+
+/**
+ * @brief Runs the intake at a fixed voltage until interrupted
+ */
+class SpinIntake : public art::Command
+{
+public:
+	explicit SpinIntake(float volts) : m_volts(volts) {}
+
+	void start()
+	{
+		setVoltage(kIntake, m_volts);
+	}
+
+	bool update()
+	{
+		return false;
+	}
+
+	void end(bool)
+	{
+		setVoltage(kIntake, 0.0f);
+	}
+
+private:
+	float m_volts;
+};
+
+FollowPath DriveRoute(AutonFollower, AutonRoute, &RouteReplanner); /**< drive AutonRoute to the goal */
+SpinIntake IntakeIn(12.0f);                       /**< collect while driving */
+SpinIntake IntakeOut(-12.0f);                     /**< score at the goal */
+art::WaitCommand ScoreTime(750);                  /**< how long scoring takes */
+
+art::Command *const CollectSteps[] = {&DriveRoute, &IntakeIn};
+art::Command *const ScoreSteps[] = {&ScoreTime, &IntakeOut};
+
+art::Deadline Collect(CollectSteps); /**< intake for as long as the drive takes */
+art::Deadline Score(ScoreSteps);     /**< outtake for ScoreTime */
+
+art::Command *const RouteSteps[] = {&Collect, &Score};
+
+/**
+ * @brief The "Route" autonomous: collect along AutonRoute, then score
+ */
+art::Sequence RouteRoutine(RouteSteps);
+
+/**
+ * @brief File on the SD card the extra routines are loaded from, see
+ * @ref route_format
+ */
+const char *const kRouteFile = "routes.bin";
+
+/**
+ * @brief Routes loaded from kRouteFile in pre_auton
+ */
+art::RouteBook AutonRoutes;
+
+/**
+ * @brief Applies one action of a loaded route
+ */
+void applyRouteAction(const art::RouteAction &action)
+{
+	switch (action.type)
+	{
+	case art::kRouteIntake:
+		setVoltage(kIntake, action.value * 0.001f);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Drives a route from AutonRoutes and carries out its actions
+ *
+ * Actions along the path are applied as the follower passes their distance.
+ * Once the robot stops at the end, the remaining actions run one after
+ * another, each for its own duration. If the drive gives up at a block
+ * instead, the routine fails there and the end actions are not run. The
+ * intake is stopped when the route ends or is interrupted.
+ */
+class RunRoute : public art::Routine
+{
+public:
+	RunRoute(art::PurePursuit &follower, art::Replanner &replanner)
+		: m_follower(follower), m_route(NULL), m_drive(follower, m_path, &replanner), m_next(0)
+	{
+	}
+
+	/** @brief Picks the route to run, before the command is scheduled */
+	void setRoute(const art::Route &route)
+	{
+		m_route = &route;
+		m_path = route.path;
+	}
+
+protected:
+	bool run()
+	{
+		ROUTINE_BEGIN();
+		m_next = 0;
+		ROUTINE_WAIT_UNTIL(drive(), art::kForever);
+		if (m_drive.gaveUp())
+		{
+			ROUTINE_FAIL();
+		}
+		applyAlongPath(m_path.length());
+		while (m_next < m_route->actionCount)
+		{
+			applyRouteAction(m_route->actions[m_next++]);
+			ROUTINE_WAIT_MS(m_route->actions[m_next - 1].durationMs);
+		}
+		ROUTINE_END();
+	}
+
+	void stop(bool)
+	{
+		setVoltage(kIntake, 0.0f);
+	}
+
+private:
+	/** @brief One tick of the drive, applying the actions passed so far first */
+	bool drive()
+	{
+		// the follower is only on this route once m_drive has started
+		applyAlongPath(m_child == &m_drive ? m_follower.path()[m_follower.index()].distance : 0.0f);
+		return await(m_drive);
+	}
+
+	/** @brief Applies the actions up to a distance along the path */
+	void applyAlongPath(float travelled)
+	{
+		while (m_next < m_route->actionCount && m_route->actions[m_next].at != art::kRouteAtEnd &&
+			   m_route->actions[m_next].distance() <= travelled)
+		{
+			applyRouteAction(m_route->actions[m_next++]);
+		}
+	}
+
+	art::PurePursuit &m_follower;
+	const art::Route *m_route;
+	art::Path m_path;
+	FollowPath m_drive;
+	size_t m_next;
+};
+
+/**
+ * @brief The routine for whichever of AutonRoutes was picked
+ */
+RunRoute LoadedRoutine(AutonFollower, RouteReplanner);
+
+/**
+ * @brief Runs the autonomous commands, registered as an AutonLoop job
+ */
+art::CommandRunner AutonCommands;
+
+/**
+ * @brief The routine autonomous() last scheduled, NULL if none was picked
+ */
+art::Command *AutonRoutine = NULL;
+
+/**
+ * @brief Sends this tick's motor requests through Limiter to the motors
+ *
+ * Registered after every job that sets a voltage, at the same 10 ms period.
+ */
+void outputTick(void *)
+{
+	applyOutputs(10);
+}
+
+/**
+ * @brief Names of the routines AutonChoice cycles through: the compiled-in
+ * "Route", then AutonRoutes in file order, then "None"
+ */
+const char *AutonNames[art::RouteBook::kMaxRoutes + 2] = {"Route", "None"};
+
+art::TextField PoseField(0, 0, 300, "Pose");                       /**< odometry estimate */
+art::TextField BatteryField(0, 24, 300, "Batt");                   /**< battery voltage and current */
+art::Gauge DriveTemperature(0, 48, 300, 20, "Temp", 20.0f, 70.0f); /**< hottest drive motor, Celsius */
+art::TextField LoopField(0, 72, 300, "Loop");                      /**< overruns and worst loop time */
+
+/**
+ * @brief Touch to pick the autonomous routine before the match
+ */
+art::AutonSelector AutonChoice(310, 0, 170, 92, AutonNames, 2);
+
+/**
+ * @brief Draws the profiler's table into ProfilerView
+ */
+void drawProfiler(vex::brain::lcd &screen, int x, int y, void *)
+{
+	art::profiler::report(screen, x, y);
+}
+
+art::CustomWidget ProfilerView(0, 100, 480, 172, drawProfiler); /**< profiler table, redrawn once a second */
+
+/**
+ * @brief Watches every periodic task, see watchdog.h
+ *
+ * AutonLoop, DriverLoop, odometry and the wheel speed loop are critical: when
+ * they run late, shedLoad() gives them time back. The screen, the log flush
+ * and the parameter save tasks are watched too, so being starved shows up in
+ * MatchLog, but they can wait.
+ */
+art::Watchdog TaskWatchdog;
+
+/** @brief How often main() polls TaskWatchdog */
+const uint32_t kWatchPeriodMs = 100;
+
+/** @brief How long AutonLoop or DriverLoop can go without a pass before it counts as stalled */
+const uint32_t kLoopTimeoutMs = 200;
+
+/** @brief How many times less often the screen and the log run at each watchdog level */
+const uint32_t kShedFactor[art::Watchdog::kMaxLevel + 1] = {1, 2, 4};
+
+int AutonUiJob = -1;       /**< AutonLoop's ui job, slowed down by shedLoad() */
+int AutonLogJob = -1;      /**< AutonLoop's log job, slowed down by shedLoad() */
+int DriverUiJob = -1;      /**< DriverLoop's ui job, slowed down by shedLoad() */
+int DriverLogJob = -1;     /**< DriverLoop's log job, slowed down by shedLoad() */
+int DriverProfileJob = -1; /**< DriverLoop's profile job, slowed down by shedLoad() */
+
+/**
+ * @brief Updates the status widgets on the Brain screen
+ *
+ * Runs every 50 milliseconds in both autonomous and usercontrol. It only hands
+ * the widgets the latest values from PoseTopic and StatusTopic;
+ * BrainDisplay's own task redraws whichever of them changed, so nothing here
+ * waits on the screen. TuneMenu writes at most one line of the controller
+ * screen.
+ */
+void uiTick(void *)
+{
+	PROFILE_SCOPE("ui");
+
+	art::Pose pose = PoseTopic.subscriber<kUiPose>().latest().pose;
+	PoseField.setf("%4d %4d %4d", (int)pose.x, (int)pose.y, (int)(pose.theta * 57.2958f));
+
+	const RobotStatus &status = StatusTopic.subscriber<kUiStatus>().latest();
+	int decivolts = (int)(status.batteryVoltage * 10.0f);
+	BatteryField.setf("%d.%d V %d A", decivolts / 10, decivolts % 10, (int)status.batteryCurrent);
+	DriveTemperature.set(status.hottestDrive);
+	LoopField.setf("%lu late, %lu us, shed %d", (unsigned long)status.overruns, (unsigned long)status.worstLoopUs,
+				   TaskWatchdog.level());
+
+	TuneMenu.draw();
+	art::heap::report();
+}
+
+/**
+ * @brief Refreshes the profiler's table on the Brain and records it to MatchLog
+ *
+ * Runs once a second while usercontrol is active. Does nothing unless the
+ * program was built with `make PROFILE=1`.
+ */
+void profileTick(void *)
+{
+	ProfilerView.invalidate();
+	art::profiler::dump(art::MatchLog);
+}
+
+/** @brief Records each TaskWatchdog event to MatchLog */
+void reportWatch(const art::WatchEvent &event, void *)
+{
+	art::MatchLog.logWatch(event);
+}
+
+/**
+ * @brief Slows the screen, the pose and motor log and the profiler down as
+ * the watchdog level rises, and back up as it falls
+ *
+ * The sensors and the controller are still logged every tick, since a
+ * replay needs every one of them.
+ */
+void shedLoad(int level, void *)
+{
+	uint32_t factor = kShedFactor[level];
+	AutonLoop.setSlowdown(AutonUiJob, factor);
+	AutonLoop.setSlowdown(AutonLogJob, factor);
+	DriverLoop.setSlowdown(DriverUiJob, factor);
+	DriverLoop.setSlowdown(DriverLogJob, factor);
+	DriverLoop.setSlowdown(DriverProfileJob, factor);
+	art::BrainDisplay.setSlowdown(factor);
+}
+
+/**
+ * @brief Polls TaskWatchdog; main() runs it every kWatchPeriodMs
+ *
+ * AutonLoop and DriverLoop stop when their period ends, so each is paused
+ * unless its period is the one running.
+ */
+void watchTick()
+{
+	bool enabled = Competition.isEnabled();
+	if (!enabled || !Competition.isAutonomous())
+	{
+		AutonLoop.pauseWatch();
+	}
+	if (!enabled || !Competition.isDriverControl())
+	{
+		DriverLoop.pauseWatch();
+	}
+	TaskWatchdog.poll();
+}
+
+/**
+ * @brief Longest the imu stage waits for the inertial sensor to calibrate
+ *
+ * Calibration normally takes about two seconds. A sensor that never finishes
+ * must not hold up the stages after it, so give up after twice that.
+ */
+const uint32_t kImuCalibrationMs = 4000;
+
+/**
+ * @brief Longest autonomous and usercontrol wait for the stages they need
+ *
+ * Enough for the inertial sensor to time out and the odometry to start
+ * anyway; past that the period starts with whatever is ready.
+ */
+const uint32_t kStartupWaitMs = 5000;
+
+/**
+ * @brief The stages of pre_auton, run concurrently as their dependencies
+ * finish
+ */
+art::Startup RobotStartup;
+
+art::StageSet RouteStage;    /**< built-in route generated and SD routes loaded */
+art::StageSet ParamStage;    /**< tuned values read from kParamFile */
+art::StageSet ImuStage;      /**< inertial sensor calibrated */
+art::StageSet ScreenStage;   /**< Brain screen running, routine picker filled in */
+art::StageSet LogStage;      /**< MatchLog recording */
+art::StageSet OdometryStage; /**< odometry tracking and publishing the pose */
+
+/**
+ * @brief Why the SD routes did not load, noted in MatchLog by the log stage
+ */
+art::RouteError RouteLoadError = art::kRouteOk;
+
+/**
+ * @brief Whether RouteReplanner got its scratch memory from RobotArena
+ */
+bool ReplanReady = false;
+
+bool ImuCalibrated()
+{
+	return !Imu.isCalibrating();
+}
+
+/**
+ * @brief Generates the built-in route, then loads the routes on the SD card
+ *
+ * This is the only stage that allocates from RobotArena, so the arena is
+ * only ever used from one task.
+ */
+bool loadRoutes(void *)
+{
+	art::TrajectoryConstraints constraints = {
+		DriveConfig.maxVelocity,
+		DriveConfig.maxAccel,
+		0.0f,
+		DriveConfig.trackWidth,
+		false,
+	};
+	AutonPath = art::Trajectory::generate(AutonWaypoints, sizeof(AutonWaypoints) / sizeof(AutonWaypoints[0]),
+										  constraints, art::RobotArena);
+	AutonRoute = art::Path::fromTrajectory(AutonPath, 1.0f, art::RobotArena);
+
+	RouteLoadError = AutonRoutes.load(kRouteFile, constraints, art::RobotArena);
+	size_t longest = AutonRoute.size();
+	for (size_t i = 0; i < AutonRoutes.size(); i++)
+	{
+		longest = AutonRoutes[i].path.size() > longest ? AutonRoutes[i].path.size() : longest;
+	}
+	ReplanReady = RouteReplanner.reserve(art::RobotArena, constraints, longest);
+	return RouteLoadError == art::kRouteOk;
+}
+
+/**
+ * @brief Notes in MatchLog where a route first comes closer to the fixed
+ * field than FieldLayout::kClearance
+ *
+ * Only a warning: a route may go up to a goal or a wall on purpose.
+ */
+void checkRoute(const char *name, const art::Path &path)
+{
+	for (size_t i = 0; i + 1 < path.size(); i++)
+	{
+		if (AutonMap.sweptBlocked(path[i].x, path[i].y, path[i + 1].x, path[i + 1].y, art::kFixedLayer))
+		{
+			char text[40];
+			snprintf(text, sizeof(text), "%s near field at %.0f in", name, path[i].distance);
+			art::MatchLog.logText(text);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Calibrates the inertial sensor; the robot must stay still meanwhile
+ */
+bool calibrateImu(void *)
+{
+	Imu.calibrate();
+	return (bool)art::waitUntil(ImuCalibrated, kImuCalibrationMs, 10);
+}
+
+/**
+ * @brief Fills in the routine picker and starts the Brain screen
+ */
+bool startScreen(void *)
+{
+	for (size_t i = 0; i < AutonRoutes.size(); i++)
+	{
+		AutonNames[i + 1] = AutonRoutes[i].name;
+	}
+	AutonNames[AutonRoutes.size() + 1] = "None";
+	AutonChoice.setNames(AutonNames, AutonRoutes.size() + 2);
+
+	art::BrainDisplay.add(PoseField);
+	art::BrainDisplay.add(BatteryField);
+	art::BrainDisplay.add(DriveTemperature);
+	art::BrainDisplay.add(LoopField);
+	art::BrainDisplay.add(AutonChoice);
+	art::BrainDisplay.add(ProfilerView);
+	art::BrainDisplay.start();
+	return true;
+}
+
+/**
+ * @brief Reads the tuned values saved by earlier runs, then starts saving new
+ * edits
+ *
+ * The values are staged, so the control loop picks them up at its first
+ * tick.
+ */
+bool loadParams(void *)
+{
+	bool loaded = art::Params.load(kParamFile);
+	art::Params.startSaving(kParamFile);
+	return loaded;
+}
+
+/**
+ * @brief Set once an IMU calibration timeout has been noted in MatchLog
+ */
+std::atomic<bool> ImuTimeoutNoted(false);
+
+/**
+ * @brief Notes in MatchLog that the IMU calibration timed out, once
+ *
+ * The odometry stage does not wait for the log, so both it and startLog call
+ * this: whichever runs once the IMU stage has failed and MatchLog is
+ * recording writes the note.
+ */
+void noteImuTimeout()
+{
+	if (RobotStartup.finished(ImuStage) && !RobotStartup.succeeded(ImuStage) && art::MatchLog.recording() &&
+		!ImuTimeoutNoted.exchange(true))
+	{
+		art::MatchLog.logText("imu calibration timed out");
+	}
+}
+
+/**
+ * @brief Starts MatchLog, after the routes and the tuned values so none of
+ * them use the SD card at once
+ */
+bool startLog(void *)
+{
+	bool recording = art::MatchLog.begin("match");
+	if (RouteLoadError != art::kRouteOk)
+	{
+		art::MatchLog.logText(art::routeErrorText(RouteLoadError));
+	}
+	if (!ReplanReady)
+	{
+		art::MatchLog.logText("no memory for detours");
+	}
+	checkRoute(AutonNames[0], AutonRoute);
+	for (size_t i = 0; i < AutonRoutes.size(); i++)
+	{
+		checkRoute(AutonRoutes[i].name, AutonRoutes[i].path);
+	}
+	char text[32];
+	if (RobotStartup.succeeded(ParamStage))
+	{
+		snprintf(text, sizeof(text), "%lu tuned values loaded", (unsigned long)art::Params.loaded());
+	}
+	else
+	{
+		snprintf(text, sizeof(text), "%s is damaged", kParamFile);
+	}
+	art::MatchLog.logText(text);
+	noteImuTimeout();
+	return recording;
+}
+
+/**
+ * @brief Starts the odometry task, with the distance sensors correcting it
+ * off the walls
+ *
+ * Runs even if calibration timed out, since a drifting heading is better than
+ * none; the timeout is noted in MatchLog, now or once it is recording.
+ */
+bool startOdometry(void *)
+{
+	noteImuTimeout();
+	Odom.setCorrection(correctFromWalls);
+	Odom.setPublisher(publishPose);
+	Odom.start();
+	Odom.watch(TaskWatchdog);
+	return true;
+}
+
+/**
+ * @brief Seals the heap once every other stage has finished, and notes how
+ * long startup took
+ */
+bool finishStartup(void *)
+{
+	uint32_t slowestUs = 0;
+	for (int i = 0; i < RobotStartup.count(); i++)
+	{
+		if (RobotStartup.state(i) >= art::kStageDone && RobotStartup.finishedUs(i) > slowestUs)
+		{
+			slowestUs = RobotStartup.finishedUs(i);
+		}
+	}
+	char text[32];
+	snprintf(text, sizeof(text), "startup took %lu ms", (unsigned long)(slowestUs / 1000));
+	art::MatchLog.logText(text);
+	art::heap::seal();
+	return true;
+}
+
 /**
  * @brief Runs after robot is powered on and before autonomous or usercontrol
  *
@@ -35,9 +1020,98 @@ vex::competition Competition;
  * Here, perform All activities that occur before the competition starts
  * Example: clearing encoders, setting servo positions, ...
  *
+ * Only the cheap setup is done here: scheduler jobs, input handlers, the
+ * tunable values, the task watchdog, and the drive speed loop's task, which
+ * idles until a path follower gives it a target. Everything that waits on
+ * hardware or the SD card is a RobotStartup stage, and this function returns
+ * as soon as they have been started:
+ *
+ * - routes: the built-in route is generated and the SD routes loaded.
+ * - imu: the inertial sensor calibrates, alongside the routes.
+ * - params, after routes: tuned values saved by earlier runs are read back.
+ * - screen, after routes: the picker is filled in and the Brain screen
+ *   started, so a routine can be chosen during calibration.
+ * - log, after routes and params: MatchLog starts recording.
+ * - odometry, after imu: the pose is tracked from then until the
+ *   program ends.
+ * - finish, after everything: the heap is sealed.
+ *
+ * If field control starts autonomous early, it waits only for the routes and
+ * the odometry; usercontrol waits for the screen and the log.
+ *
+ * Anything that needs memory should get it in one of the stages, from
+ * RobotArena or statically. The heap is sealed by the last stage, so a `make
+ * HEAP_GUARD=1` build reports any allocation made after startup.
+ *
  */
 void pre_auton(void)
 {
+	registerParams();
+
+	AutonLoop.add("tune", 10, tuneTick);
+	AutonLoop.add("sample", 10, sampleTick);
+	AutonLoop.add("scan", 10, scanTick);
+	AutonLoop.add("commands", 10, art::CommandRunner::tick, &AutonCommands);
+	AutonLoop.add("output", 10, outputTick);
+	AutonLogJob = AutonLoop.add("log", 20, logTick);
+	AutonUiJob = AutonLoop.add("ui", 50, uiTick);
+
+	DriveVelocity.setMeasure(measureDriveSpeed);
+	DriveVelocity.setOutput(outputDriveVoltage);
+	DriveVelocity.start();
+	DriveVelocity.watch(TaskWatchdog);
+
+	DriverInput.setCurve(art::kAxis3, &DriveCurve);
+	DriverInput.setCurve(art::kAxis1, &DriveCurve);
+	DriverInput.on(art::kButtonR1, art::kPressed, toggleIntake);
+	DriverInput.on(art::kButtonR2, art::kPressed, reverseIntake);
+	DriverInput.on(art::kButtonR2, art::kReleased, reverseIntake);
+	TuneMenu.attach(DriverInput);
+
+	DriverLoop.add("tune", 10, tuneTick);
+	DriverLoop.add("sample", 10, sampleTick);
+	DriverLoop.add("input", 10, inputTick);
+	DriverLoop.add("drive", 10, driveTick);
+	DriverLoop.add("output", 10, outputTick);
+	DriverLogJob = DriverLoop.add("log", 20, logTick);
+	DriverUiJob = DriverLoop.add("ui", 50, uiTick);
+	DriverProfileJob = DriverLoop.add("profile", 1000, profileTick);
+
+	AutonLoop.watch(TaskWatchdog, "auton", kLoopTimeoutMs);
+	DriverLoop.watch(TaskWatchdog, "driver", kLoopTimeoutMs);
+	art::MatchLog.watch(TaskWatchdog);
+	art::Params.watch(TaskWatchdog);
+	art::BrainDisplay.watch(TaskWatchdog);
+	TaskWatchdog.setReport(reportWatch);
+	TaskWatchdog.setDegrade(shedLoad);
+
+	RouteStage = RobotStartup.add("routes", loadRoutes);
+	ImuStage = RobotStartup.add("imu", calibrateImu);
+	ParamStage = RobotStartup.add("params", loadParams, NULL, RouteStage);
+	ScreenStage = RobotStartup.add("screen", startScreen, NULL, RouteStage);
+	LogStage = RobotStartup.add("log", startLog, NULL, RouteStage | ParamStage);
+	OdometryStage = RobotStartup.add("odometry", startOdometry, NULL, ImuStage);
+	RobotStartup.add("finish", finishStartup, NULL, RobotStartup.all());
+	RobotStartup.start();
+}
+
+/**
+ * @brief Ends whatever the last period left running and zeroes every output
+ *
+ * Field control kills the task of a period without unwinding it, so a routine
+ * cut off mid-way would otherwise keep its slot in AutonCommands, and its
+ * mechanisms their last voltage, into the next period. Cancelling runs each
+ * command's end() first; the outputs are then zeroed in case a command left
+ * one set, and Limiter starts ramping again from rest.
+ */
+void resetPeriod()
+{
+	AutonCommands.cancelAll();
+	DriveVelocity.stop();
+	driveVoltage(0.0f, 0.0f);
+	setVoltage(kIntake, 0.0f);
+	IntakeOn = false;
+	Limiter.reset();
 }
 
 /**
@@ -52,9 +1126,47 @@ void pre_auton(void)
  * is reached, the program will wait till the end of the autonomous period
  * without calling the function again.
  *
+ * Every route was turned into a table of path points during startup, so
+ * nothing expensive happens here. If field control started the period before
+ * startup finished, the routes and the odometry are waited for first, and
+ * nothing else. The chosen routine is handed to AutonCommands and AutonLoop
+ * advances it, together with the other jobs, every tick.
+ *
  */
 void autonomous(void)
 {
+	resetPeriod();
+	RobotStartup.waitFor(RouteStage | OdometryStage, kStartupWaitMs);
+	AutonMap.clearDetections();
+	size_t choice = AutonChoice.selected();
+	art::MatchLog.logPhase(art::kPhaseAutonomous, AutonChoice.selectedName());
+	art::Command *routine = NULL;
+	if (choice == 0)
+	{
+		Odom.setPose(AutonStart);
+		routine = &RouteRoutine;
+	}
+	else if (choice <= AutonRoutes.size())
+	{
+		const art::Route &route = AutonRoutes[choice - 1];
+		Odom.setPose(route.start);
+		LoadedRoutine.setRoute(route);
+		routine = &LoadedRoutine;
+	}
+	else
+	{
+		Odom.setPose(AutonStart);
+	}
+	AutonRoutine = routine;
+	if (routine && !AutonCommands.schedule(*routine))
+	{
+		art::MatchLog.logText("routine cannot run");
+	}
+	AutonLoop.start();
+	while (1)
+	{
+		AutonLoop.runOnce();
+	}
 }
 
 /**
@@ -68,19 +1180,22 @@ void autonomous(void)
  * a starting state. Things like setting pneumatics to specific positions or
  * setting default values.
  *
- * Code inside the loop will run continuously until the usercontrol period ends.
- * Here, you should use values from the controller(s) to update the robot.
- *
- * A 20 millisecond sleep is included to prevent wasted resources while
- * repeating the loop.
+ * The loop itself is run by DriverLoop, which calls each job registered in
+ * pre_auton at its own fixed rate until the usercontrol period ends. Put code
+ * that uses the controller(s) to update the robot in those jobs (driveTick and
+ * uiTick) rather than directly in the loop, so the loop keeps its period no
+ * matter how much work is done each tick.
  *
  */
 void usercontrol(void)
 {
+	resetPeriod();
+	RobotStartup.waitFor(ScreenStage | LogStage, kStartupWaitMs);
+	art::MatchLog.logPhase(art::kPhaseDriver, NULL);
+	DriverLoop.start();
 	while (1)
 	{
-
-		vex::wait(20, vex::msec);
+		DriverLoop.runOnce();
 	}
 }
 
@@ -106,9 +1221,11 @@ int main()
 	// Run the pre-autonomous function.
 	pre_auton();
 
-	// Prevent main from exiting with an infinite loop.
+	// Prevent main from exiting with an infinite loop, watching the other
+	// tasks meanwhile.
 	while (true)
 	{
-		vex::wait(100, vex::msec);
+		vex::wait(kWatchPeriodMs, vex::msec);
+		watchTick();
 	}
 }
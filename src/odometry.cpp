@@ -0,0 +1,166 @@
+/**
+ * @file odometry.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Odometry engine
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Each update turns the change in the two tracking wheels into a displacement
+ * in the robot's frame, corrects it for the arc the robot travelled during the
+ * update, then rotates it into the field frame using the average heading over
+ * the update. That step is the PoseFilter's prediction; the turn comes from
+ * the change in the inertial sensor's heading.
+ */
+
+#include "odometry.h"
+
+#include <math.h>
+
+#include "profiler.h"
+
+namespace art
+{
+	namespace
+	{
+		const float kPi = 3.14159265f;
+		const float kDegToRad = kPi / 180.0f;
+		const float kVelocityFilter = 0.3f; /**< weight of the newest velocity sample */
+	} // namespace
+
+	Odometry::Odometry(vex::rotation &forward, vex::rotation &sideways, vex::inertial &imu,
+					   const OdometryConfig &config, const FusionConfig &fusion)
+		: m_forward(forward), m_sideways(sideways), m_imu(imu), m_config(config), m_filter(fusion),
+		  m_correct(NULL), m_correctContext(NULL), m_publish(NULL), m_publishContext(NULL), m_started(false),
+		  m_working(),
+		  m_headingOffset(0), m_lastForward(0), m_lastSideways(0), m_lastHeading(0)
+	{
+	}
+
+	void Odometry::setCorrection(CorrectFn correct, void *context)
+	{
+		m_correct = correct;
+		m_correctContext = context;
+	}
+
+	void Odometry::setPublisher(PublishFn publish, void *context)
+	{
+		m_publish = publish;
+		m_publishContext = context;
+	}
+
+	void Odometry::start()
+	{
+		if (m_started)
+		{
+			return;
+		}
+		m_started = true;
+
+		m_lastForward = m_forward.position(vex::rotationUnits::deg);
+		m_lastSideways = m_sideways.position(vex::rotationUnits::deg);
+		m_lastHeading = readHeading();
+		m_working.pose.theta = m_lastHeading;
+		m_working.timeUs = timeUs();
+		m_filter.reset(m_working.pose);
+		m_state.write(m_working);
+
+		m_loop.add("odom", kPeriodMs, tick, this);
+		m_task = vex::task(taskEntry, this, vex::task::taskPriorityHigh);
+	}
+
+	void Odometry::setPose(const Pose &pose)
+	{
+		m_resetPose.publish(pose);
+	}
+
+	int Odometry::taskEntry(void *self)
+	{
+		static_cast<Odometry *>(self)->m_loop.run();
+		return 0;
+	}
+
+	void Odometry::tick(void *self)
+	{
+		static_cast<Odometry *>(self)->update();
+	}
+
+	float Odometry::readHeading()
+	{
+		// the inertial sensor reports clockwise-positive degrees
+		return m_headingOffset - (float)m_imu.rotation(vex::rotationUnits::deg) * kDegToRad;
+	}
+
+	void Odometry::update()
+	{
+		PROFILE_SCOPE("odometry");
+
+		if (m_resetPose.fresh())
+		{
+			Pose target = m_resetPose.latest();
+			m_headingOffset += target.theta - readHeading();
+			m_lastHeading = target.theta;
+			m_working.pose = target;
+			m_filter.reset(target);
+		}
+
+		uint64_t now = timeUs();
+		float forward = m_forward.position(vex::rotationUnits::deg);
+		float sideways = m_sideways.position(vex::rotationUnits::deg);
+		float heading = readHeading();
+
+		float degToInches = kPi * m_config.trackerDiameter / 360.0f;
+		float dForward = (forward - m_lastForward) * degToInches;
+		float dSideways = (sideways - m_lastSideways) * degToInches;
+		float dTheta = heading - m_lastHeading;
+		m_lastForward = forward;
+		m_lastSideways = sideways;
+		m_lastHeading = heading;
+
+		// remove the part of each wheel's travel caused by turning in place
+		float localForward = dForward - m_config.forwardOffset * dTheta;
+		float localRight = dSideways + m_config.sidewaysOffset * dTheta;
+
+		// the robot moved along an arc, not a straight line: scale to the chord
+		if (fabsf(dTheta) > 1e-6f)
+		{
+			float chord = 2.0f * sinf(dTheta * 0.5f) / dTheta;
+			localForward *= chord;
+			localRight *= chord;
+		}
+
+		float dt = (float)(now - m_working.timeUs) * 1e-6f;
+		float dx;
+		float dy;
+		{
+			PROFILE_SCOPE("fusion");
+
+			Pose before = m_filter.pose();
+			m_filter.predict(localForward, localRight, dTheta, dt);
+			Pose predicted = m_filter.pose();
+			// the velocity only follows the motion; a correction is a jump, not a speed
+			dx = predicted.x - before.x;
+			dy = predicted.y - before.y;
+			if (m_correct)
+			{
+				m_correct(m_filter, m_correctContext);
+			}
+		}
+		m_working.pose = m_filter.pose();
+
+		if (dt > 0.0f)
+		{
+			m_working.velocity.x += (dx / dt - m_working.velocity.x) * kVelocityFilter;
+			m_working.velocity.y += (dy / dt - m_working.velocity.y) * kVelocityFilter;
+			m_working.velocity.theta += (dTheta / dt - m_working.velocity.theta) * kVelocityFilter;
+		}
+		m_working.timeUs = now;
+
+		m_state.write(m_working);
+		if (m_publish)
+		{
+			m_publish(m_working, m_publishContext);
+		}
+	}
+} // namespace art
@@ -0,0 +1,102 @@
+/**
+ * @file outputLimiter.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the OutputLimiter stage
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "outputLimiter.h"
+
+namespace art
+{
+	namespace
+	{
+		const float kMaxVolts = 12.0f;
+
+		/** @brief Smallest scale trusted when estimating unscaled current */
+		const float kMinEstimateScale = 0.05f;
+
+		float clamp(float value, float low, float high)
+		{
+			return value < low ? low : (value > high ? high : value);
+		}
+
+		float magnitude(float value)
+		{
+			return value < 0.0f ? -value : value;
+		}
+	} // namespace
+
+	OutputLimiter::OutputLimiter(const LimiterConfig &config, size_t count)
+		: m_config(config), m_count(count < kMaxOutputs ? count : kMaxOutputs), m_budgetScale(1.0f),
+		  m_limitedTicks(0)
+	{
+		reset();
+	}
+
+	void OutputLimiter::reset()
+	{
+		for (size_t i = 0; i < kMaxOutputs; i++)
+		{
+			m_last[i] = 0.0f;
+			m_scale[i] = 1.0f;
+		}
+		m_budgetScale = 1.0f;
+	}
+
+	void OutputLimiter::limit(const float *requested, const float *current, const float *temperature,
+							  uint32_t periodMs, float *output)
+	{
+		float period = (float)periodMs * 0.001f;
+		float recovery = kRecoveryPerSecond * period;
+		float slew = m_config.slewRate * period;
+		float thermalRange = m_config.deratingEnd - m_config.deratingStart;
+
+		// what each motor would draw at its full request, and its own limit
+		float full[kMaxOutputs];
+		float own[kMaxOutputs];
+		float budgetDraw = 0.0f;
+		for (size_t i = 0; i < m_count; i++)
+		{
+			float applied = m_scale[i] > kMinEstimateScale ? m_scale[i] : kMinEstimateScale;
+			full[i] = magnitude(current[i]) / applied;
+
+			float thermal = clamp((m_config.deratingEnd - temperature[i]) / thermalRange, 0.0f, 1.0f);
+			float electrical = full[i] > m_config.currentLimit ? m_config.currentLimit / full[i] : 1.0f;
+			own[i] = thermal < electrical ? thermal : electrical;
+
+			if (m_config.budgetMotors & (1u << i))
+			{
+				budgetDraw += full[i] * own[i];
+			}
+		}
+
+		float budget = budgetDraw > m_config.budgetCurrent ? m_config.budgetCurrent / budgetDraw : 1.0f;
+		m_budgetScale = budget < m_budgetScale + recovery ? budget : m_budgetScale + recovery;
+
+		bool limited = false;
+		for (size_t i = 0; i < m_count; i++)
+		{
+			float target = own[i];
+			if (m_config.budgetMotors & (1u << i))
+			{
+				target *= m_budgetScale;
+			}
+			m_scale[i] = target < m_scale[i] + recovery ? target : m_scale[i] + recovery;
+			limited = limited || m_scale[i] < 1.0f;
+
+			float volts = clamp(requested[i], -kMaxVolts, kMaxVolts) * m_scale[i];
+			volts = clamp(volts, m_last[i] - slew, m_last[i] + slew);
+			m_last[i] = volts;
+			output[i] = volts;
+		}
+
+		if (limited)
+		{
+			m_limitedTicks++;
+		}
+	}
+} // namespace art
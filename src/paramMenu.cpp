@@ -0,0 +1,138 @@
+/**
+ * @file paramMenu.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining ParamMenu
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Values are shown to three decimals, formatted by hand from integers: the
+ * menu draws from the control task, where newlib's float formatting could
+ * allocate after the heap is sealed.
+ */
+
+#include "paramMenu.h"
+
+namespace art
+{
+	namespace
+	{
+		/** @brief Appends value with three decimals, without float formatting */
+		void appendValue(FixedString<ParamMenu::kColumns> &text, float value, ParamType type)
+		{
+			if (type != kParamFloat)
+			{
+				text.appendf("%ld", (long)value);
+				return;
+			}
+			long thousandths = (long)(value * 1000.0f + (value < 0.0f ? -0.5f : 0.5f));
+			unsigned long magnitude = thousandths < 0 ? -thousandths : thousandths;
+			text.appendf("%s%lu.%03lu", thousandths < 0 ? "-" : "", magnitude / 1000, magnitude % 1000);
+		}
+	} // namespace
+
+	ParamMenu::ParamMenu(ParamRegistry &params, vex::controller::lcd &screen)
+		: m_params(params), m_screen(screen), m_open(false), m_selected(0), m_cleared(false)
+	{
+	}
+
+	bool ParamMenu::attach(Input &input)
+	{
+		static const Button kButtons[] = {kButtonX, kButtonUp, kButtonDown, kButtonRight, kButtonLeft, kButtonA};
+		bool ok = true;
+		for (size_t i = 0; i < sizeof(kButtons) / sizeof(kButtons[0]); i++)
+		{
+			ok = input.on(kButtons[i], kPressed, onButton, this) && ok;
+		}
+		ok = input.on(kButtonRight, kHeld, onButton, this) && ok;
+		ok = input.on(kButtonLeft, kHeld, onButton, this) && ok;
+		return ok;
+	}
+
+	void ParamMenu::onButton(Button button, InputEvent event, void *self)
+	{
+		ParamMenu &menu = *static_cast<ParamMenu *>(self);
+		if (button == kButtonX)
+		{
+			menu.m_open = !menu.m_open;
+			return;
+		}
+		size_t count = menu.m_params.size();
+		if (!menu.m_open || count == 0)
+		{
+			return;
+		}
+
+		int steps = event == kHeld ? kHeldSteps : 1;
+		switch (button)
+		{
+		case kButtonUp:
+			menu.m_selected = (menu.m_selected + count - 1) % count;
+			break;
+		case kButtonDown:
+			menu.m_selected = (menu.m_selected + 1) % count;
+			break;
+		case kButtonRight:
+			menu.m_params.nudge(menu.m_selected, steps);
+			break;
+		case kButtonLeft:
+			menu.m_params.nudge(menu.m_selected, -steps);
+			break;
+		case kButtonA:
+			menu.m_params.requestSave();
+			break;
+		default:
+			break;
+		}
+	}
+
+	void ParamMenu::compose()
+	{
+		for (int row = 0; row < kRows; row++)
+		{
+			m_lines[row].clear();
+		}
+		if (!m_open || m_params.size() == 0)
+		{
+			return;
+		}
+
+		size_t i = m_selected;
+		m_lines[0].format("%s.%s", m_params.groupName(m_params.group(i)), m_params.name(i));
+		appendValue(m_lines[1], m_params.value(i), m_params.type(i));
+		if (m_params.pending(i))
+		{
+			m_lines[1].append(" *");
+		}
+		m_lines[2].format("%u/%u %s", (unsigned)(i + 1), (unsigned)m_params.size(),
+						  m_params.unsaved() ? "unsaved" : "saved");
+	}
+
+	void ParamMenu::draw()
+	{
+		if (!m_cleared)
+		{
+			// whatever the program before this one left there
+			m_screen.clearScreen();
+			m_cleared = true;
+			return;
+		}
+
+		compose();
+		for (int row = 0; row < kRows; row++)
+		{
+			if (m_shown[row] != m_lines[row].c_str())
+			{
+				m_screen.clearLine(row + 1);
+				if (!m_lines[row].empty())
+				{
+					m_screen.setCursor(row + 1, 1);
+					m_screen.print("%s", m_lines[row].c_str());
+				}
+				m_shown[row] = m_lines[row];
+				return;
+			}
+		}
+	}
+} // namespace art
@@ -0,0 +1,402 @@
+/**
+ * @file params.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the ParamRegistry
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Every entry keeps its staged value next to a pointer to the variable it
+ * edits, and a bitmask records which entries have an edit waiting. Staging
+ * and applying both hold the registry's lock, so the values written by one
+ * apply() are always a set that was staged together. The group callbacks
+ * run after the lock is released, so they may take as long as they need.
+ */
+
+#include "params.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "scheduler.h"
+
+namespace art
+{
+	namespace
+	{
+		const char kMagic[4] = {'A', 'R', 'T', 'P'};
+		const uint16_t kFormatVersion = 1;
+
+		struct FileHeader
+		{
+			char magic[4];
+			uint16_t version;
+			uint16_t count;
+			uint32_t size;
+			uint32_t checksum;
+		};
+
+		struct ParamRecord
+		{
+			char name[ParamRegistry::kNameLength];
+			uint8_t type;
+			uint8_t reserved[3];
+			uint8_t value[4];
+		};
+
+		static_assert(sizeof(FileHeader) == 16, "FileHeader must match the file format");
+		static_assert(sizeof(ParamRecord) == 24, "ParamRecord must match the file format");
+
+		const size_t kMaxFileBytes = sizeof(FileHeader) + ParamRegistry::kMaxParams * sizeof(ParamRecord);
+
+		uint32_t fnv1a(const uint8_t *data, size_t size)
+		{
+			uint32_t hash = 2166136261u;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ data[i]) * 16777619u;
+			}
+			return hash;
+		}
+
+		uint32_t nowMs()
+		{
+			return (uint32_t)(timeUs() / 1000);
+		}
+	} // namespace
+
+	ParamRegistry Params;
+
+	ParamRegistry::ParamRegistry()
+		: m_count(0), m_groupCount(0), m_dirty(0), m_fileName(NULL), m_unsaved(false), m_saveRequested(false),
+		  m_lastEditMs(0), m_loaded(0), m_applied(0), m_saves(0), m_saveErrors(0)
+	{
+	}
+
+	int ParamRegistry::addGroup(const char *name, ApplyFn apply, void *context)
+	{
+		if (m_groupCount >= kMaxGroups)
+		{
+			return -1;
+		}
+		Group &group = m_groups[m_groupCount];
+		group.name = name;
+		group.apply = apply;
+		group.context = context;
+		return (int)m_groupCount++;
+	}
+
+	int ParamRegistry::addEntry(int group, const char *name, ParamType type, void *target, float min, float max,
+								float step, Value initial)
+	{
+		if (m_count >= kMaxParams || group < 0 || (size_t)group >= m_groupCount || !target || !name ||
+			strlen(name) >= kNameLength || find(name) >= 0 || !(min <= max))
+		{
+			return -1;
+		}
+		Entry &entry = m_entries[m_count];
+		memset(entry.name, 0, sizeof(entry.name));
+		strncpy(entry.name, name, kNameLength - 1);
+		entry.type = (uint8_t)type;
+		entry.group = (uint8_t)group;
+		entry.target = target;
+		entry.min = min;
+		entry.max = max;
+		entry.step = step;
+		entry.staged = initial;
+		return (int)m_count++;
+	}
+
+	int ParamRegistry::add(int group, const char *name, float *value, float min, float max, float step)
+	{
+		if (!value || *value < min || *value > max)
+		{
+			return -1;
+		}
+		Value initial;
+		initial.f = *value;
+		return addEntry(group, name, kParamFloat, value, min, max, step, initial);
+	}
+
+	int ParamRegistry::add(int group, const char *name, int32_t *value, int32_t min, int32_t max, int32_t step)
+	{
+		if (!value || *value < min || *value > max)
+		{
+			return -1;
+		}
+		Value initial;
+		initial.i = *value;
+		return addEntry(group, name, kParamInt, value, (float)min, (float)max, (float)step, initial);
+	}
+
+	int ParamRegistry::add(int group, const char *name, bool *value)
+	{
+		if (!value)
+		{
+			return -1;
+		}
+		Value initial;
+		initial.i = *value ? 1 : 0;
+		return addEntry(group, name, kParamBool, value, 0.0f, 1.0f, 1.0f, initial);
+	}
+
+	int ParamRegistry::find(const char *name) const
+	{
+		for (size_t i = 0; i < m_count; i++)
+		{
+			if (strncmp(m_entries[i].name, name, kNameLength) == 0)
+			{
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+
+	float ParamRegistry::value(size_t index)
+	{
+		if (index >= m_count)
+		{
+			return 0.0f;
+		}
+		m_lock.lock();
+		const Entry &entry = m_entries[index];
+		float value = entry.type == kParamFloat ? entry.staged.f : (float)entry.staged.i;
+		m_lock.unlock();
+		return value;
+	}
+
+	bool ParamRegistry::pending(size_t index)
+	{
+		m_lock.lock();
+		bool pending = index < m_count && (m_dirty & ((uint32_t)1 << index));
+		m_lock.unlock();
+		return pending;
+	}
+
+	ParamResult ParamRegistry::stage(size_t index, float value)
+	{
+		Entry &entry = m_entries[index];
+		if (!(value >= entry.min && value <= entry.max))
+		{
+			return kParamOutOfRange;
+		}
+		if (entry.type == kParamFloat)
+		{
+			entry.staged.f = value;
+		}
+		else if (floorf(value) != value)
+		{
+			return kParamNotWhole;
+		}
+		else
+		{
+			entry.staged.i = (int32_t)value;
+		}
+		m_dirty |= (uint32_t)1 << index;
+		return kParamOk;
+	}
+
+	ParamResult ParamRegistry::set(size_t index, float value)
+	{
+		if (index >= m_count)
+		{
+			return kParamUnknown;
+		}
+		m_lock.lock();
+		ParamResult result = stage(index, value);
+		if (result == kParamOk)
+		{
+			m_lastEditMs = nowMs();
+			m_unsaved.store(true, std::memory_order_release);
+		}
+		m_lock.unlock();
+		return result;
+	}
+
+	ParamResult ParamRegistry::nudge(size_t index, int steps)
+	{
+		if (index >= m_count)
+		{
+			return kParamUnknown;
+		}
+		const Entry &entry = m_entries[index];
+		float value = this->value(index) + entry.step * (float)steps;
+		value = value < entry.min ? entry.min : (value > entry.max ? entry.max : value);
+		if (entry.type != kParamFloat)
+		{
+			value = floorf(value + 0.5f);
+		}
+		return set(index, value);
+	}
+
+	size_t ParamRegistry::apply()
+	{
+		uint32_t groups = 0;
+		size_t written = 0;
+
+		m_lock.lock();
+		for (size_t i = 0; i < m_count && m_dirty; i++)
+		{
+			uint32_t bit = (uint32_t)1 << i;
+			if (!(m_dirty & bit))
+			{
+				continue;
+			}
+			const Entry &entry = m_entries[i];
+			switch (entry.type)
+			{
+			case kParamFloat:
+				*static_cast<float *>(entry.target) = entry.staged.f;
+				break;
+			case kParamInt:
+				*static_cast<int32_t *>(entry.target) = entry.staged.i;
+				break;
+			default:
+				*static_cast<bool *>(entry.target) = entry.staged.i != 0;
+				break;
+			}
+			m_dirty &= ~bit;
+			groups |= (uint32_t)1 << entry.group;
+			written++;
+		}
+		m_lock.unlock();
+
+		for (size_t g = 0; g < m_groupCount; g++)
+		{
+			if ((groups & ((uint32_t)1 << g)) && m_groups[g].apply)
+			{
+				m_groups[g].apply(m_groups[g].context);
+			}
+		}
+		m_applied += written;
+		return written;
+	}
+
+	bool ParamRegistry::load(const char *fileName)
+	{
+		m_loaded = 0;
+		if (!Brain.SDcard.isInserted() || !Brain.SDcard.exists(fileName))
+		{
+			return true;
+		}
+
+		uint8_t image[kMaxFileBytes];
+		int32_t size = Brain.SDcard.loadfile(fileName, image, sizeof(image));
+		FileHeader header;
+		if (size < (int32_t)sizeof(header))
+		{
+			return false;
+		}
+		memcpy(&header, image, sizeof(header));
+		if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion ||
+			header.size != (uint32_t)size || header.size != sizeof(header) + header.count * sizeof(ParamRecord) ||
+			fnv1a(image + sizeof(header), size - sizeof(header)) != header.checksum)
+		{
+			return false;
+		}
+
+		m_lock.lock();
+		for (size_t r = 0; r < header.count; r++)
+		{
+			ParamRecord record;
+			memcpy(&record, image + sizeof(header) + r * sizeof(record), sizeof(record));
+			record.name[kNameLength - 1] = '\0';
+			int index = find(record.name);
+			if (index < 0 || record.type != m_entries[index].type)
+			{
+				continue;
+			}
+			Value value;
+			memcpy(&value, record.value, sizeof(value));
+			if (stage((size_t)index, record.type == kParamFloat ? value.f : (float)value.i) == kParamOk)
+			{
+				m_loaded++;
+			}
+		}
+		m_lock.unlock();
+		return true;
+	}
+
+	size_t ParamRegistry::encode(uint8_t *image, size_t capacity)
+	{
+		size_t size = sizeof(FileHeader) + m_count * sizeof(ParamRecord);
+		if (size > capacity)
+		{
+			return 0;
+		}
+		for (size_t i = 0; i < m_count; i++)
+		{
+			const Entry &entry = m_entries[i];
+			ParamRecord record;
+			memset(&record, 0, sizeof(record));
+			memcpy(record.name, entry.name, kNameLength);
+			record.type = entry.type;
+			memcpy(record.value, &entry.staged, sizeof(record.value));
+			memcpy(image + sizeof(FileHeader) + i * sizeof(record), &record, sizeof(record));
+		}
+
+		FileHeader header;
+		memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.version = kFormatVersion;
+		header.count = (uint16_t)m_count;
+		header.size = (uint32_t)size;
+		header.checksum = fnv1a(image + sizeof(header), size - sizeof(header));
+		memcpy(image, &header, sizeof(header));
+		return size;
+	}
+
+	void ParamRegistry::startSaving(const char *fileName)
+	{
+		if (m_fileName || !fileName)
+		{
+			return;
+		}
+		m_fileName = fileName;
+		m_task = vex::task(taskEntry, this, vex::task::taskPrioritylow);
+	}
+
+	bool ParamRegistry::watch(Watchdog &watchdog)
+	{
+		return m_watch.attach(watchdog, "param save", kSavePeriodMs, 2000, false);
+	}
+
+	int ParamRegistry::taskEntry(void *self)
+	{
+		static_cast<ParamRegistry *>(self)->saveLoop();
+		return 0;
+	}
+
+	void ParamRegistry::saveLoop()
+	{
+		uint8_t image[kMaxFileBytes];
+		while (true)
+		{
+			vex::wait(kSavePeriodMs, vex::msec);
+			m_watch.checkIn();
+
+			bool requested = m_saveRequested.exchange(false, std::memory_order_acq_rel);
+			if (!requested && !(m_unsaved.load(std::memory_order_acquire) && nowMs() - m_lastEditMs >= kSaveDelayMs))
+			{
+				continue;
+			}
+
+			// the image is taken under the lock, and written without it: the SD card can stall
+			m_lock.lock();
+			size_t size = encode(image, sizeof(image));
+			m_unsaved.store(false, std::memory_order_release);
+			m_lock.unlock();
+
+			if (Brain.SDcard.savefile(m_fileName, image, (int32_t)size) == (int32_t)size)
+			{
+				m_saves++;
+			}
+			else
+			{
+				// edited again or not, try again next time
+				m_unsaved.store(true, std::memory_order_release);
+				m_saveErrors++;
+			}
+		}
+	}
+} // namespace art
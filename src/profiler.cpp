@@ -0,0 +1,222 @@
+/**
+ * @file profiler.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the section profiler's tables and reports
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Timings go into a log-linear histogram: exact below 8 ns, then eight bins
+ * per power of two, so a bin is never wider than 1/8 of the values in it.
+ * The p99 is read back as the top of the bin the 99th percentile falls in.
+ */
+
+#include "profiler.h"
+
+#include <string.h>
+
+namespace art
+{
+	namespace profiler
+	{
+#ifdef ART_ENABLE_PROFILER
+		namespace
+		{
+			const uint32_t kSubBins = 8;
+			const uint32_t kSubBits = 3;
+			const uint32_t kMaxExponent = 31; /**< covers every uint32_t, up to about 4.3 s */
+			const uint32_t kBins = kSubBins + (kMaxExponent - kSubBits + 1) * kSubBins;
+
+			uint32_t binOf(uint32_t ns)
+			{
+				if (ns < kSubBins)
+				{
+					return ns;
+				}
+				uint32_t exponent = 31 - (uint32_t)__builtin_clz(ns);
+				uint32_t sub = (ns >> (exponent - kSubBits)) & (kSubBins - 1);
+				return kSubBins + (exponent - kSubBits) * kSubBins + sub;
+			}
+
+			uint32_t binTop(uint32_t bin)
+			{
+				if (bin < kSubBins)
+				{
+					return bin;
+				}
+				uint32_t exponent = (bin - kSubBins) / kSubBins + kSubBits;
+				uint32_t sub = (bin - kSubBins) % kSubBins;
+				return (uint32_t)(((uint64_t)(kSubBins + sub + 1) << (exponent - kSubBits)) - 1);
+			}
+		} // namespace
+
+		struct Section
+		{
+			const char *name;
+			uint32_t count;
+			uint32_t minNs;
+			uint32_t maxNs;
+			uint64_t totalNs;
+			uint32_t histogram[kBins];
+		};
+
+		namespace
+		{
+			Section s_sections[kMaxSections];
+			volatile size_t s_count = 0;
+			vex::mutex s_registry;
+
+			void clear(Section &section)
+			{
+				section.count = 0;
+				section.minNs = UINT32_MAX;
+				section.maxNs = 0;
+				section.totalNs = 0;
+				memset(section.histogram, 0, sizeof(section.histogram));
+			}
+		} // namespace
+
+		Section *section(const char *name)
+		{
+			s_registry.lock();
+			Section *found = NULL;
+			for (size_t i = 0; i < s_count && !found; i++)
+			{
+				if (strcmp(s_sections[i].name, name) == 0)
+				{
+					found = &s_sections[i];
+				}
+			}
+			if (!found && s_count < kMaxSections)
+			{
+				found = &s_sections[s_count];
+				found->name = name;
+				clear(*found);
+				s_count = s_count + 1;
+			}
+			s_registry.unlock();
+			return found;
+		}
+
+		void record(Section *section, uint32_t elapsedNs)
+		{
+			if (!section)
+			{
+				return;
+			}
+			section->count++;
+			section->totalNs += elapsedNs;
+			if (elapsedNs < section->minNs)
+			{
+				section->minNs = elapsedNs;
+			}
+			if (elapsedNs > section->maxNs)
+			{
+				section->maxNs = elapsedNs;
+			}
+			section->histogram[binOf(elapsedNs)]++;
+		}
+
+		size_t count()
+		{
+			return s_count;
+		}
+
+		SectionStats stats(size_t index)
+		{
+			const Section &section = s_sections[index];
+			SectionStats result = {section.name, section.count, 0, 0, 0, 0};
+			if (section.count == 0)
+			{
+				return result;
+			}
+			result.minNs = section.minNs;
+			result.maxNs = section.maxNs;
+			result.avgNs = (uint32_t)(section.totalNs / section.count);
+
+			// smallest bin with at least 99% of the samples at or below it
+			uint32_t threshold = section.count - section.count / 100;
+			uint32_t seen = 0;
+			for (uint32_t bin = 0; bin < kBins; bin++)
+			{
+				seen += section.histogram[bin];
+				if (seen >= threshold)
+				{
+					uint32_t top = binTop(bin);
+					result.p99Ns = top < section.maxNs ? top : section.maxNs;
+					break;
+				}
+			}
+			return result;
+		}
+
+		void reset()
+		{
+			for (size_t i = 0; i < s_count; i++)
+			{
+				clear(s_sections[i]);
+			}
+		}
+
+		void report(vex::brain::lcd &screen, int x, int y)
+		{
+			screen.setFont(vex::fontType::mono15);
+			screen.printAt(x, y + 12, "%-12s %7s %6s %6s %6s %6s", "section", "count", "min us", "avg us",
+						   "max us", "p99 us");
+			for (size_t i = 0; i < s_count; i++)
+			{
+				SectionStats s = stats(i);
+				screen.printAt(x, y + 27 + 15 * (int)i, "%-12.12s %7lu %6lu %6lu %6lu %6lu", s.name,
+							   (unsigned long)s.count, (unsigned long)(s.minNs / 1000), (unsigned long)(s.avgNs / 1000),
+							   (unsigned long)(s.maxNs / 1000), (unsigned long)(s.p99Ns / 1000));
+			}
+		}
+
+		void dump(Telemetry &log)
+		{
+			for (size_t i = 0; i < s_count; i++)
+			{
+				SectionStats s = stats(i);
+				uint8_t payload[kNameLength + 5 * sizeof(uint32_t)] = {};
+				strncpy(reinterpret_cast<char *>(payload), s.name, kNameLength);
+				uint32_t values[5] = {s.count, s.minNs, s.avgNs, s.maxNs, s.p99Ns};
+				memcpy(payload + kNameLength, values, sizeof(values));
+				log.write(kTelemetryProfile, payload, sizeof(payload));
+			}
+		}
+#else
+		Section *section(const char *)
+		{
+			return NULL;
+		}
+
+		void record(Section *, uint32_t)
+		{
+		}
+
+		size_t count()
+		{
+			return 0;
+		}
+
+		SectionStats stats(size_t)
+		{
+			SectionStats result = {"", 0, 0, 0, 0, 0};
+			return result;
+		}
+
+		void reset()
+		{
+		}
+
+		void report(vex::brain::lcd &, int, int)
+		{
+		}
+
+		void dump(Telemetry &)
+		{
+		}
+#endif
+	} // namespace profiler
+} // namespace art
@@ -0,0 +1,257 @@
+/**
+ * @file replan.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Replanner
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The spliced path is built from three pieces: the path from the robot's
+ * current point to where the detour leaves it, the detour's own points
+ * without its two ends, and the path from where the detour rejoins it to the
+ * end. Copying the rest of the path costs a few kilobytes for a long route,
+ * but keeps the follower working on one plain array as it always has.
+ */
+
+#include "replan.h"
+
+#include <math.h>
+
+#include "scheduler.h"
+
+namespace art
+{
+	namespace
+	{
+		const float kPi = 3.14159265f;
+
+		/** @brief Direction of travel along a path at point i, radians */
+		float tangentAt(const Path &path, size_t i)
+		{
+			size_t before = i > 0 ? i - 1 : 0;
+			size_t after = i + 1 < path.size() ? i + 1 : i;
+			return atan2f(path[after].y - path[before].y, path[after].x - path[before].x);
+		}
+
+		bool stepBlocked(const FieldMap &map, const Path &path, size_t i, int layers)
+		{
+			return map.sweptBlocked(path[i].x, path[i].y, path[i + 1].x, path[i + 1].y, layers);
+		}
+	} // namespace
+
+	Replanner::Replanner(const FieldMap &map, const ReplanConfig &config)
+		: m_map(map), m_config(config), m_constraints(), m_next(0), m_failedPath(NULL), m_failedRevision(0),
+		  m_failedResult(kPathBlocked), m_replans(0), m_failures(0), m_outOfMemory(0), m_worstUs(0)
+	{
+		m_scratch[0] = NULL;
+		m_scratch[1] = NULL;
+	}
+
+	bool Replanner::reserve(Arena &arena, const TrajectoryConstraints &constraints, size_t longestPath)
+	{
+		size_t bytes = longestPath * sizeof(PathPoint) + m_config.scratchBytes;
+		size_t mark = arena.mark();
+		for (int i = 0; i < 2; i++)
+		{
+			void *buffer = arena.allocate(bytes);
+			m_scratch[i] = buffer ? arena.create<Arena>(buffer, bytes) : NULL;
+			if (!m_scratch[i])
+			{
+				arena.rewind(mark);
+				m_scratch[0] = NULL;
+				m_scratch[1] = NULL;
+				return false;
+			}
+		}
+		m_constraints = constraints;
+		return true;
+	}
+
+	ReplanResult Replanner::update(PurePursuit &follower)
+	{
+		const Path &path = follower.path();
+		if (!m_scratch[0] || follower.finished() || !path.valid())
+		{
+			return kPathClear;
+		}
+
+		size_t last = path.size() - 1;
+		size_t from = follower.index();
+		size_t ahead = (size_t)ceilf(m_config.checkDistance / path.spacing());
+		size_t end = from + ahead < last ? from + ahead : last;
+		size_t blockStart = end;
+		for (size_t i = from; i < end; i++)
+		{
+			if (stepBlocked(m_map, path, i, kDetectedLayer))
+			{
+				blockStart = i;
+				break;
+			}
+		}
+		if (blockStart == end)
+		{
+			return kPathClear;
+		}
+		if (&path[0] == m_failedPath && m_map.revision() == m_failedRevision)
+		{
+			return m_failedResult;
+		}
+
+		// the block ends once the path has been clear for lead inches, or at
+		// the end of the path, where the detour then finishes
+		size_t clearRun = (size_t)ceilf(m_config.lead / path.spacing());
+		size_t blockEnd = blockStart + 1;
+		size_t run = 0;
+		for (size_t i = blockStart + 1; i <= last && run < clearRun; i++)
+		{
+			if (m_map.blocked(path[i].x, path[i].y, kDetectedLayer))
+			{
+				blockEnd = i;
+				run = 0;
+			}
+			else
+			{
+				run++;
+			}
+		}
+
+		uint64_t startUs = timeUs();
+		ReplanResult result = kPathBlocked;
+		if (!m_map.blocked(path[from].x, path[from].y, kDetectedLayer) &&
+			!m_map.blocked(path[last].x, path[last].y, kDetectedLayer))
+		{
+			result = plan(follower, from, blockStart, blockEnd);
+		}
+		uint32_t tookUs = (uint32_t)(timeUs() - startUs);
+		m_worstUs = tookUs > m_worstUs ? tookUs : m_worstUs;
+		if (result != kPathReplanned)
+		{
+			if (result == kPathNoMemory)
+			{
+				m_outOfMemory++;
+			}
+			else
+			{
+				m_failures++;
+			}
+			m_failedPath = &path[0];
+			m_failedRevision = m_map.revision();
+			m_failedResult = result;
+			return result;
+		}
+		m_replans++;
+		return kPathReplanned;
+	}
+
+	ReplanResult Replanner::plan(PurePursuit &follower, size_t from, size_t blockStart, size_t blockEnd)
+	{
+		const Path &path = follower.path();
+		size_t last = path.size() - 1;
+		size_t clearRun = (size_t)ceilf(m_config.lead / path.spacing());
+		size_t leave = blockStart > from + clearRun ? blockStart - clearRun : from;
+		size_t rejoin = blockEnd + clearRun < last ? blockEnd + clearRun : last;
+
+		size_t middle = (blockStart + blockEnd) / 2;
+		float heading = tangentAt(path, middle);
+		float normalX = -sinf(heading);
+		float normalY = cosf(heading);
+		bool outOfMemory = false;
+		for (float offset = m_config.offsetStep; offset <= m_config.maxOffset; offset += m_config.offsetStep)
+		{
+			for (int side = 1; side >= -1; side -= 2)
+			{
+				float x = path[middle].x + normalX * offset * side;
+				float y = path[middle].y + normalY * offset * side;
+				if (m_map.blocked(x, y, kAllLayers))
+				{
+					continue;
+				}
+				Arena &arena = *m_scratch[m_next];
+				arena.rewind(0);
+				uint32_t failures = arena.failures();
+				Path detour;
+				if (tryDetour(path, from, leave, rejoin, x, y, heading, arena, detour))
+				{
+					follower.begin(detour);
+					m_next ^= 1;
+					return kPathReplanned;
+				}
+				// a try that ran out of room says nothing about whether the way is clear
+				outOfMemory = outOfMemory || arena.failures() != failures;
+			}
+		}
+		return outOfMemory ? kPathNoMemory : kPathBlocked;
+	}
+
+	bool Replanner::tryDetour(const Path &path, size_t from, size_t leave, size_t rejoin, float x, float y,
+							  float middleHeading, Arena &arena, Path &out)
+	{
+		const PathPoint &a = path[leave];
+		const PathPoint &b = path[rejoin];
+		bool reversed = a.velocity < 0.0f || path[leave + 1].velocity < 0.0f;
+		float flip = reversed ? kPi : 0.0f;
+
+		// no faster than the stretch it replaces, the robot's limits allowing
+		float fastest = m_config.minVelocity;
+		for (size_t i = leave; i <= rejoin; i++)
+		{
+			fastest = fmaxf(fastest, fabsf(path[i].velocity));
+		}
+		TrajectoryConstraints limits = m_constraints;
+		limits.maxVelocity = fminf(limits.maxVelocity, fastest);
+		limits.reversed = reversed;
+
+		Waypoint waypoints[3] = {
+			{a.x, a.y, tangentAt(path, leave) + flip},
+			{x, y, middleHeading + flip},
+			{b.x, b.y, tangentAt(path, rejoin) + flip},
+		};
+		Trajectory trajectory = Trajectory::generate(waypoints, 3, limits, arena, a.velocity, b.velocity);
+		Path detour = Path::fromTrajectory(trajectory, path.spacing(), arena);
+		if (!detour.valid())
+		{
+			return false;
+		}
+
+		// keep off the fixed field too, unless the route itself was on it
+		bool onField = !m_map.blocked(a.x, a.y, kFixedLayer) && !m_map.blocked(b.x, b.y, kFixedLayer);
+		int layers = onField ? kAllLayers : kDetectedLayer;
+		for (size_t i = 0; i + 1 < detour.size(); i++)
+		{
+			if (stepBlocked(m_map, detour, i, layers))
+			{
+				return false;
+			}
+		}
+
+		size_t last = path.size() - 1;
+		size_t inner = detour.size() - 2;
+		size_t count = (leave - from + 1) + inner + (last - rejoin + 1);
+		PathPoint *points = arena.createArray<PathPoint>(count);
+		if (!points)
+		{
+			return false;
+		}
+		size_t n = 0;
+		for (size_t i = from; i <= leave; i++)
+		{
+			points[n++] = path[i];
+		}
+		// the detour's points carry on counting the route's distance, so
+		// actions along it still line up
+		float scale = detour.length() > 0.0f ? (b.distance - a.distance) / detour.length() : 0.0f;
+		for (size_t i = 1; i <= inner; i++)
+		{
+			points[n] = detour[i];
+			points[n].distance = a.distance + detour[i].distance * scale;
+			n++;
+		}
+		for (size_t i = rejoin; i <= last; i++)
+		{
+			points[n++] = path[i];
+		}
+		out = Path(points, count, path.spacing());
+		return true;
+	}
+} // namespace art
@@ -16,5 +16,325 @@
 
 #include "robotConfig.h"
 
+#include "kernels.h"
+#include "profiler.h"
+
 vex::brain Brain;
-vex::controller Controller1;
\ No newline at end of file
+vex::controller Controller1;
+
+art::Input DriverInput(Controller1);
+
+constexpr art::MotorSpec RobotLayout::kMotors[kMotorCount];
+constexpr int32_t RobotLayout::kDistancePorts[kDistanceCount];
+constexpr art::RangeMount RobotLayout::kDistanceMounts[kDistanceCount];
+constexpr int32_t RobotLayout::kSensorPorts[];
+constexpr art::FieldElement FieldLayout::kElements[];
+constexpr art::FieldGrid FieldLayout::kGrid;
+
+art::MotorTable<RobotLayout> Motors;
+
+vex::motor &LeftFront = Motors[kLeftFront];
+vex::motor &LeftMiddle = Motors[kLeftMiddle];
+vex::motor &LeftBack = Motors[kLeftBack];
+vex::motor &RightFront = Motors[kRightFront];
+vex::motor &RightMiddle = Motors[kRightMiddle];
+vex::motor &RightBack = Motors[kRightBack];
+vex::motor &Intake = Motors[kIntake];
+
+const DrivetrainConfig DriveConfig = {
+	12.0f,  // trackWidth
+	3.25f,  // wheelDiameter
+	0.75f,  // gearRatio, 36:48 on 600 rpm cartridges
+	60.0f,  // maxVelocity
+	120.0f, // maxAccel
+	DriveFeedforward::kS, // kS
+	DriveFeedforward::kV, // kV
+	DriveFeedforward::kA, // kA
+};
+
+/**
+ * @brief Limits on the motors' outputs
+ *
+ * A V5 motor draws at most 2.5 A and its firmware starts cutting power at
+ * about 55 C. Derating earlier, and more gently, keeps the drive moving
+ * instead. The drive shares a budget of 14 A so the intake is never starved
+ * and the battery never sags far enough to brown out.
+ */
+static const art::LimiterConfig LimiterSettings = {
+	96.0f,                                      // slewRate, 0 to 12 V in 125 ms
+	2.5f,                                       // currentLimit
+	45.0f,                                      // deratingStart
+	60.0f,                                      // deratingEnd
+	14.0f,                                      // budgetCurrent
+	art::MotorTable<RobotLayout>::mask(kDrive), // budgetMotors
+};
+
+art::OutputLimiter Limiter(LimiterSettings, kMotorCount);
+
+/**
+ * @brief Latest voltage requested for each motor, indexed by MotorId
+ */
+static float Requested[kMotorCount];
+
+void setVoltage(MotorId motor, float volts)
+{
+	Requested[motor] = volts;
+}
+
+void driveVoltage(float left, float right)
+{
+	for (int i = 0; i < kMotorCount; i++)
+	{
+		if (Motors.inGroup(i, kLeftDrive))
+		{
+			Requested[i] = left;
+		}
+		else if (Motors.inGroup(i, kRightDrive))
+		{
+			Requested[i] = right;
+		}
+	}
+}
+
+void applyOutputs(uint32_t periodMs)
+{
+	PROFILE_SCOPE("output");
+
+	DeviceSnapshot devices = Devices.read();
+	float volts[kMotorCount];
+	Limiter.limit(Requested, devices.motorLoad, devices.motorTemperature, periodMs, volts);
+	for (int i = 0; i < kMotorCount; i++)
+	{
+		Motors[i].spin(vex::directionType::fwd, volts[i], vex::voltageUnits::volt);
+	}
+}
+
+vex::inertial Imu(RobotLayout::kImuPort);
+vex::rotation ForwardTracker(RobotLayout::kForwardTrackerPort, false);
+vex::rotation SidewaysTracker(RobotLayout::kSidewaysTrackerPort, false);
+
+vex::distance LeftDistance(RobotLayout::kDistancePorts[kLeftDistance]);
+vex::distance RightDistance(RobotLayout::kDistancePorts[kRightDistance]);
+vex::distance BackDistance(RobotLayout::kDistancePorts[kBackDistance]);
+vex::distance FrontDistance(RobotLayout::kDistancePorts[kFrontDistance]);
+
+/**
+ * @brief The distance sensors in DistanceId order, for sampling in a loop
+ */
+static vex::distance *const DistanceSensors[kDistanceCount] = {&LeftDistance, &RightDistance, &BackDistance,
+																	   &FrontDistance};
+
+/**
+ * @brief Tracking wheel geometry, measured from the robot's centre of rotation
+ */
+const art::OdometryConfig OdomConfig = {
+	2.0f,  // trackerDiameter
+	0.0f,  // forwardOffset
+	-2.0f, // sidewaysOffset
+};
+
+/**
+ * @brief How far the odometry is trusted, and how far the distance sensors are
+ *
+ * The tracking wheels are taken to be good to about an inch per 100 inches
+ * driven and the inertial sensor to drift about a degree a minute. The V5
+ * distance sensor is specified to within 5% beyond 200 mm; 3% plus half an
+ * inch matches what ours read against a field wall.
+ */
+const art::FusionConfig FusionSettings = {
+	0.01f,     // slipVariance
+	0.0001f,   // turnVariance
+	0.000005f, // driftVariance
+	0.5f,      // rangeNoise
+	0.03f,     // rangeNoiseFraction
+	70.0f,     // maxRange
+	0.85f,     // minIncidence, about 30 degrees off square
+	3.0f,      // gate
+	144.0f,    // fieldSize
+};
+
+/**
+ * @brief What the distance sensors have to see before autonomous steers round
+ * it
+ *
+ * Readings are only placed on the field up to 48 inches, where the sensor's
+ * 5% and the odometry's error still put an object within a few inches. Two
+ * readings in a row within 2 inches of each other count as one object, which
+ * at 10 ms a reading leaves room for the robot moving, not for noise.
+ */
+const art::ObstacleConfig ObstacleSettings = {
+	9.0f,  // radius, half of another 18 inch robot
+	48.0f, // maxRange
+	2.0f,  // confirm
+};
+
+art::Odometry Odom(ForwardTracker, SidewaysTracker, Imu, OdomConfig, FusionSettings);
+
+/**
+ * @brief Gains of the drive speed loop
+ *
+ * The feedforward is DriveFeedforward, as in DriveConfig. The feedback only
+ * has to make up what the model misses, a volt or two: kP gives 1 V at 10
+ * in/s of error and the integral covers a sustained shortfall within about a
+ * second.
+ */
+const art::PidGains WheelSpeedGains = {
+	0.1f,   // kP, volts per in/s
+	1.0f,   // kI
+	0.0f,   // kD
+	DriveFeedforward::kS, // kS
+	DriveFeedforward::kV, // kV
+	DriveFeedforward::kA, // kA
+	3.0f,   // integralLimit, volts
+	12.0f,  // outputLimit, volts
+};
+
+art::VelocityController DriveVelocity(WheelSpeedGains);
+
+void measureDriveSpeed(float &left, float &right, void *)
+{
+	DeviceSnapshot devices = Devices.read();
+	float sum[2] = {0.0f, 0.0f};
+	int count[2] = {0, 0};
+	for (int i = 0; i < kMotorCount; i++)
+	{
+		int side = Motors.inGroup(i, kLeftDrive) ? 0 : (Motors.inGroup(i, kRightDrive) ? 1 : -1);
+		if (side >= 0)
+		{
+			sum[side] += devices.motorSpeed[i];
+			count[side]++;
+		}
+	}
+	// motor rpm to wheel in/s
+	float scale = DriveConfig.gearRatio * 3.14159265f * DriveConfig.wheelDiameter / 60.0f;
+	left = count[0] ? sum[0] / count[0] * scale : 0.0f;
+	right = count[1] ? sum[1] / count[1] * scale : 0.0f;
+}
+
+void outputDriveVoltage(float left, float right, void *)
+{
+	driveVoltage(left, right);
+}
+
+/**
+ * @brief Timing and gains of the driver assist
+ *
+ * The drivetrain takes about 40 ms to settle on a new voltage. The hold gains
+ * stop a 90 degree per second turn within a few degrees of where the stick was
+ * let go; aiming is a little stiffer, since the driver is waiting on it. The
+ * target is the goal in the far corner, and within a foot of it the heading
+ * is held rather than chasing its bearing.
+ */
+const art::AssistConfig AssistSettings = {
+	0.04f,  // responseLatency
+	0.6f,   // turnDeadband, 5% of the stick
+	12.0f,  // holdKp
+	0.8f,   // holdKd
+	15.0f,  // aimKp
+	1.0f,   // aimKd
+	6.0f,   // maxCorrection
+	0.1f,   // maxLead
+	120.0f, // aimX
+	120.0f, // aimY
+	12.0f,  // aimMinRange
+};
+
+/**
+ * @brief Shortest time between two wall corrections
+ *
+ * Readings close together in time see the same wall with the same error, so
+ * using every sample would make the filter far too sure of itself.
+ */
+static const uint32_t kWallResetMs = 50;
+
+void correctFromWalls(art::PoseFilter &filter, void *)
+{
+	static uint32_t lastSequence = 0;
+	static uint64_t lastResetUs = 0;
+
+	uint64_t now = art::timeUs();
+	if (now - lastResetUs < (uint64_t)kWallResetMs * 1000)
+	{
+		return;
+	}
+	DeviceSnapshot devices = Devices.read();
+	if (devices.sequence == lastSequence)
+	{
+		return;
+	}
+	lastSequence = devices.sequence;
+	lastResetUs = now;
+
+	for (int i = 0; i < kDistanceCount; i++)
+	{
+		if (devices.distance[i] >= 0.0f)
+		{
+			filter.correctRange(RobotLayout::kDistanceMounts[i], devices.distance[i]);
+		}
+	}
+}
+
+art::Seqlock<DeviceSnapshot> Devices;
+
+/**
+ * @brief Working copy filled by sampleDevices before it is published
+ *
+ * It lives between samples, so the filtered fields carry over from one to
+ * the next.
+ */
+static DeviceSnapshot Sample;
+
+static const float kSpeedProcessNoise = 50.0f;      /**< rpm^2 the true speed wanders by per sample */
+static const float kSpeedMeasurementNoise = 400.0f; /**< rpm^2 of noise on a velocity reading */
+static const float kLoadFilter = 0.1f;              /**< weight of the newest current reading */
+
+/**
+ * @brief Uncertainty of each motorSpeed estimate
+ */
+static float SpeedVariance[kMotorCount];
+
+void sampleDevices()
+{
+	PROFILE_SCOPE("sample");
+
+	Sample.timeUs = art::timeUs();
+	Sample.sequence++;
+
+	for (int i = 0; i < kMotorCount; i++)
+	{
+		vex::motor &motor = Motors[i];
+		Sample.motorPosition[i] = motor.position(vex::rotationUnits::deg);
+		Sample.motorVelocity[i] = motor.velocity(vex::velocityUnits::rpm);
+		Sample.motorCurrent[i] = motor.current(vex::currentUnits::amp);
+		Sample.motorVoltage[i] = motor.voltage(vex::voltageUnits::volt);
+		Sample.motorTemperature[i] = motor.temperature(vex::temperatureUnits::celsius);
+	}
+
+	if (Sample.sequence == 1)
+	{
+		// the first reading is the best estimate there is
+		for (int i = 0; i < kMotorCount; i++)
+		{
+			Sample.motorSpeed[i] = Sample.motorVelocity[i];
+			Sample.motorLoad[i] = Sample.motorCurrent[i];
+			SpeedVariance[i] = kSpeedMeasurementNoise;
+		}
+	}
+	art::kernels::kalman(Sample.motorSpeed, SpeedVariance, Sample.motorVelocity, kSpeedProcessNoise,
+						 kSpeedMeasurementNoise, kMotorCount);
+	art::kernels::lowPass(Sample.motorLoad, Sample.motorCurrent, kLoadFilter, kMotorCount);
+
+	Sample.imuRotation = Imu.rotation(vex::rotationUnits::deg);
+	Sample.forwardTracker = ForwardTracker.position(vex::rotationUnits::deg);
+	Sample.sidewaysTracker = SidewaysTracker.position(vex::rotationUnits::deg);
+	for (int i = 0; i < kDistanceCount; i++)
+	{
+		vex::distance &sensor = *DistanceSensors[i];
+		Sample.distance[i] = sensor.isObjectDetected() ? (float)sensor.objectDistance(vex::distanceUnits::in) : -1.0f;
+	}
+
+	Sample.batteryVoltage = Brain.Battery.voltage(vex::voltageUnits::volt);
+	Sample.batteryCurrent = Brain.Battery.current(vex::currentUnits::amp);
+
+	Devices.write(Sample);
+}
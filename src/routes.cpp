@@ -0,0 +1,245 @@
+/**
+ * @file routes.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the RouteBook loader
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Loading is done in two passes over the image. The first only checks it:
+ * sizes, counts, names and action order, without touching anything else. The
+ * second generates the trajectories. Nothing is kept until both have
+ * succeeded, so a bad file costs the arena nothing.
+ */
+
+#include "routes.h"
+
+#include <string.h>
+
+#include "vex.h"
+
+namespace art
+{
+	namespace
+	{
+		const char kMagic[4] = {'A', 'R', 'T', 'R'};
+		const uint16_t kFormatVersion = 1;
+		const uint8_t kReversed = 0x01;
+		const float kPi = 3.14159265f;
+
+		struct FileHeader
+		{
+			char magic[4];
+			uint16_t version;
+			uint16_t routeCount;
+			uint32_t size;
+			uint32_t checksum;
+		};
+
+		struct RouteRecord
+		{
+			char name[16];
+			uint16_t maxVelocity;
+			uint16_t maxAccel;
+			uint8_t waypointCount;
+			uint8_t actionCount;
+			uint8_t flags;
+			uint8_t reserved;
+		};
+
+		struct WaypointRecord
+		{
+			int16_t x;
+			int16_t y;
+			uint16_t heading;
+		};
+
+		static_assert(sizeof(FileHeader) == 16, "FileHeader must match the file format");
+		static_assert(sizeof(RouteRecord) == 24, "RouteRecord must match the file format");
+		static_assert(sizeof(WaypointRecord) == 6, "WaypointRecord must match the file format");
+		static_assert(sizeof(RouteAction) == 8, "RouteAction must match the file format");
+
+		uint32_t fnv1a(const uint8_t *data, size_t size)
+		{
+			uint32_t hash = 2166136261u;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ data[i]) * 16777619u;
+			}
+			return hash;
+		}
+
+		size_t recordSize(const RouteRecord &record)
+		{
+			return sizeof(RouteRecord) + record.waypointCount * sizeof(WaypointRecord) +
+				   record.actionCount * sizeof(RouteAction);
+		}
+
+		/** @brief Checks one route record that starts size - offset bytes from the end */
+		bool checkRoute(const uint8_t *image, size_t offset, size_t size)
+		{
+			if (size - offset < sizeof(RouteRecord))
+			{
+				return false;
+			}
+			const RouteRecord &record = *reinterpret_cast<const RouteRecord *>(image + offset);
+			if (!memchr(record.name, 0, sizeof(record.name)) || record.waypointCount < 2 ||
+				record.waypointCount > RouteBook::kMaxWaypoints || size - offset < recordSize(record))
+			{
+				return false;
+			}
+			const RouteAction *actions = reinterpret_cast<const RouteAction *>(
+				image + offset + sizeof(RouteRecord) + record.waypointCount * sizeof(WaypointRecord));
+			for (size_t i = 1; i < record.actionCount; i++)
+			{
+				if (actions[i].at < actions[i - 1].at)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		RouteError checkImage(const uint8_t *image, size_t size)
+		{
+			if (size < sizeof(FileHeader))
+			{
+				return kRouteBadHeader;
+			}
+			const FileHeader &header = *reinterpret_cast<const FileHeader *>(image);
+			if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+				header.version != kFormatVersion || header.size != size || header.routeCount == 0 ||
+				header.routeCount > RouteBook::kMaxRoutes)
+			{
+				return kRouteBadHeader;
+			}
+			if (fnv1a(image + sizeof(FileHeader), size - sizeof(FileHeader)) != header.checksum)
+			{
+				return kRouteBadChecksum;
+			}
+			size_t offset = sizeof(FileHeader);
+			for (size_t i = 0; i < header.routeCount; i++)
+			{
+				if (!checkRoute(image, offset, size))
+				{
+					return kRouteBadRoute;
+				}
+				offset += recordSize(*reinterpret_cast<const RouteRecord *>(image + offset));
+			}
+			return offset == size ? kRouteOk : kRouteBadRoute;
+		}
+
+		Waypoint decode(const WaypointRecord &record)
+		{
+			Waypoint waypoint = {
+				record.x * (1.0f / 64.0f),
+				record.y * (1.0f / 64.0f),
+				(int16_t)record.heading * (kPi / 32768.0f),
+			};
+			return waypoint;
+		}
+	} // namespace
+
+	const char *routeErrorText(RouteError error)
+	{
+		switch (error)
+		{
+		case kRouteOk:
+			return "ok";
+		case kRouteNoCard:
+			return "no sd card";
+		case kRouteNoFile:
+			return "no route file";
+		case kRouteTooLarge:
+			return "route file too large";
+		case kRouteNoMemory:
+			return "out of arena for routes";
+		case kRouteBadHeader:
+			return "bad route file header";
+		case kRouteBadChecksum:
+			return "route file checksum mismatch";
+		case kRouteBadRoute:
+			return "bad route record";
+		}
+		return "unknown route error";
+	}
+
+	RouteBook::RouteBook() : m_count(0) {}
+
+	RouteError RouteBook::load(const char *fileName, const TrajectoryConstraints &constraints, Arena &arena)
+	{
+		m_count = 0;
+		if (!Brain.SDcard.isInserted())
+		{
+			return kRouteNoCard;
+		}
+		int32_t fileSize = Brain.SDcard.size(fileName);
+		if (fileSize <= 0)
+		{
+			return kRouteNoFile;
+		}
+		if ((size_t)fileSize > kMaxFileBytes)
+		{
+			return kRouteTooLarge;
+		}
+
+		size_t mark = arena.mark();
+		uint8_t *image = static_cast<uint8_t *>(arena.allocate((size_t)fileSize, alignof(FileHeader)));
+		if (!image)
+		{
+			return kRouteNoMemory;
+		}
+		size_t size = (size_t)Brain.SDcard.loadfile(fileName, image, fileSize);
+		RouteError error = size == (size_t)fileSize ? checkImage(image, size) : kRouteNoFile;
+		if (error != kRouteOk)
+		{
+			arena.rewind(mark);
+			return error;
+		}
+
+		const FileHeader &header = *reinterpret_cast<const FileHeader *>(image);
+		size_t offset = sizeof(FileHeader);
+		for (size_t i = 0; i < header.routeCount; i++)
+		{
+			const RouteRecord &record = *reinterpret_cast<const RouteRecord *>(image + offset);
+			const WaypointRecord *points =
+				reinterpret_cast<const WaypointRecord *>(image + offset + sizeof(RouteRecord));
+
+			Waypoint waypoints[kMaxWaypoints];
+			for (size_t j = 0; j < record.waypointCount; j++)
+			{
+				waypoints[j] = decode(points[j]);
+			}
+
+			TrajectoryConstraints limits = constraints;
+			if (record.maxVelocity)
+			{
+				limits.maxVelocity = record.maxVelocity * (1.0f / 16.0f);
+			}
+			if (record.maxAccel)
+			{
+				limits.maxAcceleration = record.maxAccel * (1.0f / 16.0f);
+			}
+			limits.reversed = (record.flags & kReversed) != 0;
+
+			Route &route = m_routes[i];
+			route.name = record.name;
+			route.start.x = waypoints[0].x;
+			route.start.y = waypoints[0].y;
+			route.start.theta = waypoints[0].theta;
+			route.trajectory = Trajectory::generate(waypoints, record.waypointCount, limits, arena);
+			route.path = route.trajectory.valid() ? Path::fromTrajectory(route.trajectory, 1.0f, arena) : Path();
+			route.actions = reinterpret_cast<const RouteAction *>(points + record.waypointCount);
+			route.actionCount = record.actionCount;
+			if (!route.path.valid())
+			{
+				arena.rewind(mark);
+				return kRouteNoMemory;
+			}
+			offset += recordSize(record);
+		}
+		m_count = header.routeCount;
+		return kRouteOk;
+	}
+} // namespace art
@@ -0,0 +1,62 @@
+/**
+ * @file routine.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining Routine
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "routine.h"
+
+#include "scheduler.h"
+
+namespace art
+{
+	Routine::Routine() : m_resume(0), m_wakeUs(0), m_child(NULL), m_timedOut(false), m_failed(false) {}
+
+	void Routine::start()
+	{
+		m_resume = 0;
+		m_child = NULL;
+		m_timedOut = false;
+		m_failed = false;
+	}
+
+	bool Routine::update()
+	{
+		return run();
+	}
+
+	void Routine::end(bool interrupted)
+	{
+		if (m_child)
+		{
+			m_child->end(true);
+			m_child = NULL;
+		}
+		stop(interrupted);
+	}
+
+	bool Routine::await(Command &child)
+	{
+		if (m_child != &child)
+		{
+			m_child = &child;
+			child.start();
+		}
+		if (!child.update())
+		{
+			return false;
+		}
+		m_child = NULL;
+		child.end(false);
+		return true;
+	}
+
+	uint64_t Routine::deadline(uint32_t timeoutMs)
+	{
+		return timeoutMs == kForever ? UINT64_MAX : timeUs() + (uint64_t)timeoutMs * 1000;
+	}
+} // namespace art
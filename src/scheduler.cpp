@@ -0,0 +1,207 @@
+/**
+ * @file scheduler.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the fixed-rate Scheduler
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The scheduler keeps one absolute release time per job. After a job runs its
+ * release is advanced by exactly one period, so time spent inside the job never
+ * pushes later releases back. If a job falls a whole period behind, the missed
+ * releases are dropped rather than run back to back, which would only make the
+ * backlog worse.
+ */
+
+#include "scheduler.h"
+
+#include "vex.h"
+
+namespace art
+{
+	uint64_t timeUs()
+	{
+		return vex::timer::systemHighResolution();
+	}
+
+	void sleepUntil(uint64_t deadlineUs)
+	{
+		uint64_t now = timeUs();
+		if (deadlineUs <= now)
+		{
+			return;
+		}
+		uint32_t remainingMs = (uint32_t)((deadlineUs - now + 999) / 1000);
+		vex::task::sleep(remainingMs);
+	}
+
+	Scheduler::Scheduler() : m_count(0), m_loops(0), m_worstLoopUs(0)
+	{
+	}
+
+	int Scheduler::add(const char *name, uint32_t periodMs, PeriodicFn fn, void *context)
+	{
+		if (m_count >= kMaxTasks || periodMs == 0 || fn == NULL)
+		{
+			return -1;
+		}
+
+		Entry &entry = m_tasks[m_count];
+		entry.name = name;
+		entry.basePeriodUs = periodMs * 1000;
+		entry.periodUs = entry.basePeriodUs;
+		entry.releaseUs = timeUs();
+		entry.fn = fn;
+		entry.context = context;
+		entry.stats = TaskStats();
+		return m_count++;
+	}
+
+	void Scheduler::start()
+	{
+		uint64_t now = timeUs();
+		for (int i = 0; i < m_count; i++)
+		{
+			m_tasks[i].releaseUs = now;
+		}
+	}
+
+	void Scheduler::runOnce()
+	{
+		if (m_count == 0)
+		{
+			vex::task::sleep(10);
+			return;
+		}
+
+		uint64_t next = m_tasks[0].releaseUs;
+		for (int i = 1; i < m_count; i++)
+		{
+			if (m_tasks[i].releaseUs < next)
+			{
+				next = m_tasks[i].releaseUs;
+			}
+		}
+		sleepUntil(next);
+
+		uint64_t loopStart = timeUs();
+		bool ran = false;
+		for (int i = 0; i < m_count; i++)
+		{
+			Entry &entry = m_tasks[i];
+			uint64_t start = timeUs();
+			if (start < entry.releaseUs)
+			{
+				continue;
+			}
+
+			uint64_t late = start - entry.releaseUs;
+			if (late > entry.stats.worstLatencyUs)
+			{
+				entry.stats.worstLatencyUs = (uint32_t)late;
+			}
+
+			entry.fn(entry.context);
+			ran = true;
+
+			uint32_t exec = (uint32_t)(timeUs() - start);
+			entry.stats.runs++;
+			entry.stats.lastExecUs = exec;
+			if (exec > entry.stats.worstExecUs)
+			{
+				entry.stats.worstExecUs = exec;
+			}
+
+			// drop whole periods we fell behind on instead of bursting to catch up
+			uint32_t missed = (uint32_t)(late / entry.periodUs);
+			if (missed > 0)
+			{
+				entry.stats.overruns++;
+				entry.stats.skipped += missed;
+			}
+			entry.releaseUs += (uint64_t)(missed + 1) * entry.periodUs;
+		}
+
+		if (ran)
+		{
+			m_watch.checkIn();
+			m_loops++;
+			uint32_t loopUs = (uint32_t)(timeUs() - loopStart);
+			if (loopUs > m_worstLoopUs)
+			{
+				m_worstLoopUs = loopUs;
+			}
+		}
+	}
+
+	void Scheduler::run()
+	{
+		start();
+		while (true)
+		{
+			runOnce();
+		}
+	}
+
+	bool Scheduler::watch(Watchdog &watchdog, const char *name, uint32_t timeoutMs, bool critical)
+	{
+		if (m_count == 0 || m_watch.attached())
+		{
+			return false;
+		}
+		uint32_t fastestUs = m_tasks[0].basePeriodUs;
+		for (int i = 1; i < m_count; i++)
+		{
+			if (m_tasks[i].basePeriodUs < fastestUs)
+			{
+				fastestUs = m_tasks[i].basePeriodUs;
+			}
+		}
+		return m_watch.attach(watchdog, name, fastestUs / 1000, timeoutMs, critical);
+	}
+
+	void Scheduler::setSlowdown(int handle, uint32_t factor)
+	{
+		if (handle >= 0 && handle < m_count && factor > 0)
+		{
+			m_tasks[handle].periodUs = m_tasks[handle].basePeriodUs * factor;
+		}
+	}
+
+	void Scheduler::resetStats()
+	{
+		for (int i = 0; i < m_count; i++)
+		{
+			m_tasks[i].stats = TaskStats();
+		}
+		m_loops = 0;
+		m_worstLoopUs = 0;
+	}
+
+	const char *Scheduler::name(int handle) const
+	{
+		return (handle >= 0 && handle < m_count) ? m_tasks[handle].name : "";
+	}
+
+	uint32_t Scheduler::periodUs(int handle) const
+	{
+		return (handle >= 0 && handle < m_count) ? m_tasks[handle].periodUs : 0;
+	}
+
+	const TaskStats &Scheduler::stats(int handle) const
+	{
+		static const TaskStats kEmpty = TaskStats();
+		return (handle >= 0 && handle < m_count) ? m_tasks[handle].stats : kEmpty;
+	}
+
+	uint32_t Scheduler::overruns() const
+	{
+		uint32_t total = 0;
+		for (int i = 0; i < m_count; i++)
+		{
+			total += m_tasks[i].stats.overruns;
+		}
+		return total;
+	}
+} // namespace art
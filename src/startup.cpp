@@ -0,0 +1,115 @@
+/**
+ * @file startup.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining Startup
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Every stage's task starts straight away and polls, once a millisecond,
+ * until the stages it depends on have finished. Waiting tasks sleep between
+ * polls, so a stage that is blocked costs next to nothing, and one whose
+ * dependencies finish starts within a millisecond.
+ */
+
+#include "startup.h"
+
+namespace art
+{
+	namespace
+	{
+		struct Finished
+		{
+			const Startup *startup;
+			StageSet stages;
+			bool operator()() const { return startup->finished(stages); }
+		};
+	} // namespace
+
+	Startup::Startup() : m_count(0), m_started(false), m_startUs(0)
+	{
+		for (int i = 0; i < kMaxStages; i++)
+		{
+			m_stages[i].state.store(kStagePending, std::memory_order_relaxed);
+		}
+	}
+
+	StageSet Startup::add(const char *name, StageFn fn, void *context, StageSet after)
+	{
+		if (m_started || m_count >= kMaxStages || !fn || (after & ~all()))
+		{
+			return 0;
+		}
+		Stage &stage = m_stages[m_count];
+		stage.name = name;
+		stage.fn = fn;
+		stage.context = context;
+		stage.after = after;
+		stage.owner = this;
+		stage.startedUs = 0;
+		stage.finishedUs = 0;
+		return (StageSet)1 << m_count++;
+	}
+
+	void Startup::start()
+	{
+		if (m_started)
+		{
+			return;
+		}
+		m_started = true;
+		m_startUs = timeUs();
+
+		for (int i = 0; i < m_count; i++)
+		{
+			m_tasks[i] = vex::task(taskEntry, &m_stages[i], vex::task::taskPriorityNormal);
+		}
+	}
+
+	bool Startup::finished(StageSet stages) const
+	{
+		for (int i = 0; i < m_count; i++)
+		{
+			if ((stages & ((StageSet)1 << i)) && state(i) < kStageDone)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Startup::succeeded(StageSet stages) const
+	{
+		for (int i = 0; i < m_count; i++)
+		{
+			if ((stages & ((StageSet)1 << i)) && state(i) != kStageDone)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	WaitResult Startup::waitFor(StageSet stages, uint32_t timeoutMs)
+	{
+		Finished condition = {this, stages};
+		return waitUntil(condition, timeoutMs, 1);
+	}
+
+	int Startup::taskEntry(void *arg)
+	{
+		Stage &stage = *static_cast<Stage *>(arg);
+		Startup &owner = *stage.owner;
+
+		Finished condition = {&owner, stage.after};
+		waitUntil(condition, kForever, 1);
+
+		stage.startedUs = (uint32_t)(timeUs() - owner.m_startUs);
+		stage.state.store(kStageRunning, std::memory_order_release);
+		bool ok = stage.fn(stage.context);
+		stage.finishedUs = (uint32_t)(timeUs() - owner.m_startUs);
+		stage.state.store(ok ? kStageDone : kStageFailed, std::memory_order_release);
+		return 0;
+	}
+} // namespace art
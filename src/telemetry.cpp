@@ -0,0 +1,378 @@
+/**
+ * @file telemetry.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Telemetry recorder and the program-wide MatchLog
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Producers only ever touch the active buffer, and only while holding the
+ * lock, which they take with try_lock so a busy lock costs a dropped frame
+ * rather than a stalled control loop. The flush task owns the other buffer
+ * outright once it has been swapped out, so the slow SD card write happens
+ * without the lock held.
+ */
+
+#include "telemetry.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "scheduler.h"
+
+namespace art
+{
+	namespace
+	{
+		const uint8_t kSync = 0xA5;
+		const size_t kHeaderSize = 8;
+		const uint16_t kFormatVersion = 1;
+		const float kPi = 3.14159265f;
+
+		static_assert(sizeof(PoseRecord) == 12, "PoseRecord must match the file format");
+		static_assert(sizeof(MotorRecord) == 12, "MotorRecord must match the file format");
+		static_assert(sizeof(ControllerRecord) == 6, "ControllerRecord must match the file format");
+		static_assert(sizeof(SensorRecord) == 28, "SensorRecord must match the file format");
+		static_assert(sizeof(PhaseRecord) == 20, "PhaseRecord must match the file format");
+
+		struct WatchRecord
+		{
+			char name[12];
+			uint8_t type;
+			uint8_t level;
+			uint16_t count;
+			uint32_t gapUs;
+		};
+
+		static_assert(sizeof(WatchRecord) == 20, "WatchRecord must match the file format");
+
+		int16_t clamp16(float value)
+		{
+			if (value >= 32767.0f)
+			{
+				return 32767;
+			}
+			if (value <= -32768.0f)
+			{
+				return -32768;
+			}
+			return (int16_t)lroundf(value);
+		}
+
+		int32_t clamp32(float value)
+		{
+			if (value >= 2147483520.0f)
+			{
+				return 2147483520;
+			}
+			if (value <= -2147483520.0f)
+			{
+				return -2147483520;
+			}
+			return (int32_t)lroundf(value);
+		}
+
+		/**
+		 * @brief Lays out a complete frame
+		 *
+		 * @return bytes written to out, kHeaderSize + length
+		 */
+		size_t encodeFrame(uint8_t *out, uint8_t type, const void *payload, size_t length, uint32_t timeMs)
+		{
+			const uint8_t *bytes = static_cast<const uint8_t *>(payload);
+			uint8_t checksum = (uint8_t)(type + length);
+			for (size_t i = 0; i < length; i++)
+			{
+				checksum = (uint8_t)(checksum + bytes[i]);
+			}
+
+			out[0] = kSync;
+			out[1] = type;
+			out[2] = (uint8_t)length;
+			out[3] = checksum;
+			out[4] = (uint8_t)timeMs;
+			out[5] = (uint8_t)(timeMs >> 8);
+			out[6] = (uint8_t)(timeMs >> 16);
+			out[7] = (uint8_t)(timeMs >> 24);
+			memcpy(out + kHeaderSize, payload, length);
+			return kHeaderSize + length;
+		}
+
+		uint32_t nowMs()
+		{
+			return (uint32_t)(timeUs() / 1000);
+		}
+	} // namespace
+
+	Telemetry MatchLog;
+
+	PoseRecord PoseRecord::encode(const OdometryState &state)
+	{
+		PoseRecord record;
+		record.x = clamp16(state.pose.x * 64.0f);
+		record.y = clamp16(state.pose.y * 64.0f);
+		record.heading = (uint16_t)(int32_t)lroundf(wrapAngle(state.pose.theta) * (32768.0f / kPi));
+		record.vx = clamp16(state.velocity.x * 128.0f);
+		record.vy = clamp16(state.velocity.y * 128.0f);
+		record.angularVelocity = clamp16(state.velocity.theta * 2048.0f);
+		return record;
+	}
+
+	MotorRecord MotorRecord::encode(uint8_t index, float position, float velocity, float current,
+									float voltage, float temperature)
+	{
+		MotorRecord record;
+		record.index = index;
+		record.temperature = temperature <= 0.0f ? 0 : (temperature >= 255.0f ? 255 : (uint8_t)lroundf(temperature));
+		record.velocity = clamp16(velocity * 8.0f);
+		record.current = clamp16(current * 1000.0f);
+		record.voltage = clamp16(voltage * 1000.0f);
+		record.position = clamp32(position * 16.0f);
+		return record;
+	}
+
+	SensorRecord SensorRecord::encode(float forward, float sideways, float rotation, const float *distance,
+									  size_t distanceCount, float batteryVoltage, float batteryCurrent)
+	{
+		SensorRecord record;
+		memset(&record, 0, sizeof(record));
+		record.forward = clamp32(forward * 256.0f);
+		record.sideways = clamp32(sideways * 256.0f);
+		record.rotation = clamp32(rotation * 256.0f);
+		for (size_t i = 0; i < 4; i++)
+		{
+			record.distance[i] = i < distanceCount && distance[i] >= 0.0f ? clamp16(distance[i] * 64.0f) : -1;
+		}
+		float millivolts = batteryVoltage * 1000.0f;
+		record.batteryVoltage = millivolts <= 0.0f ? 0 : (millivolts >= 65535.0f ? 65535 : (uint16_t)lroundf(millivolts));
+		record.batteryCurrent = clamp16(batteryCurrent * 1000.0f);
+		return record;
+	}
+
+	TelemetryReader::TelemetryReader(const uint8_t *data, size_t size)
+		: m_data(data), m_size(size), m_offset(0), m_skipped(0)
+	{
+	}
+
+	bool TelemetryReader::next(TelemetryFrame &frame)
+	{
+		while (m_offset + kHeaderSize <= m_size)
+		{
+			const uint8_t *header = m_data + m_offset;
+			size_t length = header[2];
+			if (header[0] == kSync && m_offset + kHeaderSize + length <= m_size)
+			{
+				uint8_t checksum = (uint8_t)(header[1] + length);
+				for (size_t i = 0; i < length; i++)
+				{
+					checksum = (uint8_t)(checksum + header[kHeaderSize + i]);
+				}
+				if (checksum == header[3])
+				{
+					frame.type = header[1];
+					frame.length = (uint8_t)length;
+					frame.timeMs = (uint32_t)header[4] | (uint32_t)header[5] << 8 | (uint32_t)header[6] << 16 |
+								   (uint32_t)header[7] << 24;
+					frame.payload = header + kHeaderSize;
+					m_offset += kHeaderSize + length;
+					return true;
+				}
+			}
+			m_offset++;
+			m_skipped++;
+		}
+		return false;
+	}
+
+	Telemetry::Telemetry()
+		: m_active(0), m_recording(false), m_frames(0), m_dropped(0), m_bytesWritten(0), m_writeErrors(0)
+	{
+		m_fill[0] = 0;
+		m_fill[1] = 0;
+		m_fileName[0] = '\0';
+	}
+
+	bool Telemetry::begin(const char *prefix)
+	{
+		if (m_recording || !Brain.SDcard.isInserted())
+		{
+			return false;
+		}
+
+		bool named = false;
+		for (int i = 0; i < 1000 && !named; i++)
+		{
+			snprintf(m_fileName, sizeof(m_fileName), "%s%03d.bin", prefix, i);
+			named = !Brain.SDcard.exists(m_fileName);
+		}
+		if (!named)
+		{
+			m_fileName[0] = '\0';
+			return false;
+		}
+
+		// the header is written straight away, which also claims the file name
+		uint8_t header[8] = {'A', 'R', 'T', 'L', (uint8_t)kFormatVersion, (uint8_t)(kFormatVersion >> 8), 0, 0};
+		uint8_t frame[kHeaderSize + sizeof(header)];
+		size_t size = encodeFrame(frame, kTelemetryHeader, header, sizeof(header), nowMs());
+		if (Brain.SDcard.savefile(m_fileName, frame, (int32_t)size) != (int32_t)size)
+		{
+			m_fileName[0] = '\0';
+			return false;
+		}
+		m_bytesWritten += size;
+
+		m_recording = true;
+		m_task = vex::task(taskEntry, this, vex::task::taskPrioritylow);
+		return true;
+	}
+
+	bool Telemetry::write(uint8_t type, const void *payload, size_t length)
+	{
+		if (!m_recording || length > kMaxPayload)
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		uint8_t frame[kHeaderSize + kMaxPayload];
+		size_t size = encodeFrame(frame, type, payload, length, nowMs());
+
+		if (!m_lock.try_lock())
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		if (m_fill[m_active] + size > ART_TELEMETRY_BUFFER)
+		{
+			if (m_fill[1 - m_active] != 0)
+			{
+				// the flush task has not caught up yet
+				m_lock.unlock();
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			m_active = 1 - m_active;
+		}
+
+		memcpy(m_buffers[m_active] + m_fill[m_active], frame, size);
+		m_fill[m_active] += size;
+		m_frames++;
+		m_lock.unlock();
+		return true;
+	}
+
+	bool Telemetry::logPose(const OdometryState &state)
+	{
+		PoseRecord record = PoseRecord::encode(state);
+		return write(kTelemetryPose, &record, sizeof(record));
+	}
+
+	bool Telemetry::logMotors(const MotorRecord *records, size_t count)
+	{
+		return write(kTelemetryMotors, records, count * sizeof(MotorRecord));
+	}
+
+	bool Telemetry::logController(const ControllerRecord &record)
+	{
+		return write(kTelemetryController, &record, sizeof(record));
+	}
+
+	bool Telemetry::logSensors(const SensorRecord &record)
+	{
+		return write(kTelemetrySensors, &record, sizeof(record));
+	}
+
+	bool Telemetry::logPhase(uint8_t phase, const char *routine)
+	{
+		PhaseRecord record;
+		memset(&record, 0, sizeof(record));
+		record.phase = phase;
+		if (routine)
+		{
+			strncpy(record.routine, routine, sizeof(record.routine) - 1);
+		}
+		return write(kTelemetryPhase, &record, sizeof(record));
+	}
+
+	bool Telemetry::logWatch(const WatchEvent &event)
+	{
+		WatchRecord record;
+		memset(&record, 0, sizeof(record));
+		size_t length = strlen(event.name);
+		memcpy(record.name, event.name, length < sizeof(record.name) ? length : sizeof(record.name));
+		record.type = event.type;
+		record.level = event.level;
+		record.count = event.count;
+		record.gapUs = event.gapUs;
+		return write(kTelemetryWatchdog, &record, sizeof(record));
+	}
+
+	bool Telemetry::watch(Watchdog &watchdog)
+	{
+		// an SD card append can stall for a good part of a second
+		return m_watch.attach(watchdog, "log flush", kFlushPeriodMs, 2000, false);
+	}
+
+	bool Telemetry::logText(const char *text)
+	{
+		size_t length = strlen(text);
+		return write(kTelemetryText, text, length < kMaxPayload ? length : kMaxPayload);
+	}
+
+	int Telemetry::taskEntry(void *self)
+	{
+		static_cast<Telemetry *>(self)->flushLoop();
+		return 0;
+	}
+
+	void Telemetry::flushLoop()
+	{
+		uint32_t lastFlushMs = nowMs();
+		while (true)
+		{
+			vex::task::sleep(kFlushPeriodMs);
+			m_watch.checkIn();
+
+			// pick a buffer to write: a full one if there is one, otherwise
+			// the active one once it has waited long enough
+			int ready = -1;
+			m_lock.lock();
+			if (m_fill[1 - m_active] != 0)
+			{
+				ready = 1 - m_active;
+			}
+			else if (m_fill[m_active] != 0 && nowMs() - lastFlushMs >= kMaxLatencyMs)
+			{
+				ready = m_active;
+				m_active = 1 - m_active;
+			}
+			m_lock.unlock();
+
+			if (ready < 0)
+			{
+				continue;
+			}
+
+			PROFILE_SCOPE("sd write");
+			int32_t size = (int32_t)m_fill[ready];
+			if (Brain.SDcard.appendfile(m_fileName, m_buffers[ready], size) == size)
+			{
+				m_bytesWritten += size;
+			}
+			else
+			{
+				m_writeErrors++;
+			}
+			lastFlushMs = nowMs();
+
+			m_lock.lock();
+			m_fill[ready] = 0;
+			m_lock.unlock();
+		}
+	}
+} // namespace art
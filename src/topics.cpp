@@ -0,0 +1,19 @@
+/**
+ * @file topics.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the robot's message bus topics
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "topics.h"
+
+art::LatestTopic<art::OdometryState, kPoseReaders> PoseTopic;
+art::LatestTopic<RobotStatus, kStatusReaders> StatusTopic;
+
+void publishPose(const art::OdometryState &state, void *)
+{
+	PoseTopic.publish(state);
+}
@@ -0,0 +1,485 @@
+/**
+ * @file trajectory.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Profile and Trajectory generators and lookups
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Both generators share the same timing step. Given a list of points along
+ * the motion with a speed limit at each, a forward pass limits how quickly
+ * the robot can speed up and a backward pass limits how late it can slow
+ * down, which gives a trapezoidal profile that also slows for tight turns.
+ * That profile is sampled every 10 ms. For an S-curve, the sampled velocity
+ * is run through a moving average as wide as the time it takes to reach full
+ * acceleration at the jerk limit: averaging a trapezoid's velocity that way
+ * turns each corner of its acceleration into a ramp with exactly that jerk,
+ * while still covering the same distance.
+ */
+
+#include "trajectory.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace art
+{
+	namespace
+	{
+		const float kPi = 3.14159265f;
+		const float kTwoPi = 2.0f * kPi;
+		const float kPathStep = 0.5f;        /**< spacing of spline samples, inches */
+		const size_t kProfilePoints = 256;   /**< points used to time a Profile */
+		const float kDt = Profile::kSamplePeriodMs / 1000.0f;
+
+		const float kPositionScale = 64.0f;
+		const float kHeadingScale = 65536.0f / kTwoPi;
+		const float kVelocityScale = 128.0f;
+		const float kAngularScale = 2048.0f;
+		const float kAccelerationScale = 64.0f;
+		const float kQ16 = 65536.0f;
+
+		/**
+		 * @brief One point along the spline, before timing
+		 */
+		struct PathPoint
+		{
+			float x;
+			float y;
+			float theta;
+			float curvature;
+		};
+
+		/**
+		 * @brief Result of turning a velocity-limited path into timed samples
+		 */
+		struct Timing
+		{
+			float *position;
+			float *velocity;
+			uint32_t count;
+		};
+
+		int16_t toFixed16(float value, float scale)
+		{
+			float scaled = value * scale;
+			if (scaled > 32767.0f)
+			{
+				return 32767;
+			}
+			if (scaled < -32768.0f)
+			{
+				return -32768;
+			}
+			return (int16_t)lroundf(scaled);
+		}
+
+		int32_t toQ16(float value)
+		{
+			return (int32_t)lroundf(value * kQ16);
+		}
+
+		/**
+		 * @brief Plans velocity along a path and samples it every kDt
+		 *
+		 * @param s distance of each point from the start, increasing
+		 * @param v speed limit at each point on entry, planned speed on exit
+		 * @param n number of points, at least two
+		 * @param start speed at the first point, 0 to start at rest
+		 * @param end speed at the last point, 0 to stop there
+		 */
+		bool parametrize(const float *s, float *v, size_t n, float accel, float jerk, float start, float end,
+						 Arena &arena, Timing &out)
+		{
+			// forward pass: how fast can we be going if we accelerate flat out
+			v[0] = fminf(start, v[0]);
+			for (size_t i = 1; i < n; i++)
+			{
+				float reachable = sqrtf(v[i - 1] * v[i - 1] + 2.0f * accel * (s[i] - s[i - 1]));
+				v[i] = fminf(v[i], reachable);
+			}
+			// backward pass: how fast can we be going and still slow down in time
+			v[n - 1] = fminf(end, v[n - 1]);
+			for (size_t i = n - 1; i > 0; i--)
+			{
+				float stoppable = sqrtf(v[i] * v[i] + 2.0f * accel * (s[i] - s[i - 1]));
+				v[i - 1] = fminf(v[i - 1], stoppable);
+			}
+
+			// time at which each point is reached
+			float *t = arena.createArray<float>(n);
+			if (!t)
+			{
+				return false;
+			}
+			t[0] = 0.0f;
+			for (size_t i = 1; i < n; i++)
+			{
+				float ds = s[i] - s[i - 1];
+				float sum = v[i] + v[i - 1];
+				t[i] = t[i - 1] + (sum > 1e-4f ? 2.0f * ds / sum : sqrtf(2.0f * ds / accel));
+			}
+
+			uint32_t raw = (uint32_t)ceilf(t[n - 1] / kDt) + 1;
+			uint32_t window = 1;
+			if (jerk > 0.0f)
+			{
+				window = (uint32_t)lroundf(accel / jerk / kDt);
+				window = window < 1 ? 1 : window;
+			}
+			uint32_t count = raw + window - 1;
+
+			float *velocity = arena.createArray<float>(count);
+			float *position = arena.createArray<float>(count);
+			if (!velocity || !position)
+			{
+				return false;
+			}
+
+			// sample the trapezoid; within a segment acceleration is constant
+			size_t segment = 0;
+			for (uint32_t k = 0; k < raw; k++)
+			{
+				float time = k * kDt;
+				while (segment + 2 < n && t[segment + 1] <= time)
+				{
+					segment++;
+				}
+				float span = t[segment + 1] - t[segment];
+				float tau = fminf(fmaxf(time - t[segment], 0.0f), span);
+				float a = span > 0.0f ? (v[segment + 1] - v[segment]) / span : 0.0f;
+				position[k] = v[segment] + a * tau; // stash raw velocity for filtering
+			}
+
+			// moving average over `window` samples turns the trapezoid into an S-curve;
+			// before the first sample and after the last the speed is held at the ends'
+			float first = v[0];
+			float last = v[n - 1];
+			float sum = first * (window - 1);
+			for (uint32_t k = 0; k < count; k++)
+			{
+				sum += k < raw ? position[k] : last;
+				if (k >= window)
+				{
+					sum -= (k - window) < raw ? position[k - window] : last;
+				}
+				else if (k > 0)
+				{
+					sum -= first;
+				}
+				velocity[k] = sum / window;
+			}
+			velocity[count - 1] = last;
+
+			position[0] = 0.0f;
+			for (uint32_t k = 1; k < count; k++)
+			{
+				position[k] = position[k - 1] + (velocity[k] + velocity[k - 1]) * 0.5f * kDt;
+			}
+
+			// remove the small distance error left by sampling
+			float total = s[n - 1];
+			if (position[count - 1] > 1e-6f)
+			{
+				float scale = total / position[count - 1];
+				for (uint32_t k = 0; k < count; k++)
+				{
+					position[k] *= scale;
+					velocity[k] *= scale;
+				}
+			}
+
+			out.position = position;
+			out.velocity = velocity;
+			out.count = count;
+			return true;
+		}
+
+		float acceleration(const Timing &timing, uint32_t k)
+		{
+			uint32_t before = k > 0 ? k - 1 : 0;
+			uint32_t after = k + 1 < timing.count ? k + 1 : k;
+			if (after == before)
+			{
+				return 0.0f;
+			}
+			return (timing.velocity[after] - timing.velocity[before]) / ((after - before) * kDt);
+		}
+
+		/**
+		 * @brief Moves a table generated in scratch space down to the start of it
+		 *
+		 * Scratch memory is taken first because its size decides the table's
+		 * size. Once the table is built, the arena is rewound and the table is
+		 * copied to the front, so only the table stays allocated.
+		 */
+		template <typename T>
+		const T *compact(Arena &arena, size_t mark, const T *table, uint32_t count)
+		{
+			arena.rewind(mark);
+			T *kept = static_cast<T *>(arena.allocate(sizeof(T) * count, alignof(T)));
+			memmove(kept, table, sizeof(T) * count);
+			return kept;
+		}
+	} // namespace
+
+	Profile::Profile() : m_samples(NULL), m_count(0)
+	{
+	}
+
+	Profile Profile::generate(float distance, const ProfileConstraints &constraints, Arena &arena)
+	{
+		Profile profile;
+		size_t mark = arena.mark();
+		float magnitude = fabsf(distance);
+		float direction = distance < 0.0f ? -1.0f : 1.0f;
+
+		float *s = arena.createArray<float>(kProfilePoints);
+		float *v = arena.createArray<float>(kProfilePoints);
+		Timing timing;
+		if (!s || !v)
+		{
+			arena.rewind(mark);
+			return profile;
+		}
+		for (size_t i = 0; i < kProfilePoints; i++)
+		{
+			s[i] = magnitude * i / (kProfilePoints - 1);
+			v[i] = constraints.maxVelocity;
+		}
+		if (!parametrize(s, v, kProfilePoints, constraints.maxAcceleration, constraints.maxJerk, 0.0f, 0.0f, arena,
+						 timing))
+		{
+			arena.rewind(mark);
+			return profile;
+		}
+
+		ProfileSample *table = arena.createArray<ProfileSample>(timing.count);
+		if (!table)
+		{
+			arena.rewind(mark);
+			return profile;
+		}
+		for (uint32_t k = 0; k < timing.count; k++)
+		{
+			table[k].position = toQ16(timing.position[k] * direction);
+			table[k].velocity = toQ16(timing.velocity[k] * direction);
+			table[k].acceleration = toQ16(acceleration(timing, k) * direction);
+		}
+
+		profile.m_samples = compact(arena, mark, table, timing.count);
+		profile.m_count = timing.count;
+		return profile;
+	}
+
+	uint32_t Profile::durationMs() const
+	{
+		return m_count > 0 ? (m_count - 1) * kSamplePeriodMs : 0;
+	}
+
+	ProfileState Profile::sample(uint32_t timeMs) const
+	{
+		ProfileState state = {0.0f, 0.0f, 0.0f};
+		if (m_count == 0)
+		{
+			return state;
+		}
+
+		uint32_t index = timeMs / kSamplePeriodMs;
+		if (index >= m_count - 1)
+		{
+			state.position = m_samples[m_count - 1].position / kQ16;
+			return state;
+		}
+		float frac = (float)(timeMs % kSamplePeriodMs) / kSamplePeriodMs;
+		const ProfileSample &a = m_samples[index];
+		const ProfileSample &b = m_samples[index + 1];
+		state.position = (a.position + (b.position - a.position) * frac) / kQ16;
+		state.velocity = (a.velocity + (b.velocity - a.velocity) * frac) / kQ16;
+		state.acceleration = (a.acceleration + (b.acceleration - a.acceleration) * frac) / kQ16;
+		return state;
+	}
+
+	Trajectory::Trajectory() : m_samples(NULL), m_count(0), m_length(0.0f)
+	{
+	}
+
+	Trajectory Trajectory::generate(const Waypoint *waypoints, size_t count,
+									const TrajectoryConstraints &constraints, Arena &arena, float startVelocity,
+									float endVelocity)
+	{
+		Trajectory trajectory;
+		if (count < 2)
+		{
+			return trajectory;
+		}
+		size_t mark = arena.mark();
+
+		// when driving backwards the path's tangent points out the robot's back
+		float flip = constraints.reversed ? kPi : 0.0f;
+
+		size_t points = 1;
+		for (size_t i = 0; i + 1 < count; i++)
+		{
+			float chord = hypotf(waypoints[i + 1].x - waypoints[i].x, waypoints[i + 1].y - waypoints[i].y);
+			size_t steps = (size_t)ceilf(chord / kPathStep);
+			points += steps < 8 ? 8 : steps;
+		}
+
+		PathPoint *path = arena.createArray<PathPoint>(points);
+		float *s = arena.createArray<float>(points);
+		float *v = arena.createArray<float>(points);
+		if (!path || !s || !v)
+		{
+			arena.rewind(mark);
+			return trajectory;
+		}
+
+		// sample each cubic Hermite segment, tangents scaled to the chord length
+		size_t n = 0;
+		for (size_t i = 0; i + 1 < count; i++)
+		{
+			const Waypoint &p0 = waypoints[i];
+			const Waypoint &p1 = waypoints[i + 1];
+			float chord = hypotf(p1.x - p0.x, p1.y - p0.y);
+			float m0x = chord * cosf(p0.theta + flip);
+			float m0y = chord * sinf(p0.theta + flip);
+			float m1x = chord * cosf(p1.theta + flip);
+			float m1y = chord * sinf(p1.theta + flip);
+			size_t steps = (size_t)ceilf(chord / kPathStep);
+			steps = steps < 8 ? 8 : steps;
+
+			for (size_t j = (i == 0 ? 0 : 1); j <= steps; j++)
+			{
+				float u = (float)j / steps;
+				float u2 = u * u;
+				float u3 = u2 * u;
+				float h00 = 2 * u3 - 3 * u2 + 1, h10 = u3 - 2 * u2 + u;
+				float h01 = -2 * u3 + 3 * u2, h11 = u3 - u2;
+				float d00 = 6 * u2 - 6 * u, d10 = 3 * u2 - 4 * u + 1;
+				float d01 = -6 * u2 + 6 * u, d11 = 3 * u2 - 2 * u;
+				float e00 = 12 * u - 6, e10 = 6 * u - 4;
+				float e01 = -12 * u + 6, e11 = 6 * u - 2;
+
+				float dx = d00 * p0.x + d10 * m0x + d01 * p1.x + d11 * m1x;
+				float dy = d00 * p0.y + d10 * m0y + d01 * p1.y + d11 * m1y;
+				float ddx = e00 * p0.x + e10 * m0x + e01 * p1.x + e11 * m1x;
+				float ddy = e00 * p0.y + e10 * m0y + e01 * p1.y + e11 * m1y;
+				float speed = hypotf(dx, dy);
+
+				PathPoint &point = path[n];
+				point.x = h00 * p0.x + h10 * m0x + h01 * p1.x + h11 * m1x;
+				point.y = h00 * p0.y + h10 * m0y + h01 * p1.y + h11 * m1y;
+				point.theta = speed > 1e-6f ? atan2f(dy, dx) : p0.theta + flip;
+				point.curvature = speed > 1e-6f ? (dx * ddy - dy * ddx) / (speed * speed * speed) : 0.0f;
+				s[n] = n == 0 ? 0.0f : s[n - 1] + hypotf(point.x - path[n - 1].x, point.y - path[n - 1].y);
+				n++;
+			}
+		}
+
+		// slow down so the outside wheel never exceeds the velocity limit
+		for (size_t i = 0; i < n; i++)
+		{
+			float turning = 1.0f + fabsf(path[i].curvature) * constraints.trackWidth * 0.5f;
+			v[i] = constraints.maxVelocity / turning;
+		}
+
+		Timing timing;
+		if (!parametrize(s, v, n, constraints.maxAcceleration, constraints.maxJerk, fabsf(startVelocity),
+						 fabsf(endVelocity), arena, timing))
+		{
+			arena.rewind(mark);
+			return trajectory;
+		}
+
+		TrajectorySample *table = arena.createArray<TrajectorySample>(timing.count);
+		if (!table)
+		{
+			arena.rewind(mark);
+			return trajectory;
+		}
+
+		float sign = constraints.reversed ? -1.0f : 1.0f;
+		size_t segment = 0;
+		for (uint32_t k = 0; k < timing.count; k++)
+		{
+			float distance = timing.position[k];
+			while (segment + 2 < n && s[segment + 1] <= distance)
+			{
+				segment++;
+			}
+			float span = s[segment + 1] - s[segment];
+			float frac = span > 0.0f ? fminf(fmaxf((distance - s[segment]) / span, 0.0f), 1.0f) : 0.0f;
+			const PathPoint &a = path[segment];
+			const PathPoint &b = path[segment + 1];
+
+			float x = a.x + (b.x - a.x) * frac;
+			float y = a.y + (b.y - a.y) * frac;
+			float theta = a.theta + wrapAngle(b.theta - a.theta) * frac - flip;
+			float curvature = a.curvature + (b.curvature - a.curvature) * frac;
+
+			TrajectorySample &sample = table[k];
+			sample.x = toFixed16(x, kPositionScale);
+			sample.y = toFixed16(y, kPositionScale);
+			sample.heading = (uint16_t)(lroundf(wrapAngle(theta) * kHeadingScale) & 0xFFFF);
+			sample.velocity = toFixed16(timing.velocity[k] * sign, kVelocityScale);
+			sample.angularVelocity = toFixed16(timing.velocity[k] * curvature, kAngularScale);
+			sample.acceleration = toFixed16(acceleration(timing, k) * sign, kAccelerationScale);
+		}
+
+		trajectory.m_length = s[n - 1];
+		trajectory.m_samples = compact(arena, mark, table, timing.count);
+		trajectory.m_count = timing.count;
+		return trajectory;
+	}
+
+	uint32_t Trajectory::durationMs() const
+	{
+		return m_count > 0 ? (m_count - 1) * kSamplePeriodMs : 0;
+	}
+
+	TrajectoryState Trajectory::at(uint32_t index) const
+	{
+		TrajectoryState state;
+		const TrajectorySample &sample = m_samples[index < m_count ? index : m_count - 1];
+		state.pose.x = sample.x / kPositionScale;
+		state.pose.y = sample.y / kPositionScale;
+		state.pose.theta = (int16_t)sample.heading / kHeadingScale;
+		state.velocity = sample.velocity / kVelocityScale;
+		state.angularVelocity = sample.angularVelocity / kAngularScale;
+		state.acceleration = sample.acceleration / kAccelerationScale;
+		return state;
+	}
+
+	TrajectoryState Trajectory::sample(uint32_t timeMs) const
+	{
+		TrajectoryState state = TrajectoryState();
+		if (m_count == 0)
+		{
+			return state;
+		}
+
+		uint32_t index = timeMs / kSamplePeriodMs;
+		if (index >= m_count - 1)
+		{
+			// hold the final pose, at rest
+			state.pose = at(m_count - 1).pose;
+			return state;
+		}
+
+		float frac = (float)(timeMs % kSamplePeriodMs) / kSamplePeriodMs;
+		const TrajectorySample &a = m_samples[index];
+		const TrajectorySample &b = m_samples[index + 1];
+		// binary angles wrap for free: the int16 difference is the short way round
+		int16_t turn = (int16_t)(uint16_t)(b.heading - a.heading);
+
+		state.pose.x = (a.x + (b.x - a.x) * frac) / kPositionScale;
+		state.pose.y = (a.y + (b.y - a.y) * frac) / kPositionScale;
+		state.pose.theta = wrapAngle(((int16_t)a.heading + turn * frac) / kHeadingScale);
+		state.velocity = (a.velocity + (b.velocity - a.velocity) * frac) / kVelocityScale;
+		state.angularVelocity = (a.angularVelocity + (b.angularVelocity - a.angularVelocity) * frac) / kAngularScale;
+		state.acceleration = (a.acceleration + (b.acceleration - a.acceleration) * frac) / kAccelerationScale;
+		return state;
+	}
+} // namespace art
@@ -0,0 +1,235 @@
+/**
+ * @file tuneLink.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining TuneLink
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Incoming bytes are collected into one frame buffer until the frame is
+ * complete, so a request split across polls is handled as soon as its last
+ * byte arrives. The answer to a kTuneList can be far larger than the port
+ * buffers, so its entries are sent as space becomes free, a few per poll.
+ */
+
+#include "tuneLink.h"
+
+#include <string.h>
+
+#include "profiler.h"
+#include "vex.h"
+
+namespace art
+{
+	namespace
+	{
+		struct InfoReply
+		{
+			uint8_t index;
+			uint8_t count;
+			uint8_t type;
+			uint8_t group;
+			char name[ParamRegistry::kNameLength];
+			float min;
+			float max;
+			float step;
+		};
+
+		struct ValueReply
+		{
+			uint8_t index;
+			uint8_t pending;
+			uint8_t reserved[2];
+			float value;
+		};
+
+		struct SetRequest
+		{
+			uint8_t index;
+			uint8_t reserved[3];
+			float value;
+		};
+
+		static_assert(sizeof(InfoReply) == 32, "InfoReply must match the protocol");
+		static_assert(sizeof(ValueReply) == 8, "ValueReply must match the protocol");
+		static_assert(sizeof(SetRequest) == 8, "SetRequest must match the protocol");
+
+		uint8_t checksum(uint8_t type, const uint8_t *payload, size_t length)
+		{
+			uint32_t sum = type + length;
+			for (size_t i = 0; i < length; i++)
+			{
+				sum += payload[i];
+			}
+			return (uint8_t)sum;
+		}
+	} // namespace
+
+	TuneLink::TuneLink(ParamRegistry &params)
+		: m_params(params), m_fill(0), m_listNext(ParamRegistry::kMaxParams), m_requests(0), m_badFrames(0),
+		  m_dropped(0)
+	{
+	}
+
+	void TuneLink::poll()
+	{
+		PROFILE_SCOPE("tune link");
+
+		// finish a listing before reading more, so replies stay in order
+		while (m_listNext < m_params.size())
+		{
+			if (!sendInfo(m_listNext))
+			{
+				return;
+			}
+			m_listNext++;
+		}
+
+		for (size_t n = 0; n < kMaxReadBytes; n++)
+		{
+			int32_t c = vexSerialReadChar(kChannel);
+			if (c < 0)
+			{
+				return;
+			}
+			if (m_fill == 0 && c != kSync)
+			{
+				continue;
+			}
+			m_frame[m_fill++] = (uint8_t)c;
+			if (m_fill < kHeaderSize || m_fill < kHeaderSize + m_frame[2])
+			{
+				continue;
+			}
+
+			size_t length = m_frame[2];
+			m_fill = 0;
+			if (checksum(m_frame[1], m_frame + kHeaderSize, length) != m_frame[3])
+			{
+				m_badFrames++;
+				continue;
+			}
+			m_requests++;
+			handle(m_frame[1], m_frame + kHeaderSize, length);
+			if (m_listNext < m_params.size())
+			{
+				return;
+			}
+		}
+	}
+
+	void TuneLink::handle(uint8_t type, const uint8_t *payload, size_t length)
+	{
+		switch (type)
+		{
+		case kTuneList:
+			if (length != 0)
+			{
+				break;
+			}
+			m_listNext = 0;
+			while (m_listNext < m_params.size() && sendInfo(m_listNext))
+			{
+				m_listNext++;
+			}
+			return;
+		case kTuneGet:
+			if (length != 1)
+			{
+				break;
+			}
+			if (payload[0] >= m_params.size())
+			{
+				sendError(type, payload[0], kParamUnknown);
+				return;
+			}
+			sendValue(payload[0]);
+			return;
+		case kTuneSet:
+		{
+			if (length != sizeof(SetRequest))
+			{
+				break;
+			}
+			SetRequest request;
+			memcpy(&request, payload, sizeof(request));
+			ParamResult result = m_params.set(request.index, request.value);
+			if (result != kParamOk)
+			{
+				sendError(type, request.index, (uint8_t)result);
+				return;
+			}
+			sendValue(request.index);
+			return;
+		}
+		case kTuneSave:
+			if (length != 0)
+			{
+				break;
+			}
+			m_params.requestSave();
+			send(kTuneSaved, NULL, 0);
+			return;
+		default:
+			break;
+		}
+		sendError(type, 0, kTuneBadRequest);
+	}
+
+	bool TuneLink::send(uint8_t type, const void *payload, size_t length)
+	{
+		uint8_t frame[kHeaderSize + 255];
+		size_t size = kHeaderSize + length;
+		if (vexSerialWriteFree(kChannel) < (int32_t)size)
+		{
+			return false;
+		}
+		frame[0] = kSync;
+		frame[1] = type;
+		frame[2] = (uint8_t)length;
+		if (length)
+		{
+			memcpy(frame + kHeaderSize, payload, length);
+		}
+		frame[3] = checksum(type, frame + kHeaderSize, length);
+		return vexSerialWriteBuffer(kChannel, frame, (uint32_t)size) == (int32_t)size;
+	}
+
+	bool TuneLink::sendInfo(size_t index)
+	{
+		InfoReply reply;
+		memset(&reply, 0, sizeof(reply));
+		reply.index = (uint8_t)index;
+		reply.count = (uint8_t)m_params.size();
+		reply.type = (uint8_t)m_params.type(index);
+		reply.group = (uint8_t)m_params.group(index);
+		strncpy(reply.name, m_params.name(index), sizeof(reply.name) - 1);
+		reply.min = m_params.min(index);
+		reply.max = m_params.max(index);
+		reply.step = m_params.step(index);
+		return send(kTuneInfo, &reply, sizeof(reply));
+	}
+
+	void TuneLink::sendValue(size_t index)
+	{
+		ValueReply reply;
+		memset(&reply, 0, sizeof(reply));
+		reply.index = (uint8_t)index;
+		reply.pending = m_params.pending(index) ? 1 : 0;
+		reply.value = m_params.value(index);
+		if (!send(kTuneValue, &reply, sizeof(reply)))
+		{
+			m_dropped++;
+		}
+	}
+
+	void TuneLink::sendError(uint8_t request, uint8_t index, uint8_t reason)
+	{
+		uint8_t reply[4] = {request, index, reason, 0};
+		if (!send(kTuneError, reply, sizeof(reply)))
+		{
+			m_dropped++;
+		}
+	}
+} // namespace art
@@ -0,0 +1,152 @@
+/**
+ * @file velocity.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining VelocityController
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The kA term needs the target's acceleration, which the callers do not
+ * track: a path follower only knows the speed it wants now. The controller
+ * takes it as the change between the last two targets over the time between
+ * them being set. The caller's task is not in step with this one, so a
+ * period can see no new target or, now and then, two; dividing by the
+ * caller's own interval instead of kPeriodMs gives the same acceleration
+ * either way, and it is held until the next target arrives. For a profiled
+ * path that is the planned acceleration, a tick late.
+ */
+
+#include "velocity.h"
+
+#include "profiler.h"
+
+namespace art
+{
+	VelocityController::VelocityController(const PidGains &gains)
+		: m_left(gains, kPeriodMs), m_right(gains, kPeriodMs), m_measure(NULL), m_measureContext(NULL),
+		  m_output(NULL), m_outputContext(NULL), m_started(false), m_active(false), m_lastTargetUs(0)
+	{
+		m_pid[0] = &m_left;
+		m_pid[1] = &m_right;
+		for (int i = 0; i < 2; i++)
+		{
+			m_lastSpeed[i] = 0.0f;
+			m_acceleration[i] = 0.0f;
+			m_error[i] = 0.0f;
+		}
+	}
+
+	void VelocityController::setMeasure(MeasureFn measure, void *context)
+	{
+		m_measure = measure;
+		m_measureContext = context;
+	}
+
+	void VelocityController::setOutput(OutputFn output, void *context)
+	{
+		m_output = output;
+		m_outputContext = context;
+	}
+
+	void VelocityController::start()
+	{
+		if (m_started || !m_measure || !m_output)
+		{
+			return;
+		}
+		m_started = true;
+
+		m_loop.add("velocity", kPeriodMs, tick, this);
+		m_task = vex::task(taskEntry, this, vex::task::taskPriorityHigh);
+	}
+
+	void VelocityController::setTarget(float left, float right)
+	{
+		Target target = {{left, right}, true, timeUs()};
+		m_target.publish(target);
+	}
+
+	void VelocityController::stop()
+	{
+		Target target = {{0.0f, 0.0f}, false, timeUs()};
+		m_target.publish(target);
+	}
+
+	void VelocityController::setGains(const PidGains &gains)
+	{
+		m_gains.publish(gains);
+	}
+
+	int VelocityController::taskEntry(void *self)
+	{
+		static_cast<VelocityController *>(self)->m_loop.run();
+		return 0;
+	}
+
+	void VelocityController::tick(void *self)
+	{
+		static_cast<VelocityController *>(self)->update();
+	}
+
+	void VelocityController::update()
+	{
+		PROFILE_SCOPE("velocity");
+
+		if (m_gains.fresh())
+		{
+			const PidGains &gains = m_gains.latest();
+			for (int i = 0; i < 2; i++)
+			{
+				*m_pid[i] = Pid<FixedMath>(gains, kPeriodMs);
+			}
+		}
+
+		const Target &target = m_target.latest();
+		bool active = target.active && timeUs() - target.timeUs <= (uint64_t)kTimeoutMs * 1000;
+		if (!active)
+		{
+			if (m_active)
+			{
+				// whatever was last sent stays on the motors until something replaces it
+				m_output(0.0f, 0.0f, m_outputContext);
+				m_active = false;
+			}
+			return;
+		}
+		if (!m_active)
+		{
+			for (int i = 0; i < 2; i++)
+			{
+				m_pid[i]->reset();
+				m_lastSpeed[i] = target.speed[i];
+				m_acceleration[i] = 0.0f;
+			}
+			m_lastTargetUs = target.timeUs;
+			m_active = true;
+		}
+		if (target.timeUs > m_lastTargetUs)
+		{
+			float interval = (float)(target.timeUs - m_lastTargetUs) * 1e-6f;
+			for (int i = 0; i < 2; i++)
+			{
+				m_acceleration[i] = (target.speed[i] - m_lastSpeed[i]) / interval;
+				m_lastSpeed[i] = target.speed[i];
+			}
+			m_lastTargetUs = target.timeUs;
+		}
+
+		float measured[2];
+		m_measure(measured[0], measured[1], m_measureContext);
+
+		float volts[2];
+		for (int i = 0; i < 2; i++)
+		{
+			m_error[i] = target.speed[i] - measured[i];
+			volts[i] = FixedMath::toFloat(m_pid[i]->update(FixedMath::make(target.speed[i]),
+														   FixedMath::make(measured[i]),
+														   FixedMath::make(m_acceleration[i])));
+		}
+		m_output(volts[0], volts[1], m_outputContext);
+	}
+} // namespace art
@@ -0,0 +1,55 @@
+/**
+ * @file wait.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the timed waits and Signal
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "wait.h"
+
+namespace art
+{
+	namespace
+	{
+		struct TakeSignal
+		{
+			Signal *signal;
+			bool operator()() const { return signal->tryTake(); }
+		};
+	} // namespace
+
+	WaitResult waitFor(uint32_t durationMs)
+	{
+		uint64_t start = timeUs();
+		sleepUntil(start + (uint64_t)durationMs * 1000);
+		WaitResult result = {true, (uint32_t)(timeUs() - start)};
+		return result;
+	}
+
+	void Signal::signal()
+	{
+		m_count.fetch_add(1, std::memory_order_release);
+	}
+
+	bool Signal::tryTake()
+	{
+		uint32_t count = m_count.load(std::memory_order_acquire);
+		while (count > 0)
+		{
+			if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	WaitResult Signal::wait(uint32_t timeoutMs, uint32_t pollMs)
+	{
+		TakeSignal take = {this};
+		return waitUntil(take, timeoutMs, pollMs);
+	}
+} // namespace art
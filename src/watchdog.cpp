@@ -0,0 +1,230 @@
+/**
+ * @file watchdog.cpp
+ * @author Jath Alison (Jath.Alison@gmail.com)
+ * @brief Source defining the Watchdog
+ * @version 0.1
+ * @date 10-14-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * A check-in only stores a time stamp and bumps a couple of counters, so it
+ * costs the watched task next to nothing. Everything else, from deciding a
+ * task is stalled to reporting and changing the degrade level, happens in
+ * poll(). Times are kept as the low 32 bits of the microsecond timer, which
+ * is plenty for gaps of a few seconds as long as they are subtracted
+ * unsigned.
+ */
+
+#include "watchdog.h"
+
+#include "scheduler.h"
+
+namespace art
+{
+	namespace
+	{
+		uint32_t nowUs32()
+		{
+			return (uint32_t)timeUs();
+		}
+	} // namespace
+
+	Watchdog::Watchdog()
+		: m_count(0), m_report(NULL), m_reportContext(NULL), m_degrade(NULL), m_degradeContext(NULL), m_level(0),
+		  m_levelChanges(0), m_levelMs(0), m_troubleMs(0)
+	{
+	}
+
+	int Watchdog::add(const char *name, uint32_t periodMs, uint32_t timeoutMs, bool critical)
+	{
+		if (m_count >= kMaxTasks || periodMs == 0 || timeoutMs < periodMs)
+		{
+			return -1;
+		}
+		Entry &entry = m_tasks[m_count];
+		entry.name = name;
+		entry.periodUs.store(periodMs * 1000, std::memory_order_relaxed);
+		entry.timeoutUs = timeoutMs * 1000;
+		entry.critical = critical;
+		entry.armed.store(false, std::memory_order_relaxed);
+		entry.lastUs.store(0, std::memory_order_relaxed);
+		entry.checkIns.store(0, std::memory_order_relaxed);
+		entry.misses.store(0, std::memory_order_relaxed);
+		entry.windowGapUs.store(0, std::memory_order_relaxed);
+		entry.worstGapUs = 0;
+		entry.reportedMisses = 0;
+		entry.stalls = 0;
+		entry.stalled = false;
+		return m_count++;
+	}
+
+	void Watchdog::checkIn(int handle)
+	{
+		if (handle < 0 || handle >= m_count)
+		{
+			return;
+		}
+		Entry &entry = m_tasks[handle];
+		uint32_t now = nowUs32();
+		if (entry.armed.load(std::memory_order_acquire))
+		{
+			uint32_t gap = now - entry.lastUs.load(std::memory_order_relaxed);
+			if (gap >= 2 * entry.periodUs.load(std::memory_order_relaxed))
+			{
+				entry.misses.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (gap > entry.worstGapUs)
+			{
+				entry.worstGapUs = gap;
+			}
+			if (gap > entry.windowGapUs.load(std::memory_order_relaxed))
+			{
+				entry.windowGapUs.store(gap, std::memory_order_relaxed);
+			}
+		}
+		entry.lastUs.store(now, std::memory_order_relaxed);
+		entry.checkIns.fetch_add(1, std::memory_order_relaxed);
+		entry.armed.store(true, std::memory_order_release);
+	}
+
+	void Watchdog::pause(int handle)
+	{
+		if (handle >= 0 && handle < m_count)
+		{
+			m_tasks[handle].armed.store(false, std::memory_order_release);
+		}
+	}
+
+	void Watchdog::setPeriod(int handle, uint32_t periodMs)
+	{
+		if (handle >= 0 && handle < m_count && periodMs > 0)
+		{
+			m_tasks[handle].periodUs.store(periodMs * 1000, std::memory_order_relaxed);
+		}
+	}
+
+	void Watchdog::poll()
+	{
+		uint32_t now = nowUs32();
+		uint32_t nowMs = (uint32_t)(timeUs() / 1000);
+		bool trouble = false;
+
+		for (int i = 0; i < m_count; i++)
+		{
+			Entry &entry = m_tasks[i];
+			bool armed = entry.armed.load(std::memory_order_acquire);
+			uint32_t gap = now - entry.lastUs.load(std::memory_order_relaxed);
+			uint32_t windowGap = entry.windowGapUs.exchange(0, std::memory_order_relaxed);
+
+			uint32_t misses = entry.misses.load(std::memory_order_relaxed);
+			if (misses != entry.reportedMisses)
+			{
+				report(kWatchLate, entry.name, misses - entry.reportedMisses, windowGap);
+				entry.reportedMisses = misses;
+				trouble = trouble || entry.critical;
+			}
+
+			bool stalled = armed && gap > entry.timeoutUs;
+			if (stalled && !entry.stalled)
+			{
+				entry.stalls++;
+				report(kWatchStalled, entry.name, 0, gap);
+			}
+			else if (!stalled && entry.stalled && armed)
+			{
+				report(kWatchRecovered, entry.name, 0, windowGap);
+			}
+			entry.stalled = stalled;
+			trouble = trouble || (stalled && entry.critical);
+		}
+
+		if (trouble)
+		{
+			m_troubleMs = nowMs;
+			if (m_level < kMaxLevel && (m_level == 0 || nowMs - m_levelMs >= kDegradeHoldMs))
+			{
+				setLevel(m_level + 1, nowMs);
+			}
+		}
+		else if (m_level > 0 && nowMs - m_troubleMs >= kRecoverMs && nowMs - m_levelMs >= kRecoverMs)
+		{
+			setLevel(m_level - 1, nowMs);
+		}
+	}
+
+	void Watchdog::setLevel(int level, uint32_t nowMs)
+	{
+		m_level = level;
+		m_levelMs = nowMs;
+		m_levelChanges++;
+		if (m_degrade)
+		{
+			m_degrade(level, m_degradeContext);
+		}
+		report(kWatchLevel, "", 0, 0);
+	}
+
+	void Watchdog::report(uint8_t type, const char *name, uint32_t count, uint32_t gapUs)
+	{
+		if (!m_report)
+		{
+			return;
+		}
+		WatchEvent event;
+		event.type = type;
+		event.level = (uint8_t)m_level;
+		event.count = count > 65535 ? 65535 : (uint16_t)count;
+		event.gapUs = gapUs;
+		event.name = name;
+		m_report(event, m_reportContext);
+	}
+
+	void Watchdog::setReport(WatchReportFn report, void *context)
+	{
+		m_report = report;
+		m_reportContext = context;
+	}
+
+	void Watchdog::setDegrade(DegradeFn degrade, void *context)
+	{
+		m_degrade = degrade;
+		m_degradeContext = context;
+	}
+
+	const char *Watchdog::name(int handle) const
+	{
+		return (handle >= 0 && handle < m_count) ? m_tasks[handle].name : "";
+	}
+
+	WatchStats Watchdog::stats(int handle) const
+	{
+		WatchStats stats = WatchStats();
+		if (handle >= 0 && handle < m_count)
+		{
+			const Entry &entry = m_tasks[handle];
+			stats.checkIns = entry.checkIns.load(std::memory_order_relaxed);
+			stats.misses = entry.misses.load(std::memory_order_relaxed);
+			stats.stalls = entry.stalls;
+			stats.worstGapUs = entry.worstGapUs;
+		}
+		return stats;
+	}
+
+	bool Watchdog::stalled(int handle) const
+	{
+		return handle >= 0 && handle < m_count && m_tasks[handle].stalled;
+	}
+
+	bool WatchHandle::attach(Watchdog &watchdog, const char *name, uint32_t periodMs, uint32_t timeoutMs,
+							 bool critical)
+	{
+		int handle = watchdog.add(name, periodMs, timeoutMs, critical);
+		if (handle < 0)
+		{
+			return false;
+		}
+		m_watchdog = &watchdog;
+		m_handle = handle;
+		return true;
+	}
+} // namespace art
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Per-module flash and RAM usage from a GNU ld map file, checked against budgets.
+
+    sizeReport.py MAP [MODULE=FLASH,RAM ...]
+
+Every input section the linker kept is charged to the module it came from:
+objects out of build/libart_<name>.a go to <name>, other project objects to
+"app", and anything from the SDK libraries to "sdk". Flash is what the program
+image holds (code, read-only data and the initial values of .data), RAM is
+what it occupies once running (.data and .bss). Sizes are in bytes.
+
+A budget may be given for any module, or for "total". Leaving out either
+number (core=8192, or core=,512) leaves that side unchecked. The exit status is
+1 if any budget is exceeded, so the build fails with it.
+"""
+
+import re
+import sys
+from collections import defaultdict
+
+INPUT_SECTION = re.compile(r"^ (\S+)?\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+SECTION_NAME = re.compile(r"^ (\S+)$")
+MODULE_LIBRARY = re.compile(r"libart_(\w+)\.a\(")
+
+# input section prefixes, and whether they take flash, RAM or both
+FLASH = (".text", ".rodata", ".init_array", ".fini_array", ".preinit_array", ".ARM.exidx", ".ARM.extab", ".init", ".fini")
+BOTH = (".data",)
+RAM = (".bss", "COMMON")
+
+
+def module_of(path):
+    library = MODULE_LIBRARY.search(path)
+    if library:
+        return library.group(1)
+    if "(" in path or path.endswith(".a") or path.endswith(".lib"):
+        return "sdk"
+    return "app"
+
+
+def charge(name):
+    """Returns (flash, ram) telling which the section counts against."""
+    if name.startswith(FLASH):
+        return True, False
+    if name.startswith(BOTH):
+        return True, True
+    if name.startswith(RAM):
+        return False, True
+    return False, False
+
+
+def parse(lines):
+    flash = defaultdict(int)
+    ram = defaultdict(int)
+    in_map = False
+    pending = None
+    for line in lines:
+        line = line.rstrip("\n")
+        if not in_map:
+            in_map = line.startswith("Linker script and memory map")
+            continue
+        match = SECTION_NAME.match(line)
+        if match:
+            pending = match.group(1)
+            continue
+        match = INPUT_SECTION.match(line)
+        if match:
+            name = match.group(1) or pending
+            size = int(match.group(2), 16)
+            path = match.group(3).strip()
+            pending = None
+            if not name or name == "*fill*" or not size:
+                continue
+            to_flash, to_ram = charge(name)
+            module = module_of(path)
+            if to_flash:
+                flash[module] += size
+            if to_ram:
+                ram[module] += size
+            continue
+        pending = None
+    return flash, ram
+
+
+def parse_budget(text):
+    module, _, limits = text.partition("=")
+    flash, _, ram = limits.partition(",")
+    return module, int(flash) if flash else None, int(ram) if ram else None
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__)
+        return 2
+    with open(argv[1]) as map_file:
+        flash, ram = parse(map_file)
+    budgets = dict((module, (f, r)) for module, f, r in map(parse_budget, argv[2:]))
+
+    modules = sorted(set(flash) | set(ram), key=lambda m: -flash[m])
+    flash["total"] = sum(flash.values())
+    ram["total"] = sum(ram.values())
+
+    over = []
+    print("%-12s %10s %10s %10s %10s" % ("module", "flash", "budget", "ram", "budget"))
+    for module in modules + ["total"]:
+        flash_budget, ram_budget = budgets.get(module, (None, None))
+        for used, budget, kind in ((flash[module], flash_budget, "flash"), (ram[module], ram_budget, "ram")):
+            if budget is not None and used > budget:
+                over.append("%s %s %d bytes, budget %d" % (module, kind, used, budget))
+        print("%-12s %10d %10s %10d %10s" % (
+            module,
+            flash[module],
+            "-" if flash_budget is None else flash_budget,
+            ram[module],
+            "-" if ram_budget is None else ram_budget,
+        ))
+
+    for module in budgets:
+        if module != "total" and module not in modules:
+            over.append("%s has a budget but no sections in the map" % module)
+    for problem in over:
+        sys.stderr.write("size budget exceeded: %s\n" % problem)
+    return 1 if over else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
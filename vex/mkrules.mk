@@ -1,22 +1,31 @@
 # VEXcode mkrules.mk 2019_03_26_01
 
+# objects built under directory $(1) from the sources in $(2)
+objects = $(addprefix $(1)/, $(addsuffix .o, $(basename $(2))))
+
+APP_OBJ     = $(call objects,$(BUILD),$(APP_SRC))
+MODULE_LIBS = $(foreach m,$(MODULES),$(BUILD)/libart_$(m).a)
+
 # compile C files
-$(BUILD)/%.o: %.c $(SRC_H)
+$(BUILD)/%.o: %.c $(SRC_A)
 	$(Q)$(MKDIR)
 	$(ECHO) "CC  $<"
-	$(Q)$(CC) $(CFLAGS) $(INC) -c -o $@ $<
+	$(Q)$(CC) $(CFLAGS) $(DEPFLAGS) $(INC) -c -o $@ $<
 	
 # compile C++ files
-$(BUILD)/%.o: %.cpp $(SRC_H) $(SRC_A)
+$(BUILD)/%.o: %.cpp $(SRC_A)
 	$(Q)$(MKDIR)
 	$(ECHO) "CXX $<"
-	$(Q)$(CXX) $(CXX_FLAGS) $(INC) -c -o $@ $<
+	$(Q)$(CXX) $(CXX_FLAGS) $(DEPFLAGS) $(INC) -c -o $@ $<
 	
-# create executable 
-$(BUILD)/$(PROJECT).elf: $(OBJ)
+# create executable, the modules grouped since they call into each other
+$(BUILD)/$(PROJECT).elf: $(APP_OBJ) $(MODULE_LIBS)
 	$(ECHO) "LINK $@"
-	$(Q)$(LINK) $(LNK_FLAGS) -o $@ $^ $(LIBS)
+	$(Q)$(LINK) $(LNK_FLAGS) -o $@ $(APP_OBJ) --start-group $(MODULE_LIBS) --end-group $(LIBS)
 	$(Q)$(SIZE) $@
+ifeq ($(SIZE_REPORT),1)
+	$(Q)$(PYTHON) tools/sizeReport.py "$(BUILD)/$(PROJECT).map" $(SIZE_BUDGET)
+endif
 
 # create binary 
 $(BUILD)/$(PROJECT).bin: $(BUILD)/$(PROJECT).elf
@@ -26,7 +35,28 @@ $(BUILD)/$(PROJECT).bin: $(BUILD)/$(PROJECT).elf
 $(BUILD)/$(PROJECTLIB).a: $(OBJ)
 	$(Q)$(ARCH) $(ARCH_FLAGS) $@ $^
 
+# create one archive per module, the same way
+define MODULE_RULE
+$$(BUILD)/libart_$(1).a: $$(call objects,$$(BUILD),$$(MODULE_$(1)))
+	$$(ECHO) "AR  $$@"
+	$$(Q)$$(ARCH) $$(ARCH_FLAGS) $$@ $$^
+endef
+$(foreach m,$(MODULES),$(eval $(call MODULE_RULE,$(m))))
+
+# the perf profile's hot modules trade size for speed
+$(call objects,$(BUILD),$(foreach m,$(HOT_MODULES),$(MODULE_$(m)))): OPT_FLAGS = -O2
+
+# the size report fails the link, which must not leave the program behind
+.DELETE_ON_ERROR:
+
+# every module library, without linking the program
+libs: $(MODULE_LIBS)
+
 # clean project
 clean:
 	$(info clean project)
 	$(Q)$(CLEAN)
+
+.PHONY: libs clean
+
+-include $(OBJ:.o=.d)